@@ -2,6 +2,7 @@
 
 #include "../memory/MemoryFactory.hpp"
 #include "../memory/IProcessMemory.hpp"
+#include "../memory/CachingProcessMemory.hpp"
 #include "../process/ProcessFinder.hpp"
 #include "../hooking/DialogHook.hpp"
 #include "../hooking/CornerTextHook.hpp"
@@ -20,7 +21,9 @@
 #include "../scanning/PostLoginScanner.hpp"
 #include "../scanning/PlayerNameScanner.hpp"
 #include "../scanning/ScannerCreateInfo.hpp"
+#include "../scanning/RegionPriority.hpp"
 #include "../signatures/Signatures.hpp"
+#include "../signatures/SignatureCache.hpp"
 #include "../pattern/Pattern.hpp"
 #include "dialog_message.hpp"
 #include "quest_message.hpp"
@@ -28,6 +31,10 @@
 #include "../util/SPSCRing.hpp"
 #include "../util/Profile.hpp"
 #include "../pattern/MemoryRegion.hpp"
+#include "../pattern/RegionMap.hpp"
+#include "../pattern/PageChangeTracker.hpp"
+#include "../pattern/SignatureResolver.hpp"
+#include "../pattern/ScanStats.hpp"
 
 #include <chrono>
 #include <memory>
@@ -84,6 +91,8 @@ struct Engine::Impl
     Config cfg{};
     Logger log{};
     std::unique_ptr<IProcessMemory> memory = nullptr;
+    // Tick-scoped page cache wrapping the backend; owned by memory
+    CachingProcessMemory* page_cache = nullptr;
     
     // Centralized hook lifecycle manager
     HookManager hook_manager;
@@ -135,6 +144,18 @@ struct Engine::Impl
     // Thread pool for parallel scanner polling
     std::unique_ptr<BS::light_thread_pool> scanner_pool;
 
+    // Live memory map shared by all scanners
+    std::shared_ptr<RegionMap> region_map;
+
+    // Learned slow-path region ordering, persisted across sessions
+    std::shared_ptr<RegionPriorityModel> region_priority;
+
+    // Changed-page tracking for the continuously polled notice/post-login scanners
+    std::shared_ptr<PageChangeTracker> change_tracker;
+
+    // Per-signature scan costs since start_hook()
+    std::shared_ptr<ScanStatsRegistry> scan_stats = std::make_shared<ScanStatsRegistry>();
+
     // Two-phase commit: pending queue for deduplication
     std::vector<PendingDialog> pending_dialogs;
     std::mutex pending_mutex;
@@ -316,8 +337,11 @@ bool Engine::start_hook(StartPolicy policy)
         }
 
         // Create memory interface and attach
-        impl_->memory = dqxclarity::MemoryFactory::CreatePlatformMemory();
-        if (!impl_->memory || !impl_->memory->AttachProcess(pids[0]))
+        auto page_cache = std::make_unique<CachingProcessMemory>(dqxclarity::MemoryFactory::CreatePlatformMemory(
+            impl_->cfg.native_linux_memory ? MemoryBackend::NativeLinux : MemoryBackend::Libmem));
+        impl_->page_cache = page_cache.get();
+        impl_->memory = std::move(page_cache);
+        if (!impl_->memory->AttachProcess(pids[0]))
         {
             impl_->SetError("Failed to attach to DQXGame.exe");
             status_ = Status::Error;
@@ -333,10 +357,25 @@ bool Engine::start_hook(StartPolicy policy)
     impl_->scanner_pool = std::make_unique<BS::light_thread_pool>(4);
 
     // Parse memory regions once to avoid repeated parsing (optimization)
+    impl_->region_map = std::make_shared<RegionMap>(impl_->memory->GetAttachedPid());
+    impl_->region_priority = std::make_shared<RegionPriorityModel>();
+    if (!impl_->region_priority->Load() && impl_->log.warn)
+        impl_->log.warn("Region priority model unreadable; scanning in address order");
+    // Same 100 MB cap the full-memory scans apply
+    impl_->change_tracker = std::make_shared<PageChangeTracker>(
+        impl_->memory.get(), impl_->region_map, RegionFilter::NonExecutable,
+        impl_->cfg.soft_dirty_page_tracking ? PageTrackingBackend::Auto : PageTrackingBackend::PageHash,
+        100 * 1024 * 1024);
+    if (impl_->log.info)
+        impl_->log.info(impl_->change_tracker->Backend() == PageTrackingBackend::SoftDirty
+                            ? "Page change tracking: soft-dirty"
+                            : "Page change tracking: page hashes");
+    impl_->scan_stats->Reset();
     std::vector<MemoryRegion> cached_regions;
     {
         PROFILE_SCOPE_CUSTOM("Engine.ParseMemoryRegions");
-        cached_regions = MemoryRegionParser::ParseMaps(impl_->memory->GetAttachedPid());
+        impl_->region_map->Refresh();
+        cached_regions = impl_->region_map->Regions();
     }
 
     // Build common HookCreateInfo for all hooks
@@ -347,6 +386,10 @@ bool Engine::start_hook(StartPolicy policy)
     base_hook_info.instruction_safe_steal = impl_->cfg.instruction_safe_steal;
     base_hook_info.readback_bytes = static_cast<size_t>(impl_->cfg.readback_bytes);
     base_hook_info.cached_regions = cached_regions;
+    base_hook_info.event_ring = impl_->cfg.hook_event_ring;
+    base_hook_info.copy_text_in_detour = impl_->cfg.hook_copy_dialog_text;
+    base_hook_info.shared_mailbox = impl_->cfg.hook_shared_mailbox;
+    base_hook_info.batched_install = impl_->cfg.hook_batched_install;
 
     // Initialize ScannerManager
     impl_->scanner_manager = std::make_unique<ScannerManager>();
@@ -363,6 +406,11 @@ bool Engine::start_hook(StartPolicy policy)
         PROFILE_SCOPE_CUSTOM("Engine.InitializeDialogScanner");
         ScannerCreateInfo dialog_info;
         dialog_info.memory = impl_->memory.get();
+        dialog_info.signature_name = "dialog_pattern";
+        dialog_info.scan_stats = impl_->scan_stats;
+        dialog_info.scan_pool = impl_->scanner_pool.get();
+        dialog_info.region_map = impl_->region_map;
+        dialog_info.region_priority = impl_->region_priority;
         dialog_info.logger = impl_->log;
         dialog_info.verbose = impl_->cfg.verbose;
         dialog_info.pattern = Signatures::GetDialogPattern();
@@ -388,6 +436,11 @@ bool Engine::start_hook(StartPolicy policy)
         // Quest scanner in compatibility mode
         ScannerCreateInfo quest_info;
         quest_info.memory = impl_->memory.get();
+        quest_info.signature_name = "quest_pattern";
+        quest_info.scan_stats = impl_->scan_stats;
+        quest_info.scan_pool = impl_->scanner_pool.get();
+        quest_info.region_map = impl_->region_map;
+        quest_info.region_priority = impl_->region_priority;
         quest_info.logger = impl_->log;
         quest_info.verbose = impl_->cfg.verbose;
         quest_info.cached_regions = cached_regions;
@@ -414,6 +467,11 @@ bool Engine::start_hook(StartPolicy policy)
             PROFILE_SCOPE_CUSTOM("Engine.InitializeDialogScanner");
             ScannerCreateInfo dialog_info;
             dialog_info.memory = impl_->memory.get();
+            dialog_info.signature_name = "dialog_pattern";
+            dialog_info.scan_stats = impl_->scan_stats;
+            dialog_info.scan_pool = impl_->scanner_pool.get();
+            dialog_info.region_map = impl_->region_map;
+            dialog_info.region_priority = impl_->region_priority;
             dialog_info.logger = impl_->log;
             dialog_info.verbose = impl_->cfg.verbose;
             dialog_info.pattern = Signatures::GetDialogPattern();
@@ -439,6 +497,12 @@ bool Engine::start_hook(StartPolicy policy)
         // NoticeScreen scanner with warmup callback
         ScannerCreateInfo notice_info;
         notice_info.memory = impl_->memory.get();
+        notice_info.signature_name = "notice_string";
+        notice_info.scan_stats = impl_->scan_stats;
+        notice_info.scan_pool = impl_->scanner_pool.get();
+        notice_info.region_map = impl_->region_map;
+        notice_info.region_priority = impl_->region_priority;
+        notice_info.change_tracker = impl_->change_tracker;
         notice_info.logger = impl_->log;
         notice_info.verbose = impl_->cfg.verbose;
         notice_info.pattern = Signatures::GetNoticeString();
@@ -481,6 +545,12 @@ bool Engine::start_hook(StartPolicy policy)
         // PostLogin scanner
         ScannerCreateInfo postlogin_info;
         postlogin_info.memory = impl_->memory.get();
+        postlogin_info.signature_name = "walkthrough";
+        postlogin_info.scan_stats = impl_->scan_stats;
+        postlogin_info.scan_pool = impl_->scanner_pool.get();
+        postlogin_info.region_map = impl_->region_map;
+        postlogin_info.region_priority = impl_->region_priority;
+        postlogin_info.change_tracker = impl_->change_tracker;
         postlogin_info.logger = impl_->log;
         postlogin_info.verbose = impl_->cfg.verbose;
         postlogin_info.pattern = Signatures::GetWalkthroughPattern();
@@ -513,6 +583,11 @@ bool Engine::start_hook(StartPolicy policy)
         // PlayerName scanner for on-demand player info extraction
         ScannerCreateInfo player_info;
         player_info.memory = impl_->memory.get();
+        player_info.signature_name = "sibling_name_pattern";
+        player_info.scan_stats = impl_->scan_stats;
+        player_info.scan_pool = impl_->scanner_pool.get();
+        player_info.region_map = impl_->region_map;
+        player_info.region_priority = impl_->region_priority;
         player_info.logger = impl_->log;
         player_info.verbose = impl_->cfg.verbose;
         player_info.pattern = Signatures::GetSiblingNamePattern();
@@ -525,6 +600,11 @@ bool Engine::start_hook(StartPolicy policy)
 
         ScannerCreateInfo quest_info;
         quest_info.memory = impl_->memory.get();
+        quest_info.signature_name = "quest_pattern";
+        quest_info.scan_stats = impl_->scan_stats;
+        quest_info.scan_pool = impl_->scanner_pool.get();
+        quest_info.region_map = impl_->region_map;
+        quest_info.region_priority = impl_->region_priority;
         quest_info.logger = impl_->log;
         quest_info.verbose = impl_->cfg.verbose;
         quest_info.cached_regions = cached_regions;
@@ -613,111 +693,84 @@ bool Engine::start_hook(StartPolicy policy)
     if (!impl_->cfg.compatibility_mode)
     {
         impl_->hook_stage.store(HookStage::InstallingHooks, std::memory_order_release);
-        
-        if (impl_->log.info)
-            impl_->log.info("Installing hook...");
 
-        // Defer dialog hook installation until after warmup completes (auto mode only)
+        // Resolve every hook site up front: cached offsets are validated in place,
+        // misses share one pass over DQXGame.exe instead of one scan per hook
         {
-            PROFILE_SCOPE_CUSTOM("Engine.InstallDialogHook");
-            dialog_hook_installed = impl_->hook_manager.RegisterHook(
-                persistence::HookType::Dialog,
-                base_hook_info,
-                nullptr,
-                nullptr);
-
-            if (dialog_hook_installed)
-            {
-                if (impl_->log.info)
-                    impl_->log.info("Dialog hook installed successfully (deferred)");
-            }
-            else
-            {
-                if (impl_->log.warn)
-                    impl_->log.warn("Failed to install dialog hook (deferred)");
-            }
-
-            auto dialog_scanner = impl_->scanner_manager->GetScanner(ScannerType::Dialog);
-            if (!dialog_hook_installed && !dialog_scanner)
+            PROFILE_SCOPE_CUSTOM("Engine.ResolveHookSignatures");
+            SignatureCache cache;
+            if (!cache.Load() && impl_->log.warn)
+                impl_->log.warn("Ignoring unreadable signature cache: " + SignatureCache::DefaultPath().string());
+
+            SignatureResolver resolver(impl_->memory.get());
+            auto resolved = std::make_shared<ResolvedSignatures>(
+                resolver.Resolve(Signatures::GetHookSignatures(), "DQXGame.exe", cached_regions, cache));
+            if (impl_->log.debug)
             {
-                impl_->SetError("Failed to initialize dialog capture (both hook and scanner unavailable)");
-                status_ = Status::Error;
-                return false;
+                impl_->log.debug("Resolved " + std::to_string(resolved->Size()) + " hook signatures (" +
+                                 std::to_string(resolver.LastCacheHits()) + " from cache)");
             }
+            impl_->scan_stats->RecordStartup("hook_signatures", resolver.LastCost());
+            base_hook_info.resolved_signatures = std::move(resolved);
         }
 
         // Do NOT pre-change page protections at startup; some builds crash on login if code pages change protection.
 
+        // Install all hooks as one transaction (patches deferred until policy allows);
+        // the integrity hook goes last and is wired once its detour is installed.
+        // Network hook is temporarily disabled; to enable it, add persistence::HookType::Network here.
         if (impl_->log.info)
-            impl_->log.info("Installing hook...");
+            impl_->log.info("Installing hooks...");
         {
-            PROFILE_SCOPE_CUSTOM("Engine.InstallQuestHook");
-            impl_->hook_manager.RegisterHook(
+            PROFILE_SCOPE_CUSTOM("Engine.InstallHooks");
+            const persistence::HookType hook_types[] = {
+                persistence::HookType::Dialog,
                 persistence::HookType::Quest,
-                base_hook_info,
-                nullptr,  // Integrity will be wired after integrity detour is installed
-                nullptr);
+                persistence::HookType::Player,
+                persistence::HookType::Corner,
+                persistence::HookType::Integrity,
+            };
+            impl_->hook_manager.RegisterHooks(hook_types, base_hook_info, nullptr, nullptr);
         }
 
-        if (impl_->log.info)
-            impl_->log.info("Installing hook...");
+        dialog_hook_installed = impl_->hook_manager.GetHook(persistence::HookType::Dialog) != nullptr;
+        if (dialog_hook_installed)
         {
-            PROFILE_SCOPE_CUSTOM("Engine.InstallPlayerHook");
-            impl_->hook_manager.RegisterHook(
-                persistence::HookType::Player,
-                base_hook_info,
-                nullptr,  // Integrity will be wired after integrity detour is installed
-                nullptr);
+            if (impl_->log.info)
+                impl_->log.info("Dialog hook installed successfully (deferred)");
         }
-
-        // Network hook is temporarily disabled
-        // Note: If enabled, register via HookManager::RegisterHook(persistence::HookType::Network, ...)
-
-        if (impl_->log.info)
-            impl_->log.info("Installing hook...");
+        else
         {
-            PROFILE_SCOPE_CUSTOM("Engine.InstallCornerTextHook");
-            impl_->hook_manager.RegisterHook(
-                persistence::HookType::Corner,
-                base_hook_info,
-                nullptr,  // Integrity will be wired after integrity detour is installed
-                nullptr);
+            if (impl_->log.warn)
+                impl_->log.warn("Failed to install dialog hook (deferred)");
         }
 
-        // Install integrity hook through HookManager
-        if (impl_->log.info)
-            impl_->log.info("Installing hook...");
+        auto dialog_scanner = impl_->scanner_manager->GetScanner(ScannerType::Dialog);
+        if (!dialog_hook_installed && !dialog_scanner)
         {
-            PROFILE_SCOPE_CUSTOM("Engine.InstallIntegrityHook");
-            
-            // Configure integrity-specific settings
-            HookCreateInfo integrity_info = base_hook_info;
-            
-            bool integrity_installed = impl_->hook_manager.RegisterHook(
-                persistence::HookType::Integrity,
-                integrity_info,
-                nullptr, nullptr);
+            impl_->hook_manager.RemoveAllHooks();
+            impl_->SetError("Failed to initialize dialog capture (both hook and scanner unavailable)");
+            status_ = Status::Error;
+            return false;
+        }
 
-            if (!integrity_installed)
-            {
-                if (impl_->log.error)
-                    impl_->log.error("Failed to install integrity hook");
-                impl_->hook_manager.RemoveAllHooks();
-                impl_->memory.reset();
-                status_ = Status::Error;
-                return false;
-            }
-            
-            // Configure integrity-specific settings
-            auto* integrity_hook = impl_->hook_manager.GetIntegrityHook();
-            if (integrity_hook)
-            {
-                integrity_hook->SetDiagnosticsEnabled(impl_->cfg.enable_integrity_diagnostics);
-                
-                // Wire all hooks to integrity system
-                impl_->hook_manager.WireIntegrityCallbacks(integrity_hook, nullptr);
-            }
+        auto* integrity_hook = impl_->hook_manager.GetIntegrityHook();
+        if (!integrity_hook)
+        {
+            if (impl_->log.error)
+                impl_->log.error("Failed to install integrity hook");
+            impl_->hook_manager.RemoveAllHooks();
+            impl_->page_cache = nullptr;
+            impl_->memory.reset();
+            status_ = Status::Error;
+            return false;
         }
+
+        // Configure integrity-specific settings
+        integrity_hook->SetDiagnosticsEnabled(impl_->cfg.enable_integrity_diagnostics);
+
+        // Wire all hooks to integrity system
+        impl_->hook_manager.WireIntegrityCallbacks(integrity_hook, nullptr);
     }
     else
     {
@@ -754,8 +807,9 @@ bool Engine::start_hook(StartPolicy policy)
         }
         else
         {
+            // The monitor polls concurrently with the poller tick and must never see cached pages
             impl_->monitor = std::make_unique<dqxclarity::IntegrityMonitor>(
-                impl_->memory.get(), impl_->log, state_addr,
+                impl_->page_cache->Inner(), impl_->log, state_addr,
                 [this](bool first)
                 {
                     if (first)
@@ -793,11 +847,19 @@ bool Engine::start_hook(StartPolicy policy)
                 {
                     auto now = std::chrono::steady_clock::now();
 
+                    // Pages read by several scanners and hooks this tick are copied once
+                    impl_->page_cache->BeginTick();
+
                     // Phase 1: Capture from both sources to pending queue (no immediate publish)
 
-                    // Hook-based capture (safe pointer capture to avoid TOCTOU race)
+                    // One batched read of every hook's flag and registers; the Poll calls below consume it
+                    impl_->hook_manager.PrefetchPollSnapshots();
+
+                    // Hook-based capture (safe pointer capture to avoid TOCTOU race); with the event
+                    // ring every line the game showed since the last tick is drained
                     auto hook_ptr = dynamic_cast<DialogHook*>(impl_->hook_manager.GetHook(persistence::HookType::Dialog));
-                    if (hook_ptr && hook_ptr->PollDialogData())
+                    size_t hook_dialogs = 0;
+                    while (hook_ptr && hook_dialogs++ < HookEventRing::kSlots && hook_ptr->PollDialogData())
                     {
                         std::string text = hook_ptr->GetLastDialogText();
                         std::string speaker = hook_ptr->GetLastNpcName();
@@ -1239,6 +1301,7 @@ bool Engine::start_hook(StartPolicy policy)
                         }
                     }
 
+                    impl_->page_cache->EndTick();
                     std::this_thread::sleep_for(100ms);
                 }
             }
@@ -1312,7 +1375,23 @@ bool Engine::stop_hook()
         
         // Remove all hooks via HookManager (handles cleanup and persistence unregistration)
         impl_->hook_manager.RemoveAllHooks();
+
+        if (impl_->log.debug)
+            impl_->log.debug("Scan cost per signature:\n" + FormatScanReport(impl_->scan_stats->Snapshot()));
+        if (impl_->log.debug && impl_->page_cache)
+        {
+            const PageCacheStats cache = impl_->page_cache->Stats();
+            impl_->log.debug("Tick page cache: " + std::to_string(cache.hits) + " hits, " +
+                             std::to_string(cache.misses) + " misses, " + std::to_string(cache.bypassed) +
+                             " bypassed, " + std::to_string(cache.pages_fetched) + " pages fetched, hit rate " +
+                             std::to_string(static_cast<int>(cache.HitRate() * 100.0)) + "%");
+        }
         
+        // Scanners only update the model in memory; one write per session keeps file I/O off the scan path
+        if (impl_->region_priority && !impl_->region_priority->SaveIfDirty() && impl_->log.warn)
+            impl_->log.warn("Failed to save region priority model");
+
+        impl_->page_cache = nullptr;
         impl_->memory.reset();
         if (impl_->log.info)
             impl_->log.info("Hook removed");
@@ -1467,6 +1546,10 @@ EngineState Engine::state() const
     return s;
 }
 
+std::vector<SignatureScanReport> Engine::scan_report() const { return impl_->scan_stats->Snapshot(); }
+
+std::string Engine::scan_report_text() const { return FormatScanReport(impl_->scan_stats->Snapshot()); }
+
 std::string Engine::last_error() const
 {
     std::lock_guard<std::mutex> lock(impl_->error_mutex);
@@ -8,6 +8,7 @@
 
 #include "player_info.hpp"
 #include "corner_text.hpp"
+#include "scan_stats.hpp"
 
 namespace dqxclarity
 {
@@ -55,6 +56,21 @@ struct Config
     bool compatibility_mode = false;
     // Hook priority wait time: how long to wait for hook to upgrade memory reader captures (ms)
     int hook_wait_timeout_ms = 200;
+    // Process memory backend: false = libmem, true = direct syscalls on /proc/<pid>/mem (Linux only)
+    bool native_linux_memory = false;
+    // Changed-page scans read the kernel's soft-dirty bits instead of hashing pages (Linux only). Resetting the bits
+    // writes "4" to /proc/<pid>/clear_refs, which edits the game's page tables and clears soft-dirty state any
+    // other tool (e.g. CRIU) relies on, so page hashes are used unless this is set.
+    bool soft_dirty_page_tracking = false;
+    // Hook detours queue every hit in an in-target ring instead of a single flag (no lost lines between polls)
+    bool hook_event_ring = false;
+    // Dialog detour copies the text (up to 2047 bytes) at hook time, so polling cannot see a reused buffer.
+    // The copy runs inside the game: a corrupt text pointer crashes the game rather than failing a read.
+    bool hook_copy_dialog_text = false;
+    // Detours bump counters in one shared page; an idle poll tick is then a single read
+    bool hook_shared_mailbox = false;
+    // Hooks are installed as one transaction: one detour arena, one write, one patch window
+    bool hook_batched_install = false;
 };
 
 struct Logger
@@ -112,6 +128,11 @@ public:
     bool isPostLoginDetected() const;
     bool scanPlayerInfo(PlayerInfo& out);
 
+    // Scan cost per signature since start_hook(), most expensive first
+    std::vector<SignatureScanReport> scan_report() const;
+    // scan_report() as a fixed-width text table
+    std::string scan_report_text() const;
+
     // Scanner state listeners
     using NoticeListenerId = std::uint64_t;
     NoticeListenerId addNoticeStateListener(std::function<void(bool)> callback);
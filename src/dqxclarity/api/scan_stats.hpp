@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Work done by one or more signature lookups
+ */
+struct ScanCost
+{
+    std::uint64_t scans = 0;           // Lookups performed
+    std::uint64_t regions_visited = 0; // Address ranges walked (regions, region windows or parallel work units)
+    std::uint64_t read_calls = 0;      // IProcessMemory::ReadMemory calls
+    std::uint64_t bytes_read = 0;
+    std::uint64_t matches = 0;
+    std::uint64_t bytes_searched = 0; // Bytes run through a multi-signature pass, once whatever the signature count
+    std::chrono::microseconds wall_time{ 0 };
+
+    ScanCost& operator+=(const ScanCost& other)
+    {
+        scans += other.scans;
+        regions_visited += other.regions_visited;
+        read_calls += other.read_calls;
+        bytes_read += other.bytes_read;
+        matches += other.matches;
+        bytes_searched += other.bytes_searched;
+        wall_time += other.wall_time;
+        return *this;
+    }
+};
+
+/**
+ * @brief Scan cost of one signature, split into startup and steady state
+ */
+struct SignatureScanReport
+{
+    std::string signature;
+    ScanCost startup;   // Initialization and one-off resolves
+    ScanCost steady;    // Sum of all poll ticks
+    ScanCost last_tick; // Most recent poll tick
+    std::uint64_t ticks = 0;
+};
+
+} // namespace dqxclarity
@@ -24,6 +24,36 @@ constexpr uint8_t JMP_REL32 = 0xE9; // jmp rel32
 // NOP
 constexpr uint8_t NOP = 0x90;
 
+// Flags, arithmetic
+constexpr uint8_t PUSHFD = 0x9C;
+constexpr uint8_t POPFD = 0x9D;
+constexpr uint8_t GROUP1_RM32_IMM32 = 0x81; // add/and/... r/m32, imm32 (operation in ModR/M reg field)
+constexpr uint8_t IMUL_R32_RM32_IMM8 = 0x6B;
+constexpr uint8_t INC_R32 = 0x40; // + register number
+constexpr uint8_t DEC_R32 = 0x48; // + register number
+constexpr uint8_t LOCK_PREFIX = 0xF0;
+constexpr uint8_t GROUP5_RM32 = 0xFF; // inc/dec/call/jmp/push r/m32 (operation in ModR/M reg field)
+constexpr uint8_t GROUP5_INC = 0;
+constexpr uint8_t MOV_IMM32_TO_R32 = 0xB8; // + register number
+constexpr uint8_t IMUL_R32_RM32_IMM32 = 0x69;
+constexpr uint8_t TEST_RM32_R32 = 0x85;
+constexpr uint8_t TEST_RM8_R8 = 0x84;
+constexpr uint8_t MOV_R8_TO_RM8 = 0x88; // mov [base], r8
+constexpr uint8_t MOV_RM8_TO_R8 = 0x8A; // mov r8, [base]
+
+// Short conditional jumps
+constexpr uint8_t JZ_REL8 = 0x74;
+constexpr uint8_t JNZ_REL8 = 0x75;
+
+// ModR/M reg-field extensions for GROUP1_RM32_IMM32
+constexpr uint8_t GROUP1_ADD = 0;
+constexpr uint8_t GROUP1_AND = 4;
+
+constexpr uint8_t ModRMByte(uint8_t mod, uint8_t reg, uint8_t rm)
+{
+    return static_cast<uint8_t>((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+}
+
 // ModR/M bytes for [disp32] addressing (Mod=00, R/M=101)
 namespace ModRM
 {
@@ -39,6 +69,36 @@ constexpr uint8_t MEM_DISP32 = 0x05; // [disp32] for MOV byte ptr
 } // namespace ModRM
 } // namespace x86
 
+namespace
+{
+
+// Hardware register numbers (the Register enum follows the backup slot order instead)
+uint8_t Encoding(X86CodeBuilder::Register reg)
+{
+    switch (reg)
+    {
+    case X86CodeBuilder::Register::EAX:
+        return 0;
+    case X86CodeBuilder::Register::ECX:
+        return 1;
+    case X86CodeBuilder::Register::EDX:
+        return 2;
+    case X86CodeBuilder::Register::EBX:
+        return 3;
+    case X86CodeBuilder::Register::ESP:
+        return 4;
+    case X86CodeBuilder::Register::EBP:
+        return 5;
+    case X86CodeBuilder::Register::ESI:
+        return 6;
+    case X86CodeBuilder::Register::EDI:
+        return 7;
+    }
+    return 0;
+}
+
+} // namespace
+
 void X86CodeBuilder::emitU32(uint32_t value)
 {
     code_.insert(code_.end(), reinterpret_cast<uint8_t*>(&value), reinterpret_cast<uint8_t*>(&value) + 4);
@@ -163,6 +223,181 @@ void X86CodeBuilder::setByteAtMem(uint32_t addr, uint8_t value)
     code_.push_back(value);
 }
 
+void X86CodeBuilder::pushfd() { code_.push_back(x86::PUSHFD); }
+
+void X86CodeBuilder::popfd() { code_.push_back(x86::POPFD); }
+
+void X86CodeBuilder::movRegToReg(Register dst, Register src)
+{
+    // mov dst, src
+    code_.push_back(x86::MOV_RM32_TO_R32);
+    code_.push_back(x86::ModRMByte(3, Encoding(src), Encoding(dst)));
+}
+
+void X86CodeBuilder::movToRegDisp8(Register base, int8_t disp, Register src)
+{
+    // mov [base+disp8], src (ESP as a base would need a SIB byte)
+    assert(base != Register::ESP);
+    code_.push_back(x86::MOV_RM32_TO_R32);
+    code_.push_back(x86::ModRMByte(1, Encoding(src), Encoding(base)));
+    code_.push_back(static_cast<uint8_t>(disp));
+}
+
+void X86CodeBuilder::movFromRegDisp8(Register dst, Register base, int8_t disp)
+{
+    // mov dst, [base+disp8]
+    assert(base != Register::ESP);
+    code_.push_back(x86::MOV_R32_TO_RM32);
+    code_.push_back(x86::ModRMByte(1, Encoding(dst), Encoding(base)));
+    code_.push_back(static_cast<uint8_t>(disp));
+}
+
+void X86CodeBuilder::andImm32(Register reg, uint32_t imm)
+{
+    // and reg, imm32
+    code_.push_back(x86::GROUP1_RM32_IMM32);
+    code_.push_back(x86::ModRMByte(3, x86::GROUP1_AND, Encoding(reg)));
+    emitU32(imm);
+}
+
+void X86CodeBuilder::addImm32(Register reg, uint32_t imm)
+{
+    // add reg, imm32
+    code_.push_back(x86::GROUP1_RM32_IMM32);
+    code_.push_back(x86::ModRMByte(3, x86::GROUP1_ADD, Encoding(reg)));
+    emitU32(imm);
+}
+
+void X86CodeBuilder::imulImm8(Register dst, Register src, int8_t imm)
+{
+    // imul dst, src, imm8
+    code_.push_back(x86::IMUL_R32_RM32_IMM8);
+    code_.push_back(x86::ModRMByte(3, Encoding(dst), Encoding(src)));
+    code_.push_back(static_cast<uint8_t>(imm));
+}
+
+void X86CodeBuilder::incReg(Register reg)
+{
+    // inc reg
+    code_.push_back(static_cast<uint8_t>(x86::INC_R32 + Encoding(reg)));
+}
+
+void X86CodeBuilder::lockIncMem(uint32_t addr)
+{
+    // lock inc dword ptr [addr]
+    code_.push_back(x86::LOCK_PREFIX);
+    code_.push_back(x86::GROUP5_RM32);
+    code_.push_back(x86::ModRMByte(0, x86::GROUP5_INC, 5));
+    emitU32(addr);
+}
+
+void X86CodeBuilder::movImm32(Register reg, uint32_t imm)
+{
+    // mov reg, imm32
+    code_.push_back(static_cast<uint8_t>(x86::MOV_IMM32_TO_R32 + Encoding(reg)));
+    emitU32(imm);
+}
+
+void X86CodeBuilder::imulImm32(Register dst, Register src, uint32_t imm)
+{
+    // imul dst, src, imm32
+    code_.push_back(x86::IMUL_R32_RM32_IMM32);
+    code_.push_back(x86::ModRMByte(3, Encoding(dst), Encoding(src)));
+    emitU32(imm);
+}
+
+void X86CodeBuilder::decReg(Register reg)
+{
+    // dec reg
+    code_.push_back(static_cast<uint8_t>(x86::DEC_R32 + Encoding(reg)));
+}
+
+void X86CodeBuilder::testReg(Register reg)
+{
+    // test reg, reg
+    code_.push_back(x86::TEST_RM32_R32);
+    code_.push_back(x86::ModRMByte(3, Encoding(reg), Encoding(reg)));
+}
+
+void X86CodeBuilder::testByteReg(Register reg)
+{
+    // test r8, r8 (encodings 4-7 would name AH/CH/DH/BH)
+    assert(Encoding(reg) < 4);
+    code_.push_back(x86::TEST_RM8_R8);
+    code_.push_back(x86::ModRMByte(3, Encoding(reg), Encoding(reg)));
+}
+
+void X86CodeBuilder::movByteFromPtr(Register dst, Register base)
+{
+    // mov r8, [base] (ESP/EBP as a mod=00 base mean SIB/disp32)
+    assert(Encoding(dst) < 4 && base != Register::ESP && base != Register::EBP);
+    code_.push_back(x86::MOV_RM8_TO_R8);
+    code_.push_back(x86::ModRMByte(0, Encoding(dst), Encoding(base)));
+}
+
+void X86CodeBuilder::movByteToPtr(Register base, Register src)
+{
+    // mov [base], r8
+    assert(Encoding(src) < 4 && base != Register::ESP && base != Register::EBP);
+    code_.push_back(x86::MOV_R8_TO_RM8);
+    code_.push_back(x86::ModRMByte(0, Encoding(src), Encoding(base)));
+}
+
+void X86CodeBuilder::setByteAtPtr(Register base, uint8_t value)
+{
+    // mov byte ptr [base], imm8
+    assert(base != Register::ESP && base != Register::EBP);
+    code_.push_back(x86::MOV_IMM8_TO_RM8);
+    code_.push_back(x86::ModRMByte(0, 0, Encoding(base)));
+    code_.push_back(value);
+}
+
+size_t X86CodeBuilder::jzRel8()
+{
+    code_.push_back(x86::JZ_REL8);
+    code_.push_back(0);
+    return code_.size() - 1;
+}
+
+void X86CodeBuilder::bindRel8(size_t displacement_pos)
+{
+    const size_t distance = code_.size() - (displacement_pos + 1);
+    assert(distance <= 127);
+    code_[displacement_pos] = static_cast<uint8_t>(distance);
+}
+
+void X86CodeBuilder::jnzRel8(size_t target_pos)
+{
+    const auto distance = static_cast<int64_t>(target_pos) - static_cast<int64_t>(code_.size() + 2);
+    assert(distance >= -128 && distance <= 0);
+    code_.push_back(x86::JNZ_REL8);
+    code_.push_back(static_cast<uint8_t>(static_cast<int8_t>(distance)));
+}
+
+void X86CodeBuilder::copyStringBounded(uint32_t capacity)
+{
+    assert(capacity >= 2);
+    movImm32(Register::EDX, capacity - 1);
+    testReg(Register::ESI);
+    const size_t null_source = jzRel8();
+
+    // Copy the terminator too; stop early on it
+    const size_t loop = code_.size();
+    movByteFromPtr(Register::EBX, Register::ESI);
+    movByteToPtr(Register::EDI, Register::EBX);
+    testByteReg(Register::EBX);
+    const size_t terminated = jzRel8();
+    incReg(Register::ESI);
+    incReg(Register::EDI);
+    decReg(Register::EDX);
+    jnzRel8(loop);
+
+    // Truncated (EDI at the last byte) or null source (EDI at the first)
+    bindRel8(null_source);
+    setByteAtPtr(Register::EDI, 0);
+    bindRel8(terminated);
+}
+
 void X86CodeBuilder::appendBytes(const std::vector<uint8_t>& bytes)
 {
     code_.insert(code_.end(), bytes.begin(), bytes.end());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cassert>
 #include <vector>
@@ -37,6 +38,43 @@ public:
     void movToMem(Register reg, uint32_t addr);
     void movFromMem(Register reg, uint32_t addr);
     void setByteAtMem(uint32_t addr, uint8_t value);
+
+    // Register-relative and arithmetic forms used by event ring detours
+    void pushfd();
+    void popfd();
+    void movRegToReg(Register dst, Register src);
+    void movToRegDisp8(Register base, int8_t disp, Register src);   // mov [base+disp8], src
+    void movFromRegDisp8(Register dst, Register base, int8_t disp); // mov dst, [base+disp8]
+    void andImm32(Register reg, uint32_t imm);
+    void addImm32(Register reg, uint32_t imm);
+    void imulImm8(Register dst, Register src, int8_t imm);
+    void incReg(Register reg);
+    void lockIncMem(uint32_t addr); // lock inc dword ptr [addr]
+
+    // Bounded byte copies used by detours that capture strings at hook time
+    void movImm32(Register reg, uint32_t imm);
+    void imulImm32(Register dst, Register src, uint32_t imm);
+    void decReg(Register reg);
+    void testReg(Register reg);                       // test reg, reg
+    void testByteReg(Register reg);                   // test r8, r8 (EAX/EBX/ECX/EDX low byte)
+    void movByteFromPtr(Register dst, Register base); // mov r8, [base]
+    void movByteToPtr(Register base, Register src);   // mov [base], r8
+    void setByteAtPtr(Register base, uint8_t value);  // mov byte ptr [base], imm8
+
+    /**
+     * @brief Emit a forward jz rel8; bind it with bindRel8() once the target is emitted
+     * @return Position of the displacement byte
+     */
+    size_t jzRel8();
+    void bindRel8(size_t displacement_pos);
+    void jnzRel8(size_t target_pos); // Backward jump to an already emitted position
+
+    /**
+     * @brief Copy the NUL-terminated string at ESI to EDI, at most capacity - 1 bytes plus the terminator
+     *
+     * A null ESI stores an empty string. Clobbers EBX, EDX, ESI, EDI and EFLAGS.
+     */
+    void copyStringBounded(uint32_t capacity);
     void appendBytes(const std::vector<uint8_t>& bytes);
     void jmpRel32(uintptr_t from, uintptr_t dest);
 
@@ -32,11 +32,9 @@ std::vector<uint8_t> CornerTextHook::GenerateDetourPayload()
     const auto& backup_code = backup_builder.code();
     code.insert(code.end(), backup_code.begin(), backup_code.end());
 
-    // 2. Set new data flag
-    X86CodeBuilder flag_builder;
-    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address() + kFlagOffset), 0x01);
-    const auto& flag_code = flag_builder.code();
-    code.insert(code.end(), flag_code.begin(), flag_code.end());
+    // 2. Signal the event (new data flag, or an event ring slot)
+    const auto signal_code = BuildEventSignalCode();
+    code.insert(code.end(), signal_code.begin(), signal_code.end());
 
     // 3. Restore all registers
     X86CodeBuilder restore_builder;
@@ -52,7 +50,7 @@ std::vector<uint8_t> CornerTextHook::GenerateDetourPayload()
     code.insert(code.end(), restore_code.begin(), restore_code.end());
 
     // 4. Append stolen instructions
-    code.insert(code.end(), stolen_bytes().begin(), stolen_bytes().end());
+    AppendStolenInstructions(code);
 
     // 5. Jump back to original code
     X86CodeBuilder jmp_builder;
@@ -67,7 +65,7 @@ std::vector<uint8_t> CornerTextHook::GenerateDetourPayload()
 
 size_t CornerTextHook::ComputeStolenLength()
 {
-    return kDefaultStolenBytes;
+    return DecodeStolenLength(kDefaultStolenBytes);
 }
 
 bool CornerTextHook::PollCornerText()
@@ -77,27 +75,14 @@ bool CornerTextHook::PollCornerText()
         return false;
     }
 
-    uint8_t flag = 0;
-    if (!memory()->ReadMemory(backup_address() + kFlagOffset, &flag, sizeof(flag)))
+    const PollSnapshot* snapshot = AcquirePollSnapshot();
+    if (!snapshot || snapshot->flag == 0)
     {
         return false;
     }
 
-    if (flag == 0)
-    {
-        return false;
-    }
-
-    uint32_t text_ptr_raw = 0;
-    if (!memory()->ReadMemory(backup_address(), &text_ptr_raw, sizeof(text_ptr_raw)))
-    {
-        uint8_t zero = 0;
-        memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
-        return false;
-    }
-
-    uint8_t zero = 0;
-    memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
+    const uint32_t text_ptr_raw = snapshot->Register(0);
+    ClearPollFlag();
 
     if (text_ptr_raw == 0)
     {
@@ -106,10 +91,8 @@ bool CornerTextHook::PollCornerText()
 
     const uintptr_t text_ptr = static_cast<uintptr_t>(text_ptr_raw);
     std::string text;
-    if (!memory()->ReadString(text_ptr, text, kMaxStringLength))
-    {
-        text.clear();
-    }
+    StringRead read{ text_ptr, kMaxStringLength, &text };
+    ReadStrings({ &read, 1 });
 
     last_text_ = std::move(text);
     return true;
@@ -29,9 +29,8 @@ protected:
     size_t ComputeStolenLength() override;
 
 private:
-    static constexpr size_t kFlagOffset = 32;
     static constexpr size_t kMaxStringLength = 1024;
-    static constexpr size_t kDefaultStolenBytes = 5;
+    static constexpr size_t kDefaultStolenBytes = 5; // When the hook site cannot be decoded
 
     std::string last_text_;
 };
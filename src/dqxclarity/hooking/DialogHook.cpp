@@ -2,11 +2,45 @@
 #include "../signatures/Signatures.hpp"
 #include "Codegen.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 namespace dqxclarity
 {
 
+namespace
+{
+
+// NUL-terminated string stored in a fixed-size field of the capture payload
+std::string CopiedString(const std::vector<uint8_t>& payload, size_t offset, size_t size)
+{
+    const auto begin = payload.begin() + static_cast<std::ptrdiff_t>(offset);
+    const auto end = std::find(begin, begin + static_cast<std::ptrdiff_t>(size), uint8_t{ 0 });
+    return std::string(begin, end);
+}
+
+// Drop a UTF-8 sequence cut off at the end of text
+void TrimToUtf8Boundary(std::string& text)
+{
+    size_t lead = text.size();
+    while (lead > 0 && text.size() - lead < 4 && (static_cast<uint8_t>(text[lead - 1]) & 0xC0) == 0x80)
+        --lead;
+    if (lead == 0)
+        return;
+    --lead;
+
+    const auto byte = static_cast<uint8_t>(text[lead]);
+    const size_t length = byte < 0x80 ? 1 : byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+    if (lead + length > text.size())
+        text.resize(lead);
+}
+
+} // namespace
+
 DialogHook::DialogHook(const HookCreateInfo& create_info)
     : HookBase(create_info)
+    , copy_text_in_detour_(create_info.copy_text_in_detour)
 {
 }
 
@@ -32,11 +66,9 @@ std::vector<uint8_t> DialogHook::GenerateDetourPayload()
     const auto& backup_code = backup_builder.code();
     code.insert(code.end(), backup_code.begin(), backup_code.end());
 
-    // 2. Set new data flag
-    X86CodeBuilder flag_builder;
-    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address() + kFlagOffset), 0x01);
-    const auto& flag_code = flag_builder.code();
-    code.insert(code.end(), flag_code.begin(), flag_code.end());
+    // 2. Signal the event (new data flag, or an event ring slot)
+    const auto signal_code = BuildEventSignalCode();
+    code.insert(code.end(), signal_code.begin(), signal_code.end());
 
     // 3. Restore all registers
     X86CodeBuilder restore_builder;
@@ -52,7 +84,7 @@ std::vector<uint8_t> DialogHook::GenerateDetourPayload()
     code.insert(code.end(), restore_code.begin(), restore_code.end());
 
     // 4. Append stolen instructions
-    code.insert(code.end(), stolen_bytes().begin(), stolen_bytes().end());
+    AppendStolenInstructions(code);
 
     // 5. Jump back to original code
     X86CodeBuilder jmp_builder;
@@ -65,24 +97,26 @@ std::vector<uint8_t> DialogHook::GenerateDetourPayload()
     return code;
 }
 
-size_t DialogHook::ComputeStolenLength()
+size_t DialogHook::CapturePayloadSize() const
 {
-    // Try to read a small window and recognize the expected prologue
-    std::vector<uint8_t> head(16);
-    if (!memory()->ReadMemory(hook_address(), head.data(), head.size()))
-    {
-        return 10; // fallback
-    }
-    // Expected pattern: FF 73 08 C7 45 F4 00 00 00 00
-    if (head.size() >= 10 && head[0] == 0xFF && head[1] == 0x73 && head[2] == 0x08 && head[3] == 0xC7 &&
-        head[4] == 0x45 && head[5] == 0xF4 && head[6] == 0x00 && head[7] == 0x00 && head[8] == 0x00 && head[9] == 0x00)
-    {
-        return 10;
-    }
-    // Fallback: use 10 bytes like Python implementation to avoid splitting instructions
-    if (logger().warn)
-        logger().warn("Instruction-safe steal: unknown prologue; using 10 bytes fallback");
-    return 10;
+    return copy_text_in_detour_ ? kCopiedTextSize + sizeof(uint32_t) : 0;
+}
+
+void DialogHook::EmitCapturePayload(X86CodeBuilder& code) const
+{
+    using Register = X86CodeBuilder::Register;
+
+    // Dialog text: the saved ESI, which the hooked function is about to read itself
+    code.movRegToReg(Register::EDI, Register::ECX);
+    code.movFromMem(Register::ESI, static_cast<uint32_t>(backup_address() + 16));
+    code.copyStringBounded(kCopiedTextSize);
+
+    // NPC name pointer: (saved ESP + 0x14). Only the stack is read; the name itself is read by the host
+    code.movRegToReg(Register::EDI, Register::ECX);
+    code.addImm32(Register::EDI, kCopiedNpcPointerOffset);
+    code.movFromMem(Register::ESI, static_cast<uint32_t>(backup_address() + 28));
+    code.movFromRegDisp8(Register::ESI, Register::ESI, 0x14);
+    code.movToRegDisp8(Register::EDI, 0, Register::ESI);
 }
 
 bool DialogHook::PollDialogData()
@@ -95,54 +129,53 @@ bool DialogHook::PollDialogData()
     try
     {
         // Check if new dialog data flag is set (backup+32)
-        uint8_t flag = 0;
-        if (!memory()->ReadMemory(backup_address() + kFlagOffset, &flag, 1))
-        {
-            return false;
-        }
-
-        if (flag == 0)
+        const PollSnapshot* snapshot = AcquirePollSnapshot();
+        if (!snapshot || snapshot->flag == 0)
         {
             return false; // No new data
         }
 
-        // Read the captured register values
-        uintptr_t text_ptr = 0;
-        uintptr_t npc_ptr = 0;
-
-        if (!memory()->ReadMemory(backup_address() + 16, &text_ptr, 4))
-        {
-            return false;
-        }
-
-        if (!memory()->ReadMemory(backup_address() + 28, &npc_ptr, 4))
-        {
-            return false;
-        }
-
         // Clear the flag
-        uint8_t zero = 0;
-        memory()->WriteMemory(backup_address() + kFlagOffset, &zero, 1);
+        ClearPollFlag();
 
-        // Extract text pointer and npc pointer:
-        // text_ptr (ESI) is already the address of the text string
-        uintptr_t text_address = text_ptr;
-
-        // npc_ptr (ESP): read a 32-bit value at (ESP + 0x14)
-        uintptr_t npc_address = memory()->ReadInt32(npc_ptr + 0x14);
-
-        // Read dialog text
         std::string dialog_text;
-        if (text_address != 0)
+        std::string npc_name = "No_NPC";
+        uint32_t npc_address = 0;
+        ReadRequest npc_request{ 0, &npc_address, sizeof(npc_address) };
+        if (copy_text_in_detour_ && snapshot->payload.size() == CapturePayloadSize())
+        {
+            // Text and NPC name pointer copied by the detour at hook time
+            dialog_text = CopiedString(snapshot->payload, 0, kCopiedTextSize);
+            if (dialog_text.size() == kCopiedTextSize - 1)
+            {
+                TrimToUtf8Boundary(dialog_text);
+                if (logger().warn)
+                {
+                    logger().warn("Dialog text reached the " + std::to_string(kCopiedTextSize - 1) +
+                                  " byte copy limit and may be truncated");
+                }
+            }
+            std::memcpy(&npc_address, snapshot->payload.data() + kCopiedNpcPointerOffset, sizeof(npc_address));
+            npc_request.ok = true;
+        }
+        else
         {
-            memory()->ReadString(text_address, dialog_text, kMaxStringLength);
+            // Captured registers: text_ptr (ESI) is the address of the text string,
+            // the NPC name pointer is the 32-bit value at (ESP + 0x14)
+            const uintptr_t text_address = snapshot->Register(16);
+            const uintptr_t npc_ptr = snapshot->Register(28);
+
+            // Read dialog text; the NPC name pointer is independent and rides along
+            npc_request.address = npc_ptr + 0x14;
+            StringRead text_read{ text_address, kMaxStringLength, &dialog_text };
+            ReadStrings({ &text_read, 1 }, { &npc_request, 1 });
         }
 
         // Read NPC name
-        std::string npc_name = "No_NPC";
-        if (npc_address != 0)
+        StringRead npc_read{ npc_request.ok ? npc_address : 0u, kMaxStringLength, &npc_name };
+        if (npc_read.address != 0)
         {
-            if (!memory()->ReadString(npc_address, npc_name, kMaxStringLength) || npc_name.empty())
+            if (ReadStrings({ &npc_read, 1 }) == 0 || npc_name.empty())
             {
                 npc_name = "No_NPC";
             }
@@ -14,6 +14,14 @@ namespace dqxclarity
  * 
  * Detour payload captures register state (ESI=text ptr, ESP+0x14=NPC ptr),
  * sets new data flag, then restores registers and executes stolen instructions.
+ * With copy_text_in_detour the detour also copies the text and the NPC name
+ * pointer into the capture, so polling sees exactly the text the game passed
+ * in, even if the buffer is reused before the poll. The copy runs on the game
+ * thread: an invalid non-null text pointer faults the game instead of failing
+ * a host read. The name is read by the host, since its pointer comes from the
+ * caller's stack frame and is not otherwise dereferenced by the hooked code.
+ * Copied text is capped at kCopiedTextSize - 1 bytes (the host path reads up
+ * to kMaxStringLength); longer text is cut at a UTF-8 boundary and logged.
  */
 class DialogHook : public HookBase
 {
@@ -35,11 +43,17 @@ protected:
     // HookBase pure virtual implementations
     Pattern GetSignature() const override;
     std::vector<uint8_t> GenerateDetourPayload() override;
-    size_t ComputeStolenLength() override;
+    size_t CapturePayloadSize() const override;
+    void EmitCapturePayload(X86CodeBuilder& code) const override;
 
 private:
     static constexpr size_t kMaxStringLength = 4096;
-    static constexpr size_t kFlagOffset = 32;
+
+    // Capture payload in copy_text_in_detour mode: text[kCopiedTextSize], uint32 npc_name_pointer
+    static constexpr size_t kCopiedTextSize = 2048;
+    static constexpr size_t kCopiedNpcPointerOffset = kCopiedTextSize;
+
+    bool copy_text_in_detour_;
 
     // Dialog data (mutable for const getter methods)
     mutable std::string last_dialog_text_;
@@ -3,8 +3,12 @@
 #include "../memory/MemoryPatch.hpp"
 #include "../util/Profile.hpp"
 #include "Codegen.hpp"
+#include "HookMailbox.hpp"
+#include "InstructionDecoder.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <utility>
 
 namespace dqxclarity
 {
@@ -16,12 +20,17 @@ HookBase::HookBase(const HookCreateInfo& create_info)
     , instruction_safe_steal_(create_info.instruction_safe_steal)
     , readback_bytes_(create_info.readback_bytes)
     , cached_regions_(create_info.cached_regions)
+    , resolved_signatures_(create_info.resolved_signatures)
     , on_original_bytes_changed_(create_info.on_original_bytes_changed)
     , on_hook_site_changed_(create_info.on_hook_site_changed)
     , is_installed_(false)
     , hook_address_(0)
     , detour_address_(0)
     , backup_address_(0)
+    , owns_memory_(true)
+    , event_ring_enabled_(create_info.event_ring)
+    , mailbox_counter_(create_info.mailbox_counter)
+    , backup_size_(256)
 {
 }
 
@@ -45,6 +54,45 @@ bool HookBase::InstallHook(bool enable_patch)
     if (verbose_ && logger_.info)
         logger_.info("Installing hook...");
 
+    // Steps 1-2: Find the hook trigger address and read the bytes to steal
+    if (!ResolveTarget())
+    {
+        return false;
+    }
+
+    // Step 3: Allocate memory for detour
+    if (!AllocateDetourMemory())
+    {
+        if (logger_.error)
+            logger_.error("Failed to allocate detour memory");
+        return false;
+    }
+
+    if (verbose_ && logger_.info)
+    {
+        logger_.info("Detour address: 0x" + std::to_string(static_cast<unsigned long long>(detour_address_)));
+        logger_.info("Backup address: 0x" + std::to_string(static_cast<unsigned long long>(backup_address_)));
+    }
+
+    // Step 4: Write detour code (now that we have stolen bytes)
+    if (!WriteDetourCode())
+    {
+        if (logger_.error)
+            logger_.error("Failed to write detour code");
+        return false;
+    }
+
+    if (!enable_patch)
+    {
+        // Defer patching until first integrity run
+        return true;
+    }
+
+    return EnablePatch();
+}
+
+bool HookBase::ResolveTarget()
+{
     // Step 1: Find the hook trigger address
     if (!FindTargetAddress())
     {
@@ -75,21 +123,7 @@ bool HookBase::InstallHook(bool enable_patch)
         }
     }
 
-    // Step 2: Allocate memory for detour
-    if (!AllocateDetourMemory())
-    {
-        if (logger_.error)
-            logger_.error("Failed to allocate detour memory");
-        return false;
-    }
-
-    if (verbose_ && logger_.info)
-    {
-        logger_.info("Detour address: 0x" + std::to_string(static_cast<unsigned long long>(detour_address_)));
-        logger_.info("Backup address: 0x" + std::to_string(static_cast<unsigned long long>(backup_address_)));
-    }
-
-    // Step 3: Read original bytes FIRST (before writing detour)
+    // Step 2: Read original bytes FIRST (before writing detour)
     size_t stolen_bytes = instruction_safe_steal_ ? ComputeStolenLength() : 10;
     if (stolen_bytes < 5)
         stolen_bytes = 10; // safety
@@ -113,29 +147,13 @@ bool HookBase::InstallHook(bool enable_patch)
         logger_.debug("Original bytes (stolen=" + std::to_string(stolen_bytes) + "): " + hex);
     }
 
-    // Step 4: Write detour code (now that we have stolen bytes)
-    if (!WriteDetourCode())
-    {
-        if (logger_.error)
-            logger_.error("Failed to write detour code");
-        return false;
-    }
-
-    if (!enable_patch)
-    {
-        // Defer patching until first integrity run
-        return true;
-    }
-
-    return EnablePatch();
+    return true;
 }
 
 bool HookBase::EnablePatch()
 {
-    if (!RefreshOriginalBytes())
+    if (!PreparePatch())
     {
-        if (logger_.error)
-            logger_.error("Failed to refresh hook bytes before patch");
         return false;
     }
 
@@ -163,10 +181,62 @@ bool HookBase::EnablePatch()
         }
     }
 
+    MarkPatched();
+    return true;
+}
+
+size_t HookBase::DataAreaSize() const
+{
+    const size_t payload_size = CapturePayloadSize();
+    if (event_ring_enabled_)
+        return HookEventRing(payload_size).AreaSize();
+    return std::max<size_t>(256, kPollPayloadOffset + payload_size);
+}
+
+std::vector<uint8_t> HookBase::InstallAt(uintptr_t detour_address, uintptr_t data_address)
+{
+    if (hook_address_ == 0 || original_bytes_.empty())
+        return {};
+
+    detour_address_ = detour_address;
+    backup_address_ = data_address;
+    owns_memory_ = false;
+    ResetDataArea();
+    return GenerateDetourPayload();
+}
+
+bool HookBase::PreparePatch()
+{
+    if (!RefreshOriginalBytes())
+    {
+        if (logger_.error)
+            logger_.error("Failed to refresh hook bytes before patch");
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> HookBase::PatchBytes() const
+{
+    std::vector<uint8_t> patch_bytes;
+    patch_bytes.push_back(0xE9); // JMP rel32
+    const uint32_t jump_offset = Rel32From(hook_address_, detour_address_);
+    patch_bytes.insert(patch_bytes.end(), reinterpret_cast<const uint8_t*>(&jump_offset),
+                       reinterpret_cast<const uint8_t*>(&jump_offset) + sizeof(uint32_t));
+
+    // Pad with NOPs to match stolen length
+    while (patch_bytes.size() < original_bytes_.size())
+    {
+        patch_bytes.push_back(0x90); // NOP
+    }
+    return patch_bytes;
+}
+
+void HookBase::MarkPatched()
+{
     is_installed_ = true;
     if (verbose_ && logger_.info)
         logger_.info("Hook installed successfully!");
-    return true;
 }
 
 bool HookBase::RemoveHook()
@@ -183,18 +253,27 @@ bool HookBase::RemoveHook()
 
         RestoreOriginalFunction();
 
+        // Detours placed in a HookManager arena are freed with the arena
         if (detour_address_ != 0)
         {
-            memory_->FreeMemory(detour_address_, 4096);
+            if (owns_memory_)
+                memory_->FreeMemory(detour_address_, 4096);
             detour_address_ = 0;
         }
 
         if (backup_address_ != 0)
         {
-            memory_->FreeMemory(backup_address_, 256);
+            if (owns_memory_)
+                memory_->FreeMemory(backup_address_, backup_size_);
             backup_address_ = 0;
         }
 
+        if (event_ring_ && event_ring_->Overflows() > 0 && logger_.warn)
+        {
+            logger_.warn("Hook event ring dropped " + std::to_string(event_ring_->Overflows()) +
+                         " events between polls");
+        }
+
         is_installed_ = false;
         if (verbose_ && logger_.info)
             logger_.info("Hook removed successfully");
@@ -216,18 +295,7 @@ bool HookBase::ReapplyPatch()
         return false;
     }
 
-    std::vector<uint8_t> patch_bytes;
-    patch_bytes.push_back(0xE9); // JMP rel32
-    const uint32_t jump_offset = Rel32From(hook_address_, detour_address_);
-    patch_bytes.insert(patch_bytes.end(), reinterpret_cast<const uint8_t*>(&jump_offset),
-                       reinterpret_cast<const uint8_t*>(&jump_offset) + sizeof(uint32_t));
-
-    // Pad with NOPs to match stolen length
-    while (patch_bytes.size() < original_bytes_.size())
-    {
-        patch_bytes.push_back(0x90); // NOP
-    }
-
+    const std::vector<uint8_t> patch_bytes = PatchBytes();
     if (!MemoryPatch::WriteWithProtect(*memory_, hook_address_, patch_bytes))
     {
         if (logger_.error)
@@ -297,7 +365,20 @@ bool HookBase::FindTargetAddress()
     PatternFinder finder(memory_);
     bool found = false;
 
+    // Tier 0: Address already resolved by the startup multi-signature pass
+    if (resolved_signatures_)
+    {
+        if (auto addr = resolved_signatures_->Lookup(pattern))
+        {
+            hook_address_ = *addr;
+            found = true;
+            if (verbose_ && logger_.info)
+                logger_.info("Hook trigger found via resolved signatures (Tier 0)");
+        }
+    }
+
     // Tier 1: Prefer module-restricted scan (use cached regions if available)
+    if (!found)
     {
         PROFILE_SCOPE_CUSTOM("HookBase.FindInModule");
         uintptr_t addr = 0;
@@ -372,7 +453,9 @@ bool HookBase::AllocateDetourMemory()
         return false;
     }
 
-    backup_address_ = memory_->AllocateMemory(256, false); // data
+    ResetDataArea();
+    owns_memory_ = true;
+    backup_address_ = memory_->AllocateMemory(backup_size_, false); // data
     if (backup_address_ == 0)
     {
         memory_->FreeMemory(detour_address_, 4096);
@@ -382,12 +465,26 @@ bool HookBase::AllocateDetourMemory()
 
     // Initialize flag byte to 0
     uint8_t zero = 0;
-    constexpr size_t kFlagOffset = 32;
-    memory_->WriteMemory(backup_address_ + kFlagOffset, &zero, sizeof(zero));
+    memory_->WriteMemory(backup_address_ + kPollFlagOffset, &zero, sizeof(zero));
+
+    if (event_ring_)
+    {
+        const std::vector<uint8_t> empty(event_ring_->AreaSize() - HookEventRing::kSlotsOffset, 0);
+        memory_->WriteMemory(backup_address_ + HookEventRing::kSlotsOffset, empty.data(), empty.size());
+    }
 
     return true;
 }
 
+void HookBase::ResetDataArea()
+{
+    backup_size_ = DataAreaSize();
+    if (event_ring_enabled_)
+        event_ring_ = std::make_unique<HookEventRing>(CapturePayloadSize());
+    else
+        event_ring_.reset();
+}
+
 bool HookBase::WriteDetourCode()
 {
     auto detour_code = GenerateDetourPayload();
@@ -416,18 +513,7 @@ bool HookBase::PatchOriginalFunction()
         return false;
     }
 
-    std::vector<uint8_t> patch_bytes;
-    patch_bytes.push_back(0xE9); // JMP rel32
-    const uint32_t jump_offset = Rel32From(hook_address_, detour_address_);
-    patch_bytes.insert(patch_bytes.end(), reinterpret_cast<const uint8_t*>(&jump_offset),
-                       reinterpret_cast<const uint8_t*>(&jump_offset) + sizeof(uint32_t));
-
-    // Pad with NOPs
-    while (patch_bytes.size() < original_bytes_.size())
-    {
-        patch_bytes.push_back(0x90); // NOP
-    }
-
+    const std::vector<uint8_t> patch_bytes = PatchBytes();
     if (!MemoryPatch::WriteWithProtect(*memory_, hook_address_, patch_bytes))
     {
         return false;
@@ -594,65 +680,44 @@ bool HookBase::RefreshOriginalBytes()
 
 size_t HookBase::ComputeStolenLength()
 {
-    // Use simple instruction length decoder
-    // This is a simplified version - full implementation would use ldisasm or similar
-    size_t offset = 0;
-    size_t count = 0;
-    constexpr size_t kMaxInstructions = 10;
-    constexpr size_t kMinStolen = 5;
+    return DecodeStolenLength(10);
+}
 
-    std::vector<uint8_t> code(32);
+size_t HookBase::DecodeStolenLength(size_t fallback) const
+{
+    // Covers the longest instruction (15 bytes) starting just below the 5-byte jump
+    std::array<uint8_t, 32> code{};
     if (!memory_->ReadMemory(hook_address_, code.data(), code.size()))
     {
-        return 10; // fallback
+        return fallback;
     }
 
-    while (offset < kMinStolen && count < kMaxInstructions && offset < code.size())
+    const StealLength steal = ComputeStealLength(code);
+    if (steal.length == 0)
     {
-        uint8_t opcode = code[offset];
+        if (logger_.warn)
+            logger_.warn("Instruction-safe steal: undecodable hook site; using " + std::to_string(fallback) +
+                         " bytes fallback");
+        return fallback;
+    }
 
-        // Simple x86 instruction length heuristics (very basic)
-        size_t len = 1;
-        if (opcode == 0x89 || opcode == 0x8B || opcode == 0x8D)
-        { // MOV/LEA with ModRM
-            len = 2;
-            if (offset + 1 < code.size())
-            {
-                uint8_t modrm = code[offset + 1];
-                uint8_t mod = (modrm >> 6) & 0x3;
-                uint8_t rm = modrm & 0x7;
-                if (mod == 0 && rm == 5)
-                    len += 4; // disp32
-                else if (mod == 1)
-                    len += 1; // disp8
-                else if (mod == 2)
-                    len += 4; // disp32
-                if (mod != 3 && rm == 4)
-                    len += 1; // SIB
-            }
-        }
-        else if (opcode == 0xE8 || opcode == 0xE9)
-        { // CALL/JMP rel32
-            len = 5;
-        }
-        else if (opcode == 0x6A)
-        { // PUSH imm8
-            len = 2;
-        }
-        else if (opcode == 0x68)
-        { // PUSH imm32
-            len = 5;
-        }
-        else if (opcode >= 0x50 && opcode <= 0x5F)
-        { // PUSH/POP reg
-            len = 1;
-        }
+    if (steal.has_relative_branch && verbose_ && logger_.debug)
+        logger_.debug("Stolen instructions contain a relative branch; relocating into the detour");
+    return steal.length;
+}
 
-        offset += len;
-        count++;
+void HookBase::AppendStolenInstructions(std::vector<uint8_t>& code) const
+{
+    std::vector<uint8_t> relocated;
+    if (RelocateInstructions(original_bytes_, hook_address_, detour_address_ + code.size(), relocated))
+    {
+        code.insert(code.end(), relocated.begin(), relocated.end());
+        return;
     }
 
-    return (offset >= kMinStolen) ? offset : 10;
+    if (logger_.error)
+        logger_.error("Stolen instructions cannot be relocated; copying them unchanged");
+    code.insert(code.end(), original_bytes_.begin(), original_bytes_.end());
 }
 
 std::vector<uint8_t> HookBase::BuildStandardDetour(const std::vector<uint8_t>& register_backup_code,
@@ -671,7 +736,7 @@ std::vector<uint8_t> HookBase::BuildStandardDetour(const std::vector<uint8_t>& r
     detour.insert(detour.end(), register_restore_code.begin(), register_restore_code.end());
 
     // 4. Stolen instructions
-    detour.insert(detour.end(), original_bytes_.begin(), original_bytes_.end());
+    AppendStolenInstructions(detour);
 
     // 5. Jump back to original code
     detour.push_back(0xE9); // JMP rel32
@@ -684,5 +749,146 @@ std::vector<uint8_t> HookBase::BuildStandardDetour(const std::vector<uint8_t>& r
     return detour;
 }
 
-} // namespace dqxclarity
+std::vector<uint8_t> HookBase::BuildEventSignalCode() const
+{
+    std::vector<uint8_t> payload_code;
+    if (CapturePayloadSize() > 0)
+    {
+        X86CodeBuilder payload_builder;
+        EmitCapturePayload(payload_builder);
+        payload_code = payload_builder.finalize();
+    }
+
+    std::vector<uint8_t> mailbox_code;
+    if (mailbox_counter_ != 0)
+        mailbox_code = HookMailbox::GenerateSignalCode(mailbox_counter_);
+
+    if (event_ring_)
+    {
+        auto code = event_ring_->GenerateAppendCode(backup_address_, payload_code);
+        code.insert(code.end(), mailbox_code.begin(), mailbox_code.end());
+        return code;
+    }
+
+    X86CodeBuilder flag_builder;
+    if (!payload_code.empty())
+    {
+        // The payload is complete before the flag is set
+        flag_builder.pushfd();
+        const uint32_t payload_address = static_cast<uint32_t>(backup_address_ + kPollPayloadOffset);
+        flag_builder.movImm32(X86CodeBuilder::Register::ECX, payload_address);
+        flag_builder.appendBytes(payload_code);
+        flag_builder.popfd();
+    }
+    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address_ + kPollFlagOffset), 0x01);
+    flag_builder.appendBytes(mailbox_code);
+    return flag_builder.finalize();
+}
+
+bool HookBase::QueuePollSnapshot(std::vector<ReadRequest>& requests)
+{
+    poll_snapshot_prefetched_ = false;
+    if (!is_installed_ || backup_address_ == 0)
+        return false;
 
+    if (event_ring_)
+    {
+        requests.push_back(event_ring_->QueueRead(backup_address_));
+        return true;
+    }
+
+    // The detour writes registers before the flag; a page cache would copy them in the opposite order
+    ReadRequest flag{ backup_address_ + kPollFlagOffset, &poll_snapshot_.flag, sizeof(poll_snapshot_.flag) };
+    ReadRequest registers{ backup_address_, poll_snapshot_.registers.data(), poll_snapshot_.registers.size() };
+    const size_t payload_size = CapturePayloadSize();
+    if (payload_size > 0)
+    {
+        // Registers and payload in one range, split by UnpackPollRecord()
+        poll_record_.assign(kPollPayloadOffset + payload_size, 0);
+        registers = ReadRequest{ backup_address_, poll_record_.data(), poll_record_.size() };
+    }
+    flag.bypass_cache = true;
+    registers.bypass_cache = true;
+    requests.push_back(flag);
+    requests.push_back(registers);
+    return true;
+}
+
+void HookBase::SetPollSnapshotPrefetched(bool ok)
+{
+    poll_snapshot_prefetched_ = ok;
+    if (ok && event_ring_)
+        event_ring_->Consume();
+    else if (ok)
+        UnpackPollRecord();
+}
+
+void HookBase::SetPollSnapshotIdle()
+{
+    poll_snapshot_.flag = 0;
+    poll_snapshot_prefetched_ = true;
+}
+
+void HookBase::UnpackPollRecord()
+{
+    if (poll_record_.size() <= kPollPayloadOffset)
+        return;
+    std::memcpy(poll_snapshot_.registers.data(), poll_record_.data(), kPollRegistersSize);
+    poll_snapshot_.payload.assign(poll_record_.begin() + kPollPayloadOffset, poll_record_.end());
+}
+
+uint32_t HookBase::PollSnapshot::Register(size_t offset) const
+{
+    uint32_t value = 0;
+    if (offset + sizeof(value) <= registers.size())
+        std::memcpy(&value, registers.data() + offset, sizeof(value));
+    return value;
+}
+
+const HookBase::PollSnapshot* HookBase::AcquirePollSnapshot()
+{
+    if (event_ring_)
+    {
+        // The prefetch already drained this tick's events; stay prefetched until the next tick queues again
+        if (!poll_snapshot_prefetched_ && event_ring_->Pending() == 0)
+        {
+            if (!is_installed_ || backup_address_ == 0)
+                return nullptr;
+            event_ring_->Drain(*memory_, backup_address_);
+        }
+
+        HookEventRing::Event event;
+        poll_snapshot_.flag = event_ring_->Pop(event) ? 1 : 0;
+        poll_snapshot_.registers = event.registers;
+        poll_snapshot_.payload = std::move(event.payload);
+        return &poll_snapshot_;
+    }
+
+    if (poll_snapshot_prefetched_)
+    {
+        poll_snapshot_prefetched_ = false;
+        return &poll_snapshot_;
+    }
+
+    std::vector<ReadRequest> requests;
+    if (!QueuePollSnapshot(requests))
+        return nullptr;
+    // Skip the register read when there is nothing new
+    if (memory_->ReadBatch({ &requests[0], 1 }) == 0)
+        return nullptr;
+    if (poll_snapshot_.flag != 0 && memory_->ReadBatch({ &requests[1], 1 }) == 0)
+        return nullptr;
+    UnpackPollRecord();
+    return &poll_snapshot_;
+}
+
+void HookBase::ClearPollFlag()
+{
+    if (event_ring_)
+        return;
+
+    uint8_t zero = 0;
+    memory_->WriteMemory(backup_address_ + kPollFlagOffset, &zero, sizeof(zero));
+}
+
+} // namespace dqxclarity
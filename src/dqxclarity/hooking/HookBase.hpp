@@ -2,12 +2,17 @@
 
 #include "IHook.hpp"
 #include "HookCreateInfo.hpp"
+#include "HookEventRing.hpp"
 #include "../pattern/Pattern.hpp"
 #include "../memory/IProcessMemory.hpp"
+#include "../memory/RemoteString.hpp"
 #include "../pattern/MemoryRegion.hpp"
 #include "../api/dqxclarity.hpp"
 
+#include <array>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 #include <cstdint>
 #include <functional>
@@ -15,6 +20,8 @@
 namespace dqxclarity
 {
 
+class X86CodeBuilder;
+
 /**
  * @brief Base class implementing common hook infrastructure
  * 
@@ -39,7 +46,128 @@ public:
     uintptr_t GetBackupAddress() const override { return backup_address_; }
     const std::vector<uint8_t>& GetOriginalBytes() const override { return original_bytes_; }
 
+    /**
+     * @brief Batched installation, driven by HookManager::RegisterHooks()
+     *
+     * ResolveTarget() finds the hook site and reads the bytes to steal;
+     * InstallAt() places the detour at caller-owned addresses and returns its
+     * code for the caller to write; PreparePatch()/PatchBytes() provide the
+     * site patch and MarkPatched() records it once verified. Memory handed to
+     * InstallAt() is not freed by RemoveHook().
+     */
+    bool ResolveTarget();
+
+    /**
+     * @brief Bytes needed for the data area (capture, flag, payload or event ring)
+     */
+    size_t DataAreaSize() const;
+
+    /**
+     * @brief Use detour and data memory owned by the caller
+     * @return Detour code to write at detour_address (empty if ResolveTarget() did not succeed)
+     */
+    std::vector<uint8_t> InstallAt(uintptr_t detour_address, uintptr_t data_address);
+
+    bool PreparePatch();
+    std::vector<uint8_t> PatchBytes() const;
+    void MarkPatched();
+
+    /**
+     * @brief Queue the reads for this hook's poll snapshot (event flag, then captured registers)
+     *
+     * Lets HookManager fetch the snapshots of all hooks in one ReadBatch per tick.
+     * The flag is requested before the registers so a set flag is never paired
+     * with registers read before the detour stored them. In event ring mode a
+     * single read covers the whole ring.
+     * @return false (nothing queued) when the hook is not installed
+     */
+    bool QueuePollSnapshot(std::vector<ReadRequest>& requests);
+
+    /**
+     * @brief Store the outcome of the batch that carried QueuePollSnapshot()'s requests
+     */
+    void SetPollSnapshotPrefetched(bool ok);
+
+    /**
+     * @brief Mark this tick's snapshot as "no new data" without a read (mailbox counter unchanged)
+     */
+    void SetPollSnapshotIdle();
+
+    /**
+     * @brief The hook's event ring, or nullptr with the single-flag layout
+     */
+    const HookEventRing* GetEventRing() const { return event_ring_.get(); }
+
 protected:
+    // Captured registers at backup+0..31 and the new-data flag at backup+32, shared by all capture detours;
+    // a capture payload (CapturePayloadSize() > 0) follows at backup+64
+    static constexpr size_t kPollRegistersSize = 32;
+    static constexpr size_t kPollFlagOffset = 32;
+    static constexpr size_t kPollPayloadOffset = 64;
+
+    struct PollSnapshot
+    {
+        uint8_t flag = 0;
+        std::array<uint8_t, kPollRegistersSize> registers{};
+        std::vector<uint8_t> payload; // CapturePayloadSize() bytes copied by the detour at hook time
+
+        uint32_t Register(size_t offset) const;
+    };
+
+    using StringRead = RemoteStringRead;
+
+    /**
+     * @brief The snapshot prefetched for this tick, or a fresh one read now
+     *
+     * A prefetched snapshot is consumed by the first call. In event ring mode
+     * each call yields the next undrained event (flag set) until the ring is
+     * empty; the ring is read at most once per tick.
+     * @return nullptr if the backup area could not be read
+     */
+    const PollSnapshot* AcquirePollSnapshot();
+
+    /**
+     * @brief Clear the new-data flag so the detour can report the next event (no-op in event ring mode)
+     */
+    void ClearPollFlag();
+
+    /**
+     * @brief Detour code announcing a hit: set the new-data flag, or append to the event ring
+     *
+     * Emitted by GenerateDetourPayload() after the registers are saved. Fills
+     * the capture payload first and bumps the shared mailbox counter last;
+     * the detour must then restore all registers.
+     */
+    std::vector<uint8_t> BuildEventSignalCode() const;
+
+    /**
+     * @brief Bytes the detour copies into each capture at hook time (0 = registers only)
+     *
+     * Must not change once the hook is constructed.
+     */
+    virtual size_t CapturePayloadSize() const { return 0; }
+
+    /**
+     * @brief Emit the code filling the capture payload
+     *
+     * Runs after the registers are saved at backup+0..31, with ECX at the
+     * payload. Must preserve EAX and ECX; EBX, EDX, ESI, EDI and EFLAGS may
+     * be clobbered.
+     */
+    virtual void EmitCapturePayload(X86CodeBuilder& /*code*/) const {}
+
+    /**
+     * @brief Read several NUL-terminated strings, one ReadBatch per growth round
+     *
+     * See ReadRemoteStrings(). Entries with address 0 fail without a read and
+     * have their output cleared; riders travel with the first round.
+     * @return Number of strings read
+     */
+    size_t ReadStrings(std::span<StringRead> reads, std::span<ReadRequest> riders = {})
+    {
+        return ReadRemoteStrings(*memory_, reads, riders);
+    }
+
     // Pure virtual methods - derived classes must implement
     
     /**
@@ -64,6 +192,19 @@ protected:
     // Virtual: override for hook-specific stolen byte computation
     virtual size_t ComputeStolenLength();
 
+    /**
+     * @brief Minimal whole-instruction steal length at the hook site (InstructionDecoder)
+     * @param fallback Returned when the site cannot be read or decoded
+     */
+    size_t DecodeStolenLength(size_t fallback) const;
+
+    /**
+     * @brief Append the stolen instructions at the end of code, relocating relative branches
+     *
+     * code must start at detour_address().
+     */
+    void AppendStolenInstructions(std::vector<uint8_t>& code) const;
+
     // Helper for standard detour pattern (backup → capture → restore → stolen → jump back)
     std::vector<uint8_t> BuildStandardDetour(
         const std::vector<uint8_t>& register_backup_code,
@@ -78,6 +219,8 @@ private:
     bool PatchOriginalFunction();
     void RestoreOriginalFunction();
     bool RefreshOriginalBytes();
+    void ResetDataArea();
+    void UnpackPollRecord();
 
     // Configuration (immutable after construction)
     IProcessMemory* memory_;
@@ -86,6 +229,7 @@ private:
     bool instruction_safe_steal_;
     size_t readback_bytes_;
     std::vector<MemoryRegion> cached_regions_;
+    std::shared_ptr<const ResolvedSignatures> resolved_signatures_;
 
     // Dialog-specific callbacks (optional)
     std::function<void(uintptr_t, const std::vector<uint8_t>&)> on_original_bytes_changed_;
@@ -97,6 +241,18 @@ private:
     uintptr_t detour_address_;
     uintptr_t backup_address_;
     std::vector<uint8_t> original_bytes_;
+    bool owns_memory_; // false when placed by InstallAt()
+
+    // Poll snapshot, filled by HookManager's prefetch or AcquirePollSnapshot()
+    PollSnapshot poll_snapshot_;
+    bool poll_snapshot_prefetched_ = false;
+    std::vector<uint8_t> poll_record_; // backup+0 up to the payload end, read as one range
+
+    // Event ring mode only; the data area then holds the ring as well. Sized at allocation.
+    bool event_ring_enabled_;
+    uintptr_t mailbox_counter_;
+    std::unique_ptr<HookEventRing> event_ring_;
+    size_t backup_size_;
 };
 
 } // namespace dqxclarity
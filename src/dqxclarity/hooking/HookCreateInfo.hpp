@@ -2,6 +2,7 @@
 
 #include "../memory/IProcessMemory.hpp"
 #include "../pattern/MemoryRegion.hpp"
+#include "../pattern/SignatureResolver.hpp"
 #include "../api/dqxclarity.hpp"
 
 #include <functional>
@@ -21,6 +22,24 @@ struct HookCreateInfo
     size_t readback_bytes = 16;
     std::vector<MemoryRegion> cached_regions = {};
 
+    // Detours append each hit to an in-target event ring (HookEventRing) instead of setting a single flag
+    bool event_ring = false;
+
+    // Dialog detour copies the text and NPC name pointer into its capture at hook time (see DialogHook;
+    // the copy dereferences the game's text pointer on the game thread)
+    bool copy_text_in_detour = false;
+
+    // HookManager gives each capture hook a hit counter in one shared mailbox page (HookMailbox);
+    // mailbox_counter is that counter's address, filled in by HookManager
+    bool shared_mailbox = false;
+    uintptr_t mailbox_counter = 0;
+
+    // HookManager::RegisterHooks() places all detours in one arena and EnableAllPatches() patches in one batch
+    bool batched_install = false;
+
+    // Hook addresses resolved up front in a single pass (optional; hooks scan on their own if absent)
+    std::shared_ptr<const ResolvedSignatures> resolved_signatures = {};
+
     // Integrity system callbacks
     std::function<void(uintptr_t address, const std::vector<uint8_t>& bytes)> on_original_bytes_changed;
     std::function<void(uintptr_t old_address, uintptr_t new_address, const std::vector<uint8_t>& bytes)> on_hook_site_changed;
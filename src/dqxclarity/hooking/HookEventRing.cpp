@@ -0,0 +1,134 @@
+#include "HookEventRing.hpp"
+#include "Codegen.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace dqxclarity
+{
+
+static_assert((HookEventRing::kSlots & (HookEventRing::kSlots - 1)) == 0, "slot count must be a power of two");
+static_assert(HookEventRing::kSlotHeaderSize <= 127, "slot header fields are addressed with disp8");
+
+HookEventRing::HookEventRing(size_t payload_size)
+    : payload_size_(payload_size)
+    , slot_size_((kSlotHeaderSize + payload_size + 15) & ~size_t{ 15 })
+{
+}
+
+std::vector<uint8_t> HookEventRing::GenerateAppendCode(uintptr_t area, const std::vector<uint8_t>& payload_code) const
+{
+    using Register = X86CodeBuilder::Register;
+    const uint32_t base = ToImm32(area);
+
+    X86CodeBuilder builder;
+    builder.pushfd();
+
+    // ecx = slot for this event: base + kSlotsOffset + (sequence % kSlots) * SlotSize()
+    const uint32_t write_sequence = base + static_cast<uint32_t>(WriteSequenceOffset());
+    builder.movFromMem(Register::EAX, write_sequence);
+    builder.movRegToReg(Register::ECX, Register::EAX);
+    builder.andImm32(Register::ECX, kSlots - 1);
+    builder.imulImm32(Register::ECX, Register::ECX, static_cast<uint32_t>(slot_size_));
+    builder.addImm32(Register::ECX, base + kSlotsOffset);
+
+    // Registers and payload first, then the slot's sequence, then the write sequence the host polls
+    for (size_t offset = 0; offset < kRegistersSize; offset += sizeof(uint32_t))
+    {
+        builder.movFromMem(Register::EDX, base + static_cast<uint32_t>(offset));
+        builder.movToRegDisp8(Register::ECX, static_cast<int8_t>(offset), Register::EDX);
+    }
+    if (!payload_code.empty())
+    {
+        builder.addImm32(Register::ECX, kSlotHeaderSize);
+        builder.appendBytes(payload_code);
+        builder.addImm32(Register::ECX, static_cast<uint32_t>(-static_cast<int32_t>(kSlotHeaderSize)));
+    }
+    builder.incReg(Register::EAX);
+    builder.movToRegDisp8(Register::ECX, static_cast<int8_t>(kSlotSequenceOffset), Register::EAX);
+    builder.movToMem(Register::EAX, write_sequence);
+
+    builder.popfd();
+    return builder.finalize();
+}
+
+ReadRequest HookEventRing::QueueRead(uintptr_t area)
+{
+    buffer_.assign(AreaSize() - kSlotsOffset, 0);
+    ReadRequest request{ area + kSlotsOffset, buffer_.data(), buffer_.size() };
+    request.bypass_cache = true;
+    return request;
+}
+
+size_t HookEventRing::Consume()
+{
+    if (buffer_.size() != AreaSize() - kSlotsOffset)
+        return 0;
+
+    uint32_t written = 0;
+    std::memcpy(&written, buffer_.data() + (WriteSequenceOffset() - kSlotsOffset), sizeof(written));
+    if (written < consumed_)
+        consumed_ = 0; // Detour area was reset under us
+
+    // The slot of event written + 1 - kSlots may be mid-overwrite
+    uint32_t first = consumed_;
+    if (written - first > kSlots - 1)
+    {
+        overflows_ += written - first - (kSlots - 1);
+        first = written - static_cast<uint32_t>(kSlots - 1);
+    }
+
+    size_t added = 0;
+    for (uint32_t sequence = first + 1; sequence <= written && sequence != 0; ++sequence)
+    {
+        const uint8_t* slot = buffer_.data() + ((sequence - 1) & (kSlots - 1)) * slot_size_;
+        uint32_t slot_sequence = 0;
+        std::memcpy(&slot_sequence, slot + kSlotSequenceOffset, sizeof(slot_sequence));
+        if (slot_sequence < sequence)
+        {
+            // Appended after its slot was copied but before the write sequence was read: retry next drain
+            written = sequence - 1;
+            break;
+        }
+        if (slot_sequence > sequence)
+        {
+            ++overflows_; // Already overwritten by a later event
+            continue;
+        }
+
+        Event event;
+        event.sequence = sequence;
+        std::memcpy(event.registers.data(), slot, kRegistersSize);
+        event.payload.assign(slot + kSlotHeaderSize, slot + kSlotHeaderSize + payload_size_);
+        pending_.push_back(std::move(event));
+        ++added;
+    }
+    consumed_ = written;
+    return added;
+}
+
+size_t HookEventRing::Drain(IProcessMemory& memory, uintptr_t area)
+{
+    const ReadRequest request = QueueRead(area);
+    if (!memory.ReadMemory(request.address, request.buffer, request.size))
+        return 0;
+    return Consume();
+}
+
+bool HookEventRing::Pop(Event& event)
+{
+    if (pending_.empty())
+        return false;
+    event = pending_.front();
+    pending_.pop_front();
+    return true;
+}
+
+void HookEventRing::Reset()
+{
+    buffer_.clear();
+    pending_.clear();
+    consumed_ = 0;
+}
+
+} // namespace dqxclarity
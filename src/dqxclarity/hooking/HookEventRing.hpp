@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../memory/IProcessMemory.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Multi-slot event ring appended by hook detours and drained by the host
+ *
+ * With the single-flag layout a second hit before the next poll overwrites the
+ * first. In ring mode the detour still saves the registers to the hook's data
+ * area (+0..31), then copies them into the next ring slot together with a
+ * 1-based sequence number and bumps the write sequence:
+ *
+ *   +64                    kSlots slots of SlotSize() bytes: registers[32], uint32 sequence, pad, payload
+ *   +WriteSequenceOffset() uint32 number of events appended so far
+ *
+ * A hook may reserve a per-slot payload that its detour fills at hook time
+ * (e.g. a copy of the dialog text), so the host needs no follow-up reads.
+ *
+ * The host reads slots and write sequence with one request. The write
+ * sequence is read last, so a slot the detour may be overwriting during the
+ * copy is never accepted; the ring therefore holds kSlots - 1 undrained
+ * events. Older events are counted as overflows. An event appended while
+ * the read was in flight may be covered by the write sequence but not by
+ * the copied slot; draining stops there and picks it up on the next read.
+ */
+class HookEventRing
+{
+public:
+    static constexpr size_t kRegistersSize = 32;
+    static constexpr size_t kSlots = 64; // Power of two
+    static constexpr size_t kSlotHeaderSize = 48;
+    static constexpr size_t kSlotSequenceOffset = 32;
+    static constexpr size_t kSlotsOffset = 64;
+
+    struct Event
+    {
+        uint32_t sequence = 0;
+        std::array<uint8_t, kRegistersSize> registers{};
+        std::vector<uint8_t> payload;
+    };
+
+    explicit HookEventRing(size_t payload_size = 0);
+
+    size_t PayloadSize() const { return payload_size_; }
+    size_t SlotSize() const { return slot_size_; }
+    size_t WriteSequenceOffset() const { return kSlotsOffset + kSlots * slot_size_; }
+    size_t AreaSize() const { return WriteSequenceOffset() + sizeof(uint32_t); }
+
+    /**
+     * @brief Detour code that appends the registers saved at area+0..31 as one event
+     *
+     * payload_code runs with ECX at the slot's payload and must preserve EAX
+     * and ECX. Clobbers EAX, ECX and EDX plus whatever payload_code clobbers
+     * (restored by the detour's register restore); EFLAGS is preserved.
+     */
+    std::vector<uint8_t> GenerateAppendCode(uintptr_t area, const std::vector<uint8_t>& payload_code = {}) const;
+
+    /**
+     * @brief The read covering slots and write sequence, targeting this ring's buffer
+     */
+    ReadRequest QueueRead(uintptr_t area);
+
+    /**
+     * @brief Move the events in the last completed QueueRead() into the pending queue
+     * @return Number of new events
+     */
+    size_t Consume();
+
+    /**
+     * @brief QueueRead(), one ReadMemory and Consume()
+     */
+    size_t Drain(IProcessMemory& memory, uintptr_t area);
+
+    bool Pop(Event& event);
+    size_t Pending() const { return pending_.size(); }
+
+    // Events overwritten in the target before the host drained them
+    uint64_t Overflows() const { return overflows_; }
+
+    /**
+     * @brief Forget pending events and expect the detour to start from sequence 0
+     */
+    void Reset();
+
+private:
+    size_t payload_size_;
+    size_t slot_size_;
+    std::vector<uint8_t> buffer_;
+    std::deque<Event> pending_;
+    uint32_t consumed_ = 0; // Write sequence seen by the last Consume()
+    uint64_t overflows_ = 0;
+};
+
+} // namespace dqxclarity
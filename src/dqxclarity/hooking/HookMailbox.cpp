@@ -0,0 +1,81 @@
+#include "HookMailbox.hpp"
+#include "Codegen.hpp"
+
+namespace dqxclarity
+{
+
+bool HookMailbox::Allocate(IProcessMemory& memory)
+{
+    if (address_ != 0)
+        return true;
+
+    const uintptr_t address = memory.AllocateMemory(kPageSize, false);
+    if (address == 0)
+        return false;
+
+    const std::vector<uint8_t> zero(kPageSize, 0);
+    if (!memory.WriteMemory(address, zero.data(), zero.size()))
+    {
+        memory.FreeMemory(address, kPageSize);
+        return false;
+    }
+
+    memory_ = &memory;
+    address_ = address;
+    last_poll_ok_ = false;
+    counters_ = {};
+    seen_ = {};
+    return true;
+}
+
+void HookMailbox::Free()
+{
+    if (address_ != 0 && memory_)
+        memory_->FreeMemory(address_, kPageSize);
+    memory_ = nullptr;
+    address_ = 0;
+    last_poll_ok_ = false;
+}
+
+uintptr_t HookMailbox::CounterAddress(size_t slot) const
+{
+    if (address_ == 0 || slot >= kMaxCounters)
+        return 0;
+    return address_ + slot * sizeof(uint32_t);
+}
+
+std::vector<uint8_t> HookMailbox::GenerateSignalCode(uintptr_t counter_address)
+{
+    X86CodeBuilder builder;
+    builder.pushfd();
+    builder.lockIncMem(ToImm32(counter_address));
+    builder.popfd();
+    return builder.finalize();
+}
+
+bool HookMailbox::Poll()
+{
+    last_poll_ok_ = false;
+    if (address_ == 0 || !memory_)
+        return false;
+
+    ReadRequest request{ address_, counters_.data(), sizeof(counters_) };
+    request.bypass_cache = true;
+    last_poll_ok_ = memory_->ReadBatch({ &request, 1 }) == 1;
+    return last_poll_ok_;
+}
+
+bool HookMailbox::Fired(size_t slot) const
+{
+    if (slot >= kMaxCounters)
+        return true;
+    return !last_poll_ok_ || counters_[slot] != seen_[slot];
+}
+
+void HookMailbox::Acknowledge(size_t slot)
+{
+    if (last_poll_ok_ && slot < kMaxCounters)
+        seen_[slot] = counters_[slot];
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../memory/IProcessMemory.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief One shared data page in the target where every capture detour bumps its own hit counter
+ *
+ * Without it the poller reads each hook's flag every tick. With it the
+ * poller reads the counters once and only touches the backup areas of hooks
+ * whose counter moved, so an idle tick costs one read no matter how many
+ * hooks are installed. Detours bump their counter after their capture is
+ * complete (flag set or ring slot appended).
+ */
+class HookMailbox
+{
+public:
+    static constexpr size_t kPageSize = 4096;
+    static constexpr size_t kMaxCounters = 16;
+
+    HookMailbox() = default;
+    ~HookMailbox() = default;
+
+    HookMailbox(const HookMailbox&) = delete;
+    HookMailbox& operator=(const HookMailbox&) = delete;
+
+    /**
+     * @brief Allocate and zero the page; no-op if already allocated
+     */
+    bool Allocate(IProcessMemory& memory);
+
+    /**
+     * @brief Free the page; detours using it must be removed first
+     */
+    void Free();
+
+    bool IsAllocated() const { return address_ != 0; }
+    uintptr_t Address() const { return address_; }
+
+    /**
+     * @brief Target address of a counter, or 0 if unallocated or out of range
+     */
+    uintptr_t CounterAddress(size_t slot) const;
+
+    /**
+     * @brief Detour code incrementing the counter at counter_address (lock inc; EFLAGS preserved)
+     */
+    static std::vector<uint8_t> GenerateSignalCode(uintptr_t counter_address);
+
+    /**
+     * @brief Read all counters with one request
+     * @return false if the page could not be read (Fired() then reports every slot)
+     */
+    bool Poll();
+
+    /**
+     * @brief Whether the counter moved since it was last acknowledged
+     */
+    bool Fired(size_t slot) const;
+
+    /**
+     * @brief Mark the counter value seen by the last Poll() as handled
+     */
+    void Acknowledge(size_t slot);
+
+private:
+    IProcessMemory* memory_ = nullptr;
+    uintptr_t address_ = 0;
+    bool last_poll_ok_ = false;
+    std::array<uint32_t, kMaxCounters> counters_{};
+    std::array<uint32_t, kMaxCounters> seen_{};
+};
+
+} // namespace dqxclarity
@@ -8,12 +8,31 @@
 #include "IntegrityHook.hpp"
 #include "IntegrityMonitor.hpp"
 #include "IHook.hpp"
+#include "HookBase.hpp"
+#include "../memory/MemoryPatch.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <utility>
 
 namespace dqxclarity
 {
 
+namespace
+{
+
+// Detour slots at the start of the hook arena; data areas follow on their own pages
+constexpr size_t kDetourSlotSize = 512;
+constexpr size_t kDataAreaAlignment = 64;
+constexpr size_t kPageSize = 4096;
+
+constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
 bool HookManager::RegisterHook(
     persistence::HookType type,
     const HookCreateInfo& info,
@@ -25,8 +44,168 @@ bool HookManager::RegisterHook(
     {
         memory_ = info.memory;
         logger_ = info.logger;
+        batched_install_ = info.batched_install;
+    }
+
+    HookCreateInfo hook_info = PrepareCreateInfo(type, info, integrity, monitor);
+    std::unique_ptr<IHook> hook = CreateHook(type, hook_info);
+    if (!hook)
+        return false;
+
+    // Install hook (deferred patch - enable later based on policy)
+    if (!hook->InstallHook(/*enable_patch=*/false))
+    {
+        if (logger_.warn)
+        {
+            logger_.warn("Failed to install " + GetHookTypeName(type) + " hook");
+        }
+        return false;
+    }
+
+    const uintptr_t detour_address = hook->GetDetourAddress();
+    AdoptHook(type, std::move(hook), hook_info.mailbox_counter, detour_address, 4096, 256);
+    return true;
+}
+
+size_t HookManager::RegisterHooks(
+    std::span<const persistence::HookType> types,
+    const HookCreateInfo& info,
+    IntegrityHook* integrity,
+    IntegrityMonitor* monitor)
+{
+    if (!memory_)
+    {
+        memory_ = info.memory;
+        logger_ = info.logger;
+        batched_install_ = info.batched_install;
+    }
+
+    // One arena per manager; later registrations install on their own
+    if (!info.batched_install || arena_address_ != 0)
+    {
+        size_t registered = 0;
+        for (const auto type : types)
+        {
+            if (RegisterHook(type, info, integrity, monitor))
+                ++registered;
+        }
+        return registered;
+    }
+
+    struct Pending
+    {
+        persistence::HookType type;
+        std::unique_ptr<IHook> hook;
+        HookBase* base;
+        uintptr_t mailbox_counter;
+        size_t detour_offset;
+        size_t data_offset;
+    };
+
+    // Step 1: create every hook and resolve its site
+    std::vector<Pending> pending;
+    std::vector<persistence::HookType> individual;
+    for (const auto type : types)
+    {
+        const HookCreateInfo hook_info = PrepareCreateInfo(type, info, integrity, monitor);
+        std::unique_ptr<IHook> hook = CreateHook(type, hook_info);
+        auto* base = dynamic_cast<HookBase*>(hook.get());
+        if (!base)
+        {
+            if (hook)
+                individual.push_back(type);
+            continue;
+        }
+        if (!base->ResolveTarget())
+        {
+            if (logger_.warn)
+                logger_.warn("Failed to install " + GetHookTypeName(type) + " hook");
+            continue;
+        }
+        pending.push_back({ type, std::move(hook), base, hook_info.mailbox_counter, 0, 0 });
     }
 
+    // Step 2: one allocation for all detours, data areas on pages of their own
+    const size_t code_size = AlignUp(pending.size() * kDetourSlotSize, kPageSize);
+    size_t data_size = 0;
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        pending[i].detour_offset = i * kDetourSlotSize;
+        pending[i].data_offset = code_size + data_size;
+        data_size += AlignUp(pending[i].base->DataAreaSize(), kDataAreaAlignment);
+    }
+    const size_t arena_size = code_size + AlignUp(data_size, kPageSize);
+    const uintptr_t arena = pending.empty() ? 0 : memory_->AllocateMemory(arena_size, /*executable=*/true);
+
+    // Step 3: generate every detour into one image and write it with a single call
+    std::vector<uint8_t> image(arena != 0 ? arena_size : 0, 0);
+    for (auto it = pending.begin(); arena != 0 && it != pending.end();)
+    {
+        const std::vector<uint8_t> code = it->base->InstallAt(arena + it->detour_offset, arena + it->data_offset);
+        if (code.empty() || code.size() > kDetourSlotSize)
+        {
+            if (logger_.warn)
+                logger_.warn(GetHookTypeName(it->type) + " detour does not fit the hook arena; installing it alone");
+            individual.push_back(it->type);
+            it = pending.erase(it);
+            continue;
+        }
+        std::copy(code.begin(), code.end(), image.begin() + static_cast<std::ptrdiff_t>(it->detour_offset));
+        ++it;
+    }
+
+    if (arena != 0)
+    {
+        // Keep the data areas off executable pages
+        (void)memory_->SetMemoryProtection(arena + code_size, arena_size - code_size, MemoryProtectionFlags::ReadWrite);
+    }
+
+    if (arena == 0 || pending.empty() || !memory_->WriteMemory(arena, image.data(), image.size()))
+    {
+        if (!pending.empty() && logger_.warn)
+            logger_.warn("Failed to set up the hook arena; installing hooks individually");
+        if (arena != 0)
+            memory_->FreeMemory(arena, arena_size);
+        for (const auto& entry : pending)
+            individual.push_back(entry.type);
+        pending.clear();
+    }
+    else
+    {
+        memory_->FlushInstructionCache(arena, code_size);
+        arena_address_ = arena;
+        arena_size_ = arena_size;
+        if (logger_.info)
+        {
+            logger_.info("Placed " + std::to_string(pending.size()) + " hook detours in one " +
+                         std::to_string(arena_size) + " byte arena");
+        }
+    }
+
+    // The arena is recorded with the last of its hooks, so crash recovery restores every site before freeing it
+    size_t registered = pending.size();
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        const bool owns_arena = i + 1 == pending.size();
+        const uintptr_t detour_address = owns_arena ? arena_address_ : pending[i].hook->GetDetourAddress();
+        AdoptHook(pending[i].type, std::move(pending[i].hook), pending[i].mailbox_counter, detour_address,
+                  owns_arena ? arena_size_ : 0, 0);
+    }
+
+    for (const auto type : individual)
+    {
+        if (RegisterHook(type, info, integrity, monitor))
+            ++registered;
+    }
+    return registered;
+}
+
+HookCreateInfo HookManager::PrepareCreateInfo(
+    persistence::HookType type,
+    const HookCreateInfo& info,
+    IntegrityHook* integrity,
+    IntegrityMonitor* monitor)
+{
     // Create HookCreateInfo with integrity callbacks
     HookCreateInfo hook_info = info;
     
@@ -56,51 +235,55 @@ bool HookManager::RegisterHook(
         }
     };
 
-    // Create the appropriate hook type
-    std::unique_ptr<IHook> hook;
-    
+    // Capture hooks signal through the shared mailbox; the integrity hook keeps its own state flag
+    if (info.shared_mailbox && type != persistence::HookType::Integrity)
+    {
+        if (mailbox_.Allocate(*memory_))
+            hook_info.mailbox_counter = mailbox_.CounterAddress(static_cast<size_t>(type));
+        else if (logger_.warn)
+            logger_.warn("Failed to allocate hook mailbox; " + GetHookTypeName(type) + " hook polls its own flag");
+    }
+
+    return hook_info;
+}
+
+std::unique_ptr<IHook> HookManager::CreateHook(persistence::HookType type, const HookCreateInfo& hook_info)
+{
     switch (type)
     {
         case persistence::HookType::Dialog:
-            hook = std::make_unique<DialogHook>(hook_info);
-            break;
+            return std::make_unique<DialogHook>(hook_info);
             
         case persistence::HookType::Quest:
-            hook = std::make_unique<QuestHook>(hook_info);
-            break;
+            return std::make_unique<QuestHook>(hook_info);
             
         case persistence::HookType::Player:
-            hook = std::make_unique<PlayerHook>(hook_info);
-            break;
+            return std::make_unique<PlayerHook>(hook_info);
             
         case persistence::HookType::Corner:
-            hook = std::make_unique<CornerTextHook>(hook_info);
-            break;
+            return std::make_unique<CornerTextHook>(hook_info);
             
         case persistence::HookType::Network:
-            hook = std::make_unique<NetworkTextHook>(hook_info);
-            break;
+            return std::make_unique<NetworkTextHook>(hook_info);
             
         case persistence::HookType::Integrity:
-            hook = std::make_unique<IntegrityHook>(hook_info);
-            break;
+            return std::make_unique<IntegrityHook>(hook_info);
             
         default:
             if (logger_.error)
                 logger_.error("HookManager::RegisterHook called with unknown hook type");
-            return false;
-    }
-
-    // Install hook (deferred patch - enable later based on policy)
-    if (!hook->InstallHook(/*enable_patch=*/false))
-    {
-        if (logger_.warn)
-        {
-            logger_.warn("Failed to install " + GetHookTypeName(type) + " hook");
-        }
-        return false;
+            return nullptr;
     }
+}
 
+void HookManager::AdoptHook(
+    persistence::HookType type,
+    std::unique_ptr<IHook> hook,
+    uintptr_t mailbox_counter,
+    uintptr_t detour_address,
+    size_t detour_size,
+    size_t backup_size)
+{
     // Register with HookRegistry for crash recovery persistence
     if (hook->GetHookAddress() != 0)
     {
@@ -110,10 +293,10 @@ bool HookManager::RegisterHook(
             record.type = type;
             record.process_id = memory_->GetAttachedPid();
             record.hook_address = hook->GetHookAddress();
-            record.detour_address = hook->GetDetourAddress();
-            record.detour_size = 4096;
+            record.detour_address = detour_address;
+            record.detour_size = detour_size;
             record.backup_address = hook->GetBackupAddress();
-            record.backup_size = 256;
+            record.backup_size = backup_size;
             record.original_bytes = hook->GetOriginalBytes();
             record.installed_time = std::chrono::system_clock::now();
             record.hook_checksum = persistence::HookRegistry::ComputeCRC32(
@@ -133,13 +316,13 @@ bool HookManager::RegisterHook(
 
     // Store hook instance
     hooks_[type] = std::move(hook);
+    if (mailbox_counter != 0)
+        mailbox_slots_[type] = static_cast<size_t>(type);
     
     if (logger_.info)
     {
         logger_.info(GetHookTypeName(type) + " hook installed successfully");
     }
-    
-    return true;
 }
 
 void HookManager::RemoveAllHooks()
@@ -167,8 +350,14 @@ void HookManager::RemoveAllHooks()
         }
     }
     
-    // Clear all hooks
+    // Clear all hooks; no detour references the mailbox or the arena any more
     hooks_.clear();
+    mailbox_slots_.clear();
+    mailbox_.Free();
+    if (arena_address_ != 0 && memory_)
+        memory_->FreeMemory(arena_address_, arena_size_);
+    arena_address_ = 0;
+    arena_size_ = 0;
     
     if (logger_.info)
         logger_.info("All hooks removed");
@@ -224,17 +413,122 @@ void HookManager::WireIntegrityCallbacks(IntegrityHook* integrity, IntegrityMoni
     }
 }
 
+void HookManager::PrefetchPollSnapshots()
+{
+    if (!memory_)
+        return;
+
+    // One read tells which mailbox hooks fired; if it fails every hook is read as usual
+    if (!mailbox_slots_.empty())
+        mailbox_.Poll();
+
+    struct Queued
+    {
+        HookBase* hook;
+        size_t first_request;
+        const size_t* mailbox_slot;
+    };
+
+    // Flag and registers per capture hook (or one read of its event ring); filled in one ReadBatch
+    std::vector<ReadRequest> requests;
+    std::vector<Queued> queued;
+    requests.reserve(2 * hooks_.size());
+    for (const auto& [type, hook] : hooks_)
+    {
+        if (type == persistence::HookType::Integrity)
+            continue;
+        auto* base = dynamic_cast<HookBase*>(hook.get());
+        if (!base)
+            continue;
+
+        const auto slot = mailbox_slots_.find(type);
+        const size_t* mailbox_slot = slot != mailbox_slots_.end() ? &slot->second : nullptr;
+        if (mailbox_slot && !mailbox_.Fired(*mailbox_slot))
+        {
+            base->SetPollSnapshotIdle();
+            continue;
+        }
+
+        const size_t first = requests.size();
+        if (base->QueuePollSnapshot(requests))
+            queued.push_back({ base, first, mailbox_slot });
+    }
+    if (queued.empty())
+        return;
+
+    memory_->ReadBatch(requests);
+    for (size_t i = 0; i < queued.size(); ++i)
+    {
+        const size_t end = i + 1 < queued.size() ? queued[i + 1].first_request : requests.size();
+        bool ok = true;
+        for (size_t r = queued[i].first_request; r < end; ++r)
+            ok = ok && requests[r].ok;
+        queued[i].hook->SetPollSnapshotPrefetched(ok);
+        if (ok && queued[i].mailbox_slot)
+            mailbox_.Acknowledge(*queued[i].mailbox_slot);
+    }
+}
+
 void HookManager::EnableAllPatches(const Logger& logger)
 {
+    struct Batched
+    {
+        persistence::HookType type;
+        HookBase* hook;
+    };
+
+    // Batched install: refresh every site, patch them all in one protection window, confirm with one read
+    std::vector<Batched> batched;
+    std::vector<PatchSite> sites;
     for (const auto& [type, hook] : hooks_)
     {
-        if (hook)
+        if (!hook)
+            continue;
+
+        auto* base = batched_install_ && memory_ ? dynamic_cast<HookBase*>(hook.get()) : nullptr;
+        if (base && base->PreparePatch())
         {
-            hook->EnablePatch();
-            if (logger.info)
-            {
-                logger.info(GetHookTypeName(type) + " hook enabled");
-            }
+            batched.push_back({ type, base });
+            sites.push_back({ base->GetHookAddress(), base->PatchBytes() });
+            continue;
+        }
+
+        hook->EnablePatch();
+        if (logger.info)
+        {
+            logger.info(GetHookTypeName(type) + " hook enabled");
+        }
+    }
+    if (sites.empty())
+        return;
+
+    MemoryPatch::WriteManyWithProtect(*memory_, sites);
+
+    std::vector<std::vector<uint8_t>> readback(sites.size());
+    std::vector<ReadRequest> requests(sites.size());
+    for (size_t i = 0; i < sites.size(); ++i)
+    {
+        readback[i].resize(sites[i].bytes.size());
+        requests[i] = { sites[i].address, readback[i].data(), readback[i].size() };
+        requests[i].bypass_cache = true;
+    }
+    memory_->ReadBatch(requests);
+
+    for (size_t i = 0; i < batched.size(); ++i)
+    {
+        if (sites[i].written && requests[i].ok && readback[i] == sites[i].bytes)
+        {
+            batched[i].hook->MarkPatched();
+        }
+        else
+        {
+            if (logger.warn)
+                logger.warn(GetHookTypeName(batched[i].type) + " hook patch not confirmed; patching it alone");
+            batched[i].hook->EnablePatch();
+        }
+        if (logger.info)
+        {
+            logger.info(GetHookTypeName(batched[i].type) + " hook enabled");
         }
     }
 }
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "HookCreateInfo.hpp"
+#include "HookMailbox.hpp"
 #include "HookRegistry.hpp"
 #include "../api/dqxclarity.hpp"
 #include "../memory/IProcessMemory.hpp"
 
 #include <map>
 #include <memory>
+#include <span>
 
 namespace dqxclarity
 {
@@ -49,11 +51,31 @@ public:
         IntegrityHook* integrity,
         IntegrityMonitor* monitor);
 
+    /**
+     * @brief Register several hooks as one installation transaction
+     * 
+     * With HookCreateInfo::batched_install, all hook sites are resolved first,
+     * then every detour and data area is placed in a single allocation and
+     * written with a single call. Hooks that cannot join the arena (or all of
+     * them, without batched_install) go through RegisterHook().
+     * 
+     * @param types Hook types to create, in installation order
+     * @param info Hook configuration (memory, logger, settings)
+     * @param integrity Integrity hook instance for callback wiring (can be nullptr)
+     * @param monitor Integrity monitor instance for callback wiring (can be nullptr)
+     * @return Number of hooks installed
+     */
+    size_t RegisterHooks(
+        std::span<const persistence::HookType> types,
+        const HookCreateInfo& info,
+        IntegrityHook* integrity,
+        IntegrityMonitor* monitor);
+
     /**
      * @brief Remove all hooks and unregister from persistence
      * 
-     * Calls RemoveHook() on each hook, then unregisters from HookRegistry.
-     * Safe to call multiple times.
+     * Calls RemoveHook() on each hook, then unregisters from HookRegistry and
+     * frees the shared mailbox and the hook arena. Safe to call multiple times.
      */
     void RemoveAllHooks();
 
@@ -83,9 +105,23 @@ public:
      */
     void WireIntegrityCallbacks(IntegrityHook* integrity, IntegrityMonitor* monitor);
 
+    /**
+     * @brief Read the poll snapshots of all capture hooks with one batched read
+     * 
+     * Call once per poller tick before the hooks' Poll functions; each hook
+     * consumes its prefetched snapshot instead of reading its backup area itself.
+     * With the shared mailbox only hooks whose counter moved are read; the
+     * others get an empty snapshot, so an idle tick is a single read.
+     */
+    void PrefetchPollSnapshots();
+
     /**
      * @brief Enable patches on all registered hooks
      * 
+     * With batched install the sites are patched together (one protection
+     * flip per page run) and confirmed with one read; unconfirmed hooks fall
+     * back to their own EnablePatch().
+     * 
      * @param logger Logger for diagnostics
      */
     void EnableAllPatches(const Logger& logger);
@@ -107,6 +143,12 @@ public:
 
 private:
     static std::string GetHookTypeName(persistence::HookType type);
+    HookCreateInfo PrepareCreateInfo(
+        persistence::HookType type, const HookCreateInfo& info, IntegrityHook* integrity, IntegrityMonitor* monitor);
+    std::unique_ptr<IHook> CreateHook(persistence::HookType type, const HookCreateInfo& hook_info);
+    void AdoptHook(persistence::HookType type, std::unique_ptr<IHook> hook, uintptr_t mailbox_counter,
+                   uintptr_t detour_address, size_t detour_size, size_t backup_size);
+
     // Hook instances keyed by type
     std::map<persistence::HookType, std::unique_ptr<IHook>> hooks_;
 
@@ -115,6 +157,15 @@ private:
 
     // Logger for hook manager diagnostics
     Logger logger_;
+
+    // Shared hit counters (HookCreateInfo::shared_mailbox) and the counter slot of each hook using them
+    HookMailbox mailbox_;
+    std::map<persistence::HookType, size_t> mailbox_slots_;
+
+    // Batched install (HookCreateInfo::batched_install): one allocation holding the detours and data areas
+    bool batched_install_ = false;
+    uintptr_t arena_address_ = 0;
+    size_t arena_size_ = 0;
 };
 
 } // namespace dqxclarity
@@ -352,6 +352,7 @@ std::vector<HookRecord> HookRegistry::LoadOrphanedHooks()
 size_t HookRegistry::CleanupOrphanedHooks(const std::vector<HookRecord>& orphans)
 {
     size_t cleaned_count = 0;
+    std::vector<const HookRecord*> unrestored;
 
     for (const auto& record : orphans)
     {
@@ -371,11 +372,32 @@ size_t HookRegistry::CleanupOrphanedHooks(const std::vector<HookRecord>& orphans
             continue;
         }
 
+        // Arena hooks are recorded before their owner, so a site that is still patched is known by now; its
+        // detour lives in this allocation, so leave the owner (and the arena) in place for a later retry
+        const bool shares_unrestored =
+            record.detour_size > 0 &&
+            std::any_of(unrestored.begin(), unrestored.end(),
+                        [&record](const HookRecord* other)
+                        {
+                            return other->process_id == record.process_id &&
+                                   other->detour_address >= record.detour_address &&
+                                   other->detour_address < record.detour_address + record.detour_size;
+                        });
+        if (shares_unrestored)
+        {
+            if (s_logger_.warn)
+                s_logger_.warn("Keeping detour memory at 0x" + std::to_string(record.detour_address) +
+                               ": a hook sharing it could not be restored");
+            unrestored.push_back(&record);
+            continue;
+        }
+
         auto memory = MemoryFactory::CreatePlatformMemory();
         if (!memory || !memory->AttachProcess(record.process_id))
         {
             if (s_logger_.error)
                 s_logger_.error("Failed to attach to process for PID " + std::to_string(record.process_id));
+            unrestored.push_back(&record);
             continue;
         }
 
@@ -385,6 +407,7 @@ size_t HookRegistry::CleanupOrphanedHooks(const std::vector<HookRecord>& orphans
             if (s_logger_.error)
                 s_logger_.error("Failed to read current bytes at hook address (expected " +
                                 std::to_string(record.original_bytes.size()) + " bytes)");
+            unrestored.push_back(&record);
             continue;
         }
 
@@ -405,6 +428,7 @@ size_t HookRegistry::CleanupOrphanedHooks(const std::vector<HookRecord>& orphans
         {
             if (s_logger_.error)
                 s_logger_.error("Failed to restore original bytes");
+            unrestored.push_back(&record);
             continue;
         }
 
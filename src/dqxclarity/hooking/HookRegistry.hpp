@@ -110,7 +110,9 @@ public:
      *
      * Attempts to restore original bytes and free allocated memory for each
      * orphaned hook. Uses libmem APIs to attach to the process and perform
-     * memory operations.
+     * memory operations. A record whose detour allocation also holds the
+     * detour of a hook that could not be restored keeps its memory and stays
+     * registered, so a later cleanup can retry both.
      *
      * @param orphans Vector of orphaned hooks to clean up
      * @return Number of successfully cleaned hooks
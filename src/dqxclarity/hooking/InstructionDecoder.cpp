@@ -0,0 +1,90 @@
+#include "InstructionDecoder.hpp"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace dqxclarity
+{
+
+bool RelocateInstructions(std::span<const uint8_t> code, uintptr_t from, uintptr_t to, std::vector<uint8_t>& out)
+{
+    std::vector<uint8_t> relocated;
+    relocated.reserve(code.size() + 8);
+
+    const auto start = static_cast<int64_t>(from);
+    const auto end = start + static_cast<int64_t>(code.size());
+    size_t offset = 0;
+    while (offset < code.size())
+    {
+        const DecodedInstruction instruction = DecodeInstruction(code.subspan(offset));
+        if (instruction.length == 0)
+            return false;
+
+        const uint8_t* bytes = code.data() + offset;
+        if (!instruction.relative)
+        {
+            relocated.insert(relocated.end(), bytes, bytes + instruction.length);
+            offset += instruction.length;
+            continue;
+        }
+
+        int64_t displacement = 0;
+        if (instruction.displacement_size == 1)
+        {
+            displacement = static_cast<int8_t>(bytes[instruction.displacement_offset]);
+        }
+        else if (instruction.displacement_size == 4)
+        {
+            int32_t rel32 = 0;
+            std::memcpy(&rel32, bytes + instruction.displacement_offset, sizeof(rel32));
+            displacement = rel32;
+        }
+        else
+        {
+            return false;
+        }
+
+        // Re-entering at the start goes through the hook again, which is what the original would do
+        const int64_t target = start + static_cast<int64_t>(offset + instruction.length) + displacement;
+        if (target > start && target < end)
+            return false;
+
+        const uint8_t opcode = bytes[instruction.displacement_offset - 1];
+        if (instruction.displacement_size == 1)
+        {
+            if (opcode == 0xEB)
+            {
+                relocated.push_back(0xE9); // jmp rel32
+            }
+            else if (opcode >= 0x70 && opcode <= 0x7F)
+            {
+                relocated.push_back(0x0F); // jcc rel32
+                relocated.push_back(static_cast<uint8_t>(0x80 + (opcode - 0x70)));
+            }
+            else
+            {
+                return false; // loop/jecxz have no rel32 form
+            }
+        }
+        else
+        {
+            relocated.insert(relocated.end(), bytes, bytes + instruction.displacement_offset);
+        }
+
+        const int64_t next = static_cast<int64_t>(to) + static_cast<int64_t>(relocated.size() + sizeof(int32_t));
+        const int64_t new_displacement = target - next;
+        if (new_displacement < std::numeric_limits<int32_t>::min() ||
+            new_displacement > std::numeric_limits<int32_t>::max())
+            return false;
+        const auto rel32 = static_cast<int32_t>(new_displacement);
+        const auto* rel_bytes = reinterpret_cast<const uint8_t*>(&rel32);
+        relocated.insert(relocated.end(), rel_bytes, rel_bytes + sizeof(rel32));
+        offset += instruction.length;
+    }
+
+    out = std::move(relocated);
+    return true;
+}
+
+} // namespace dqxclarity
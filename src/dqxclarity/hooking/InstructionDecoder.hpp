@@ -0,0 +1,334 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief One decoded x86-32 instruction
+ */
+struct DecodedInstruction
+{
+    size_t length = 0;              // 0: unknown opcode or truncated input
+    bool relative = false;          // Branch or call with a PC-relative target
+    size_t displacement_offset = 0; // Position of the relative displacement
+    size_t displacement_size = 0;   // 1, 2 or 4 bytes
+};
+
+/**
+ * @brief Minimal instruction-aligned number of bytes to overwrite at a hook site
+ */
+struct StealLength
+{
+    size_t length = 0; // 0: an instruction before min_length could not be decoded
+    size_t instructions = 0;
+    bool has_relative_branch = false; // Stolen code must be relocated (RelocateInstructions)
+};
+
+namespace x86_decode
+{
+
+// Opcode properties for the one- and two-byte maps
+enum : uint16_t
+{
+    kModRM = 1 << 0,
+    kImm8 = 1 << 1,
+    kImm16 = 1 << 2,
+    kImmZ = 1 << 3,   // imm16/imm32 by operand size
+    kRel8 = 1 << 4,
+    kRelZ = 1 << 5,   // rel16/rel32 by operand size
+    kMoffs = 1 << 6,  // moffs16/moffs32 by address size
+    kGroup3 = 1 << 7, // F6/F7: imm only for /0 and /1 (test)
+    kPrefix = 1 << 8,
+    kEscape = 1 << 9, // 0F
+    kValid = 1 << 15,
+};
+
+constexpr std::array<uint16_t, 256> BuildOneByteTable()
+{
+    std::array<uint16_t, 256> t{};
+    auto set = [&t](int first, int last, uint16_t flags)
+    {
+        for (int op = first; op <= last; ++op)
+            t[op] = static_cast<uint16_t>(flags | kValid);
+    };
+
+    // ALU blocks 00-3F: op r/m,r (x4), op al,imm8, op eax,immz, then push/pop/prefix/BCD
+    for (int row = 0x00; row < 0x40; row += 0x08)
+    {
+        set(row, row + 3, kModRM);
+        set(row + 4, row + 4, kImm8);
+        set(row + 5, row + 5, kImmZ);
+        set(row + 6, row + 7, 0);
+    }
+    set(0x0F, 0x0F, kEscape);
+    set(0x26, 0x26, kPrefix);
+    set(0x2E, 0x2E, kPrefix);
+    set(0x36, 0x36, kPrefix);
+    set(0x3E, 0x3E, kPrefix);
+
+    set(0x40, 0x61, 0); // inc/dec/push/pop reg, pushad/popad
+    set(0x62, 0x63, kModRM);
+    set(0x64, 0x67, kPrefix);
+    set(0x68, 0x68, kImmZ);
+    set(0x69, 0x69, kModRM | kImmZ);
+    set(0x6A, 0x6A, kImm8);
+    set(0x6B, 0x6B, kModRM | kImm8);
+    set(0x6C, 0x6F, 0);
+    set(0x70, 0x7F, kRel8);
+
+    set(0x80, 0x80, kModRM | kImm8);
+    set(0x81, 0x81, kModRM | kImmZ);
+    set(0x82, 0x83, kModRM | kImm8);
+    set(0x84, 0x8F, kModRM);
+    set(0x90, 0x99, 0);
+    set(0x9A, 0x9A, kImmZ | kImm16); // call far ptr16:32
+    set(0x9B, 0x9F, 0);
+    set(0xA0, 0xA3, kMoffs);
+    set(0xA4, 0xA7, 0);
+    set(0xA8, 0xA8, kImm8);
+    set(0xA9, 0xA9, kImmZ);
+    set(0xAA, 0xAF, 0);
+    set(0xB0, 0xB7, kImm8);
+    set(0xB8, 0xBF, kImmZ);
+
+    set(0xC0, 0xC1, kModRM | kImm8);
+    set(0xC2, 0xC2, kImm16);
+    set(0xC3, 0xC3, 0);
+    set(0xC4, 0xC5, kModRM);
+    set(0xC6, 0xC6, kModRM | kImm8);
+    set(0xC7, 0xC7, kModRM | kImmZ);
+    set(0xC8, 0xC8, kImm16 | kImm8); // enter
+    set(0xC9, 0xC9, 0);
+    set(0xCA, 0xCA, kImm16);
+    set(0xCB, 0xCC, 0);
+    set(0xCD, 0xCD, kImm8);
+    set(0xCE, 0xCF, 0);
+    set(0xD0, 0xD3, kModRM);
+    set(0xD4, 0xD5, kImm8);
+    set(0xD7, 0xD7, 0);
+    set(0xD8, 0xDF, kModRM); // x87
+    set(0xE0, 0xE3, kRel8);  // loop/jecxz
+    set(0xE4, 0xE7, kImm8);
+    set(0xE8, 0xE9, kRelZ);
+    set(0xEA, 0xEA, kImmZ | kImm16); // jmp far ptr16:32
+    set(0xEB, 0xEB, kRel8);
+    set(0xEC, 0xEF, 0);
+    set(0xF0, 0xF0, kPrefix);
+    set(0xF1, 0xF1, 0);
+    set(0xF2, 0xF3, kPrefix);
+    set(0xF4, 0xF5, 0);
+    set(0xF6, 0xF6, kModRM | kGroup3 | kImm8);
+    set(0xF7, 0xF7, kModRM | kGroup3 | kImmZ);
+    set(0xF8, 0xFD, 0);
+    set(0xFE, 0xFF, kModRM);
+    return t;
+}
+
+constexpr std::array<uint16_t, 256> BuildTwoByteTable()
+{
+    std::array<uint16_t, 256> t{};
+    auto set = [&t](int first, int last, uint16_t flags)
+    {
+        for (int op = first; op <= last; ++op)
+            t[op] = static_cast<uint16_t>(flags | kValid);
+    };
+
+    set(0x00, 0x03, kModRM);
+    set(0x05, 0x09, 0);
+    set(0x0B, 0x0B, 0); // ud2
+    set(0x0D, 0x0D, kModRM);
+    set(0x10, 0x1F, kModRM); // SSE moves, prefetch, multi-byte nop
+    set(0x20, 0x23, kModRM);
+    set(0x28, 0x2F, kModRM);
+    set(0x30, 0x35, 0);
+    set(0x40, 0x6F, kModRM); // cmovcc, SSE/MMX
+    set(0x70, 0x73, kModRM | kImm8);
+    set(0x74, 0x76, kModRM);
+    set(0x77, 0x77, 0); // emms
+    set(0x7C, 0x7F, kModRM);
+    set(0x80, 0x8F, kRelZ); // jcc rel32
+    set(0x90, 0x9F, kModRM); // setcc
+    set(0xA0, 0xA2, 0);
+    set(0xA3, 0xA3, kModRM);
+    set(0xA4, 0xA4, kModRM | kImm8);
+    set(0xA5, 0xA5, kModRM);
+    set(0xA8, 0xAA, 0);
+    set(0xAB, 0xAB, kModRM);
+    set(0xAC, 0xAC, kModRM | kImm8);
+    set(0xAD, 0xB9, kModRM);
+    set(0xBA, 0xBA, kModRM | kImm8);
+    set(0xBB, 0xC1, kModRM);
+    set(0xC2, 0xC2, kModRM | kImm8);
+    set(0xC3, 0xC3, kModRM);
+    set(0xC4, 0xC6, kModRM | kImm8);
+    set(0xC7, 0xC7, kModRM);
+    set(0xC8, 0xCF, 0); // bswap
+    set(0xD0, 0xFF, kModRM);
+    return t;
+}
+
+inline constexpr std::array<uint16_t, 256> kOneByte = BuildOneByteTable();
+inline constexpr std::array<uint16_t, 256> kTwoByte = BuildTwoByteTable();
+
+// Length of ModR/M + SIB + displacement starting at code[pos], or 0 if truncated
+constexpr size_t ModRMLength(std::span<const uint8_t> code, size_t pos, bool address16)
+{
+    if (pos >= code.size())
+        return 0;
+    const uint8_t modrm = code[pos];
+    const uint8_t mod = modrm >> 6;
+    const uint8_t rm = modrm & 7;
+    size_t length = 1;
+    if (mod == 3)
+        return length;
+
+    if (address16)
+    {
+        if (mod == 1)
+            length += 1;
+        else if (mod == 2 || (mod == 0 && rm == 6))
+            length += 2;
+    }
+    else
+    {
+        if (rm == 4)
+        {
+            if (pos + 1 >= code.size())
+                return 0;
+            ++length;
+            if (mod == 0 && (code[pos + 1] & 7) == 5)
+                length += 4; // SIB without base: disp32
+        }
+        if (mod == 1)
+            length += 1;
+        else if (mod == 2 || (mod == 0 && rm == 5))
+            length += 4;
+    }
+    return pos + length <= code.size() ? length : 0;
+}
+
+} // namespace x86_decode
+
+/**
+ * @brief Decode the length of the x86-32 instruction at the start of code
+ *
+ * Table-driven over the one-byte and 0F opcode maps (0F 38/0F 3A included);
+ * usable at compile time. VEX/EVEX and 3DNow! encodings are reported as unknown.
+ */
+constexpr DecodedInstruction DecodeInstruction(std::span<const uint8_t> code)
+{
+    using namespace x86_decode;
+    constexpr size_t kMaxLength = 15;
+
+    DecodedInstruction result;
+    bool operand16 = false;
+    bool address16 = false;
+    size_t pos = 0;
+    while (pos < code.size() && pos < kMaxLength && (kOneByte[code[pos]] & kPrefix))
+    {
+        operand16 = operand16 || code[pos] == 0x66;
+        address16 = address16 || code[pos] == 0x67;
+        ++pos;
+    }
+    if (pos >= code.size())
+        return result;
+
+    uint16_t flags = kOneByte[code[pos]];
+    const uint8_t opcode = code[pos++];
+    if ((opcode == 0xC4 || opcode == 0xC5) && pos < code.size() && (code[pos] >> 6) == 3)
+        return result; // VEX prefix, not les/lds
+    if (flags & kEscape)
+    {
+        if (pos >= code.size())
+            return result;
+        const uint8_t second = code[pos++];
+        if (second == 0x38 || second == 0x3A)
+        {
+            // Three-byte maps: all take ModR/M, 0F 3A also an imm8
+            if (pos >= code.size())
+                return result;
+            ++pos;
+            flags = static_cast<uint16_t>(kValid | kModRM | (second == 0x3A ? kImm8 : 0));
+        }
+        else
+        {
+            flags = kTwoByte[second];
+        }
+    }
+    if (!(flags & kValid))
+        return result;
+
+    uint8_t modrm_reg = 0;
+    if (flags & kModRM)
+    {
+        const size_t modrm_length = ModRMLength(code, pos, address16);
+        if (modrm_length == 0)
+            return result;
+        modrm_reg = (code[pos] >> 3) & 7;
+        pos += modrm_length;
+    }
+
+    size_t immediate = 0;
+    const bool has_immediate = !(flags & kGroup3) || modrm_reg <= 1;
+    if (has_immediate)
+    {
+        if (flags & kImm8)
+            immediate += 1;
+        if (flags & kImm16)
+            immediate += 2;
+        if (flags & kImmZ)
+            immediate += operand16 ? 2 : 4;
+    }
+    if (flags & kMoffs)
+        immediate += address16 ? 2 : 4;
+    if (flags & (kRel8 | kRelZ))
+    {
+        result.relative = true;
+        result.displacement_offset = pos;
+        result.displacement_size = (flags & kRel8) ? 1 : (operand16 ? 2 : 4);
+        immediate += result.displacement_size;
+    }
+
+    pos += immediate;
+    if (pos > code.size() || pos > kMaxLength)
+        return DecodedInstruction{};
+    result.length = pos;
+    return result;
+}
+
+/**
+ * @brief Smallest run of whole instructions covering at least min_length bytes (a jmp rel32 by default)
+ */
+constexpr StealLength ComputeStealLength(std::span<const uint8_t> code, size_t min_length = 5)
+{
+    StealLength result;
+    size_t offset = 0;
+    while (offset < min_length)
+    {
+        const DecodedInstruction instruction = DecodeInstruction(code.subspan(offset));
+        if (instruction.length == 0)
+            return StealLength{};
+        offset += instruction.length;
+        ++result.instructions;
+        result.has_relative_branch = result.has_relative_branch || instruction.relative;
+    }
+    result.length = offset;
+    return result;
+}
+
+/**
+ * @brief Copy whole instructions from address from so they run at address to
+ *
+ * rel32 targets are re-aimed; jmp/jcc rel8 are widened to their rel32 forms.
+ * Fails (false) for loop/jecxz, 16-bit displacements, targets inside the
+ * copied range other than its start, and undecodable bytes.
+ */
+bool RelocateInstructions(std::span<const uint8_t> code, uintptr_t from, uintptr_t to, std::vector<uint8_t>& out);
+
+} // namespace dqxclarity
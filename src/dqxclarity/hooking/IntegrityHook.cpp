@@ -1,6 +1,7 @@
 #include "IntegrityHook.hpp"
 #include "../signatures/Signatures.hpp"
 #include "Codegen.hpp"
+#include "InstructionDecoder.hpp"
 #include "../util/Profile.hpp"
 #include <cstring>
 #include <sstream>
@@ -103,8 +104,8 @@ std::vector<uint8_t> IntegrityHook::GenerateDetourPayload()
     }
     else
     {
-        // Standard case: copy stolen bytes as-is
-        code.insert(code.end(), stolen.begin(), stolen.end());
+        // Standard case: copy stolen bytes, relocating any relative branch
+        AppendStolenInstructions(code);
     }
 
     // Return jump (only if not tail-calling via E9)
@@ -152,7 +153,7 @@ size_t IntegrityHook::ComputeStolenLength()
             return offset;
         }
 
-        size_t len = DecodeInstrLen(buf + offset, sizeof(buf) - offset);
+        size_t len = DecodeInstruction(std::span<const uint8_t>(buf).subspan(offset)).length;
         if (len == 0)
             break; // Decoding failed
 
@@ -209,100 +210,5 @@ std::vector<IntegrityHook::RestoreSite> IntegrityHook::GetRestoreSites() const
     return restore_sites_;
 }
 
-// Simple x86 instruction decoder for integrity hook boundary detection
-size_t IntegrityHook::DecodeInstrLen(const uint8_t* p, size_t max)
-{
-    if (max == 0)
-        return 0;
-
-    const uint8_t op = p[0];
-
-    // E9: jmp rel32 (5 bytes)
-    if (op == 0xE9)
-        return (max >= 5) ? 5 : 0;
-
-    // 6A: push imm8 (2 bytes)
-    if (op == 0x6A)
-        return (max >= 2) ? 2 : 0;
-
-    // ModR/M decoder for 89/8B/8D opcodes
-    auto decode_modrm = [&](size_t i) -> size_t
-    {
-        if (i >= max)
-            return 0;
-        
-        uint8_t modrm = p[i++];
-        uint8_t mod = (modrm >> 6) & 0x3;
-        uint8_t rm = (modrm & 0x7);
-
-        // SIB byte present when mod != 3 and rm == 4
-        if (mod != 3 && rm == 4)
-        {
-            if (i >= max)
-                return 0;
-            ++i; // Skip SIB
-        }
-
-        // Displacement
-        if (mod == 1)
-        {
-            // disp8
-            if (i + 1 > max)
-                return 0;
-            i += 1;
-        }
-        else if (mod == 2)
-        {
-            // disp32
-            if (i + 4 > max)
-                return 0;
-            i += 4;
-        }
-        else if (mod == 0 && rm == 5)
-        {
-            // disp32 (no base)
-            if (i + 4 > max)
-                return 0;
-            i += 4;
-        }
-
-        return i;
-    };
-
-    switch (op)
-    {
-    case 0x89: // mov r/m32, r32
-    case 0x8B: // mov r32, r/m32
-    case 0x8D: // lea r32, m
-    {
-        size_t result = decode_modrm(1);
-        return (result > 0) ? result : 0;
-    }
-    default:
-        return 0; // Unknown opcode
-    }
-}
-
-bool IntegrityHook::HasPcRelativeBranch(const uint8_t* data, size_t n)
-{
-    for (size_t i = 0; i < n; ++i)
-    {
-        uint8_t b = data[i];
-        
-        // E8/E9/EB: call/jmp
-        if (b == 0xE8 || b == 0xE9 || b == 0xEB)
-            return true;
-        
-        // 0F 8x: conditional jumps
-        if (b == 0x0F && i + 1 < n)
-        {
-            uint8_t b2 = data[i + 1];
-            if ((b2 & 0xF0) == 0x80)
-                return true;
-        }
-    }
-    return false;
-}
-
 } // namespace dqxclarity
 
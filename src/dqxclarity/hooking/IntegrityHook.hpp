@@ -49,10 +49,6 @@ private:
     std::vector<RestoreSite> restore_sites_;
     mutable std::mutex restore_mutex_;
     bool diagnostics_enabled_ = false;
-
-    // Instruction decoding for safe stolen byte calculation
-    static size_t DecodeInstrLen(const uint8_t* p, size_t max);
-    static bool HasPcRelativeBranch(const uint8_t* data, size_t n);
 };
 
 } // namespace dqxclarity
@@ -32,11 +32,9 @@ std::vector<uint8_t> NetworkTextHook::GenerateDetourPayload()
     const auto& backup_code = backup_builder.code();
     code.insert(code.end(), backup_code.begin(), backup_code.end());
 
-    // 2. Set new data flag
-    X86CodeBuilder flag_builder;
-    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address() + kFlagOffset), 0x01);
-    const auto& flag_code = flag_builder.code();
-    code.insert(code.end(), flag_code.begin(), flag_code.end());
+    // 2. Signal the event (new data flag, or an event ring slot)
+    const auto signal_code = BuildEventSignalCode();
+    code.insert(code.end(), signal_code.begin(), signal_code.end());
 
     // 3. Restore all registers
     X86CodeBuilder restore_builder;
@@ -52,7 +50,7 @@ std::vector<uint8_t> NetworkTextHook::GenerateDetourPayload()
     code.insert(code.end(), restore_code.begin(), restore_code.end());
 
     // 4. Append stolen instructions
-    code.insert(code.end(), stolen_bytes().begin(), stolen_bytes().end());
+    AppendStolenInstructions(code);
 
     // 5. Jump back to original code
     X86CodeBuilder jmp_builder;
@@ -67,7 +65,7 @@ std::vector<uint8_t> NetworkTextHook::GenerateDetourPayload()
 
 size_t NetworkTextHook::ComputeStolenLength()
 {
-    return kDefaultStolenBytes;
+    return DecodeStolenLength(kDefaultStolenBytes);
 }
 
 bool NetworkTextHook::PollNetworkText()
@@ -77,53 +75,25 @@ bool NetworkTextHook::PollNetworkText()
         return false;
     }
 
-    uint8_t flag = 0;
-    if (!memory()->ReadMemory(backup_address() + kFlagOffset, &flag, sizeof(flag)))
+    const PollSnapshot* snapshot = AcquirePollSnapshot();
+    if (!snapshot || snapshot->flag == 0)
     {
         return false;
     }
 
-    if (flag == 0)
-    {
-        return false;
-    }
+    ClearPollFlag();
 
-    uint8_t zero = 0;
-    memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
-
-    uint32_t text_ptr_raw = 0;
-    uint32_t category_ptr_raw = 0;
-    if (!memory()->ReadMemory(backup_address() + kTextRegisterOffset, &text_ptr_raw, sizeof(text_ptr_raw)))
-    {
-        return false;
-    }
-    if (!memory()->ReadMemory(backup_address() + kCategoryRegisterOffset, &category_ptr_raw, sizeof(category_ptr_raw)))
-    {
-        return false;
-    }
-
-    const uintptr_t text_ptr = static_cast<uintptr_t>(text_ptr_raw);
-    const uintptr_t category_ptr = static_cast<uintptr_t>(category_ptr_raw);
+    const uintptr_t text_ptr = static_cast<uintptr_t>(snapshot->Register(kTextRegisterOffset));
+    const uintptr_t category_ptr = static_cast<uintptr_t>(snapshot->Register(kCategoryRegisterOffset));
 
     last_capture_.text_ptr = text_ptr;
     last_capture_.category_ptr = category_ptr;
 
     std::string category;
     std::string text;
-    if (category_ptr != 0)
-    {
-        if (!memory()->ReadString(category_ptr, category, kMaxCategoryLength))
-        {
-            category.clear();
-        }
-    }
-    if (text_ptr != 0)
-    {
-        if (!memory()->ReadString(text_ptr, text, kMaxTextLength))
-        {
-            text.clear();
-        }
-    }
+    std::array<StringRead, 2> reads{ { { category_ptr, kMaxCategoryLength, &category },
+                                       { text_ptr, kMaxTextLength, &text } } };
+    ReadStrings(reads);
 
     last_capture_.category = std::move(category);
     last_capture_.text = std::move(text);
@@ -41,10 +41,9 @@ protected:
     size_t ComputeStolenLength() override;
 
 private:
-    static constexpr size_t kFlagOffset = 32;
     static constexpr size_t kMaxCategoryLength = 128;
     static constexpr size_t kMaxTextLength = 2048;
-    static constexpr size_t kDefaultStolenBytes = 5;
+    static constexpr size_t kDefaultStolenBytes = 5; // When the hook site cannot be decoded
     static constexpr size_t kCategoryRegisterOffset = 4;  // EBX
     static constexpr size_t kTextRegisterOffset = 12;      // EDX
 
@@ -32,11 +32,9 @@ std::vector<uint8_t> PlayerHook::GenerateDetourPayload()
     const auto& backup_code = backup_builder.code();
     code.insert(code.end(), backup_code.begin(), backup_code.end());
 
-    // 2. Set new data flag
-    X86CodeBuilder flag_builder;
-    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address() + kFlagOffset), 0x01);
-    const auto& flag_code = flag_builder.code();
-    code.insert(code.end(), flag_code.begin(), flag_code.end());
+    // 2. Signal the event (new data flag, or an event ring slot)
+    const auto signal_code = BuildEventSignalCode();
+    code.insert(code.end(), signal_code.begin(), signal_code.end());
 
     // 3. Restore all registers
     X86CodeBuilder restore_builder;
@@ -52,7 +50,7 @@ std::vector<uint8_t> PlayerHook::GenerateDetourPayload()
     code.insert(code.end(), restore_code.begin(), restore_code.end());
 
     // 4. Append stolen instructions
-    code.insert(code.end(), stolen_bytes().begin(), stolen_bytes().end());
+    AppendStolenInstructions(code);
 
     // 5. Jump back to original code
     X86CodeBuilder jmp_builder;
@@ -67,7 +65,7 @@ std::vector<uint8_t> PlayerHook::GenerateDetourPayload()
 
 size_t PlayerHook::ComputeStolenLength()
 {
-    return kDefaultStolenBytes;
+    return DecodeStolenLength(kDefaultStolenBytes);
 }
 
 bool PlayerHook::PollPlayerData()
@@ -77,27 +75,14 @@ bool PlayerHook::PollPlayerData()
         return false;
     }
 
-    uint8_t flag = 0;
-    if (!memory()->ReadMemory(backup_address() + kFlagOffset, &flag, sizeof(flag)))
+    const PollSnapshot* snapshot = AcquirePollSnapshot();
+    if (!snapshot || snapshot->flag == 0)
     {
         return false;
     }
 
-    if (flag == 0)
-    {
-        return false;
-    }
-
-    uint32_t ptr_raw = 0;
-    if (!memory()->ReadMemory(backup_address(), &ptr_raw, sizeof(ptr_raw)))
-    {
-        uint8_t zero = 0;
-        memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
-        return false;
-    }
-
-    uint8_t zero = 0;
-    memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
+    const uint32_t ptr_raw = snapshot->Register(0);
+    ClearPollFlag();
 
     if (ptr_raw == 0)
     {
@@ -107,21 +92,9 @@ bool PlayerHook::PollPlayerData()
     const uintptr_t struct_ptr = static_cast<uintptr_t>(ptr_raw);
 
     PlayerInfo data;
-    auto read_field = [&](uint32_t offset, std::string& out)
-    {
-        std::string value;
-        if (memory()->ReadString(struct_ptr + offset, value, kMaxStringLength))
-        {
-            out = std::move(value);
-        }
-        else
-        {
-            out.clear();
-        }
-    };
-
-    read_field(kPlayerNameOffset, data.player_name);
-    read_field(kSiblingNameOffset, data.sibling_name);
+    std::array<StringRead, 2> reads{ { { struct_ptr + kPlayerNameOffset, kMaxStringLength, &data.player_name },
+                                       { struct_ptr + kSiblingNameOffset, kMaxStringLength, &data.sibling_name } } };
+    ReadStrings(reads);
 
     uint8_t rel_byte = 0;
     if (memory()->ReadMemory(struct_ptr + kRelationshipOffset, &rel_byte, sizeof(rel_byte)))
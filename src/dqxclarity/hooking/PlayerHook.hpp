@@ -30,9 +30,8 @@ protected:
     size_t ComputeStolenLength() override;
 
 private:
-    static constexpr size_t kFlagOffset = 32;
     static constexpr size_t kMaxStringLength = 128;
-    static constexpr size_t kDefaultStolenBytes = 6;
+    static constexpr size_t kDefaultStolenBytes = 6; // When the hook site cannot be decoded
 
     // Offsets for player data
     static constexpr uint32_t kPlayerNameOffset = 24;
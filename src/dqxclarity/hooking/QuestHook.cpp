@@ -32,11 +32,9 @@ std::vector<uint8_t> QuestHook::GenerateDetourPayload()
     const auto& backup_code = backup_builder.code();
     code.insert(code.end(), backup_code.begin(), backup_code.end());
 
-    // 2. Set new data flag
-    X86CodeBuilder flag_builder;
-    flag_builder.setByteAtMem(static_cast<uint32_t>(backup_address() + kFlagOffset), 0x01);
-    const auto& flag_code = flag_builder.code();
-    code.insert(code.end(), flag_code.begin(), flag_code.end());
+    // 2. Signal the event (new data flag, or an event ring slot)
+    const auto signal_code = BuildEventSignalCode();
+    code.insert(code.end(), signal_code.begin(), signal_code.end());
 
     // 3. Restore all registers
     X86CodeBuilder restore_builder;
@@ -52,7 +50,7 @@ std::vector<uint8_t> QuestHook::GenerateDetourPayload()
     code.insert(code.end(), restore_code.begin(), restore_code.end());
 
     // 4. Append stolen instructions
-    code.insert(code.end(), stolen_bytes().begin(), stolen_bytes().end());
+    AppendStolenInstructions(code);
 
     // 5. Jump back to original code
     X86CodeBuilder jmp_builder;
@@ -67,7 +65,7 @@ std::vector<uint8_t> QuestHook::GenerateDetourPayload()
 
 size_t QuestHook::ComputeStolenLength()
 {
-    return kDefaultStolenBytes;
+    return DecodeStolenLength(kDefaultStolenBytes);
 }
 
 bool QuestHook::PollQuestData()
@@ -77,27 +75,14 @@ bool QuestHook::PollQuestData()
         return false;
     }
 
-    uint8_t flag = 0;
-    if (!memory()->ReadMemory(backup_address() + kFlagOffset, &flag, sizeof(flag)))
+    const PollSnapshot* snapshot = AcquirePollSnapshot();
+    if (!snapshot || snapshot->flag == 0)
     {
         return false;
     }
 
-    if (flag == 0)
-    {
-        return false;
-    }
-
-    uint32_t quest_ptr_raw = 0;
-    if (!memory()->ReadMemory(backup_address(), &quest_ptr_raw, sizeof(quest_ptr_raw)))
-    {
-        uint8_t zero = 0;
-        memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
-        return false;
-    }
-
-    uint8_t zero = 0;
-    memory()->WriteMemory(backup_address() + kFlagOffset, &zero, sizeof(zero));
+    const uint32_t quest_ptr_raw = snapshot->Register(0);
+    ClearPollFlag();
 
     if (quest_ptr_raw == 0)
     {
@@ -107,24 +92,14 @@ bool QuestHook::PollQuestData()
     const uintptr_t quest_ptr = static_cast<uintptr_t>(quest_ptr_raw);
 
     QuestData data;
-    auto read_field = [&](uint32_t offset, std::string& out)
-    {
-        std::string value;
-        if (memory()->ReadString(quest_ptr + offset, value, kMaxStringLength))
-        {
-            out = std::move(value);
-        }
-        else
-        {
-            out.clear();
-        }
-    };
-
-    read_field(kSubquestNameOffset, data.subquest_name);
-    read_field(kQuestNameOffset, data.quest_name);
-    read_field(kDescriptionOffset, data.description);
-    read_field(kRewardsOffset, data.rewards);
-    read_field(kRepeatRewardsOffset, data.repeat_rewards);
+    std::array<StringRead, 5> reads{ {
+        { quest_ptr + kSubquestNameOffset, kMaxStringLength, &data.subquest_name },
+        { quest_ptr + kQuestNameOffset, kMaxStringLength, &data.quest_name },
+        { quest_ptr + kDescriptionOffset, kMaxStringLength, &data.description },
+        { quest_ptr + kRewardsOffset, kMaxStringLength, &data.rewards },
+        { quest_ptr + kRepeatRewardsOffset, kMaxStringLength, &data.repeat_rewards },
+    } };
+    ReadStrings(reads);
 
     last_data_ = std::move(data);
     return true;
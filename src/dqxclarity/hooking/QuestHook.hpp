@@ -40,9 +40,8 @@ protected:
     size_t ComputeStolenLength() override;
 
 private:
-    static constexpr size_t kFlagOffset = 32;
     static constexpr size_t kMaxStringLength = 2048;
-    static constexpr size_t kDefaultStolenBytes = 6;
+    static constexpr size_t kDefaultStolenBytes = 6; // When the hook site cannot be decoded
 
     // Offsets for quest data in backup buffer
     static constexpr uint32_t kSubquestNameOffset = 20;
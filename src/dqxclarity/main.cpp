@@ -1,9 +1,15 @@
 #include "memory/MemoryFactory.hpp"
 #include "memory/IProcessMemory.hpp"
+#include "memory/SnapshotProcessMemory.hpp"
+#include "pattern/MemoryRegion.hpp"
+#include "pattern/ScanStats.hpp"
+#include "pattern/SignatureResolver.hpp"
 #include "process/ProcessFinder.hpp"
+#include "signatures/SignatureCache.hpp"
+#include "signatures/Signatures.hpp"
 #include "hooking/DialogHook.hpp"
+#include "hooking/HookCreateInfo.hpp"
 #include "console/ConsoleFactory.hpp"
-#include "../processing/Diagnostics.hpp"
 #include <iostream>
 #include <string>
 #include <cstring>
@@ -21,6 +27,9 @@ void PrintUsage(const char* program_name)
     std::cout << "  --help               Show this help message\n";
     std::cout << "  --console            Print captured dialog to console (UTF-16)\n";
     std::cout << "  --verbose            Print detailed workflow info\n";
+    std::cout << "  --capture-snapshot <file>\n";
+    std::cout << "                       Dump the game's readable memory to a snapshot file and exit\n";
+    std::cout << "  --scan-report        Print the scan cost per signature on exit\n";
     std::cout << "\nBy default, dialog content is not printed. Use --console to enable output.\n";
 }
 
@@ -55,10 +64,10 @@ int main(int argc, char* argv[])
     std::cout << "DQXClarity C++ Dialog Extractor\n";
     std::cout << "================================\n\n";
 
-    processing::Diagnostics::InitializeLogger();
-
     bool opt_console = false;
     bool opt_verbose = false;
+    bool opt_scan_report = false;
+    std::string opt_snapshot_path;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -80,10 +89,16 @@ int main(int argc, char* argv[])
         {
             opt_verbose = true;
         }
+        else if (strcmp(argv[i], "--scan-report") == 0)
+        {
+            opt_scan_report = true;
+        }
+        else if (strcmp(argv[i], "--capture-snapshot") == 0 && i + 1 < argc)
+        {
+            opt_snapshot_path = argv[++i];
+        }
     }
 
-    processing::Diagnostics::SetVerbose(opt_verbose);
-
     // Set up signal handlers
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
@@ -116,11 +131,55 @@ int main(int argc, char* argv[])
     if (opt_verbose)
         std::cout << "  Attached successfully\n\n";
 
+    if (!opt_snapshot_path.empty())
+    {
+        std::cout << "Capturing memory snapshot to " << opt_snapshot_path << "...\n";
+        SnapshotCaptureStats stats;
+        if (!CaptureMemorySnapshot(*memory, MemoryRegionParser::ParseMaps(pids[0]), opt_snapshot_path, &stats))
+        {
+            std::cerr << "ERROR: Failed to write snapshot!\n";
+            return 1;
+        }
+        std::cout << "  " << stats.regions << " regions, " << stats.stored_pages << " pages stored, "
+                  << stats.zero_pages << " zero pages elided, " << stats.unreadable_pages << " unreadable ("
+                  << stats.file_bytes / (1024 * 1024) << " MB)\n";
+        return 0;
+    }
+
     // Create and install dialog hook
     if (opt_verbose)
         std::cout << "[3/3] Installing dialog hook...\n";
-    auto hook = std::make_unique<DialogHook>(memory);
-    hook->SetVerbose(opt_verbose);
+    HookCreateInfo hook_info;
+    hook_info.memory = memory.get();
+    hook_info.verbose = opt_verbose;
+
+    // Resolve the hook site the way Engine does, so its cost shows up in the scan report
+    ScanStatsRegistry scan_stats;
+    {
+        SignatureCache cache;
+        if (!cache.Load() && opt_verbose)
+            std::cout << "  Ignoring unreadable signature cache\n";
+        SignatureResolver resolver(memory.get());
+        hook_info.cached_regions = MemoryRegionParser::ParseMaps(pids[0]);
+        hook_info.resolved_signatures = std::make_shared<ResolvedSignatures>(
+            resolver.Resolve({ { "dialog_trigger", Signatures::GetDialogTrigger() } }, "DQXGame.exe",
+                             hook_info.cached_regions, cache));
+        scan_stats.RecordStartup("hook_signatures", resolver.LastCost());
+    }
+
+    hook_info.logger.error = [](const std::string& message)
+    {
+        std::cerr << "  " << message << "\n";
+    };
+    if (opt_verbose)
+    {
+        hook_info.logger.info = [](const std::string& message)
+        {
+            std::cout << "  " << message << "\n";
+        };
+        hook_info.logger.warn = hook_info.logger.info;
+    }
+    auto hook = std::make_unique<DialogHook>(hook_info);
     hook->SetConsoleOutput(opt_console);
     hook->SetConsole(ConsoleFactory::Create(opt_console));
     if (!hook->InstallHook())
@@ -145,7 +204,15 @@ int main(int argc, char* argv[])
     while (g_running)
     {
         // Poll for new dialog data every 100ms
-        if (hook->PollDialogData())
+        ScanCost tick;
+        bool captured = false;
+        {
+            ScanCostTimer timer(tick);
+            captured = hook->PollDialogData();
+        }
+        scan_stats.RecordTick("dialog_hook", tick);
+
+        if (captured)
         {
             dialog_count++;
             if (opt_verbose)
@@ -169,5 +236,8 @@ int main(int argc, char* argv[])
         std::cout << "Total dialogs captured: " << dialog_count << "\n";
     }
 
+    if (opt_scan_report)
+        std::cout << "\nScan cost per signature:\n" << FormatScanReport(scan_stats.Snapshot());
+
     return 0;
 }
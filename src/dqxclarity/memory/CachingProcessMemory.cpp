@@ -0,0 +1,324 @@
+#include "CachingProcessMemory.hpp"
+#include "RemoteString.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dqxclarity
+{
+namespace
+{
+
+constexpr uintptr_t PageOf(uintptr_t address)
+{
+    return address & ~static_cast<uintptr_t>(CachingProcessMemory::kPageSize - 1);
+}
+
+} // namespace
+
+CachingProcessMemory::CachingProcessMemory(std::unique_ptr<IProcessMemory> inner)
+    : inner_(std::move(inner))
+{
+}
+
+CachingProcessMemory::~CachingProcessMemory() = default;
+
+void CachingProcessMemory::BeginTick()
+{
+    Invalidate();
+    in_tick_.store(true, std::memory_order_release);
+}
+
+void CachingProcessMemory::EndTick() { in_tick_.store(false, std::memory_order_release); }
+
+void CachingProcessMemory::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+    ++stats_.invalidations;
+}
+
+PageCacheStats CachingProcessMemory::Stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void CachingProcessMemory::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = {};
+}
+
+bool CachingProcessMemory::IsCacheable(const ReadRequest& request)
+{
+    return !request.bypass_cache && request.address != 0 && request.buffer != nullptr && request.size != 0 &&
+           request.size <= kMaxCachedReadSize && request.address + request.size > request.address;
+}
+
+bool CachingProcessMemory::CopyFromCache(const ReadRequest& request)
+{
+    const uintptr_t end = request.address + request.size;
+    for (uintptr_t page = PageOf(request.address); page < end; page += kPageSize)
+    {
+        auto it = pages_.find(page);
+        if (it == pages_.end() || it->second->generation != generation_)
+            return false;
+    }
+
+    auto* out = static_cast<uint8_t*>(request.buffer);
+    for (uintptr_t address = request.address; address < end;)
+    {
+        const uintptr_t page = PageOf(address);
+        const size_t offset = address - page;
+        const size_t chunk = std::min<size_t>(kPageSize - offset, end - address);
+        std::memcpy(out, pages_[page]->bytes.data() + offset, chunk);
+        out += chunk;
+        address += chunk;
+    }
+    return true;
+}
+
+void CachingProcessMemory::StorePage(uintptr_t page_address, const uint8_t* bytes, uint64_t generation)
+{
+    if (generation != generation_)
+        return; // Written or invalidated while the page was being fetched
+
+    auto it = pages_.find(page_address);
+    if (it == pages_.end())
+    {
+        if (pages_.size() >= kMaxPages)
+        {
+            std::erase_if(pages_,
+                          [this](const auto& entry)
+                          {
+                              return entry.second->generation != generation_;
+                          });
+            if (pages_.size() >= kMaxPages)
+                return;
+        }
+        it = pages_.emplace(page_address, std::make_unique<Page>()).first;
+    }
+    it->second->generation = generation;
+    std::memcpy(it->second->bytes.data(), bytes, kPageSize);
+}
+
+bool CachingProcessMemory::ReadMemory(uintptr_t address, void* buffer, size_t size)
+{
+    if (!in_tick_.load(std::memory_order_acquire))
+        return inner_->ReadMemory(address, buffer, size);
+
+    ReadRequest request{ address, buffer, size };
+    ReadBatch({ &request, 1 });
+    return request.ok;
+}
+
+size_t CachingProcessMemory::ReadBatch(std::span<ReadRequest> requests)
+{
+    if (!in_tick_.load(std::memory_order_acquire))
+        return inner_->ReadBatch(requests);
+
+    // Serve what the cache already holds
+    std::vector<size_t> pending;
+    uint64_t generation = 0;
+    size_t completed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = generation_;
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            auto& request = requests[i];
+            request.ok = IsCacheable(request) && CopyFromCache(request);
+            if (request.ok)
+            {
+                ++stats_.hits;
+                ++completed;
+            }
+            else
+            {
+                pending.push_back(i);
+            }
+        }
+    }
+    if (pending.empty())
+        return completed;
+
+    // One inner batch: whole pages for cacheable misses, the requests themselves otherwise
+    std::vector<uintptr_t> page_addresses;
+    std::vector<ReadRequest> batch;
+    for (size_t i : pending)
+    {
+        const auto& request = requests[i];
+        if (!IsCacheable(request))
+        {
+            batch.push_back(request);
+            continue;
+        }
+        for (uintptr_t page = PageOf(request.address); page < request.address + request.size; page += kPageSize)
+        {
+            if (std::find(page_addresses.begin(), page_addresses.end(), page) == page_addresses.end())
+                page_addresses.push_back(page);
+        }
+    }
+    const size_t forwarded = batch.size();
+    std::vector<uint8_t> page_bytes(page_addresses.size() * kPageSize);
+    for (size_t p = 0; p < page_addresses.size(); ++p)
+        batch.push_back({ page_addresses[p], page_bytes.data() + p * kPageSize, kPageSize });
+
+    inner_->ReadBatch(batch);
+
+    std::vector<ReadRequest> fallback;
+    std::vector<size_t> fallback_index;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t p = 0; p < page_addresses.size(); ++p)
+        {
+            if (batch[forwarded + p].ok)
+            {
+                StorePage(page_addresses[p], page_bytes.data() + p * kPageSize, generation);
+                ++stats_.pages_fetched;
+            }
+        }
+
+        size_t next_forwarded = 0;
+        for (size_t i : pending)
+        {
+            auto& request = requests[i];
+            if (!IsCacheable(request))
+            {
+                request.ok = batch[next_forwarded++].ok;
+                ++stats_.bypassed;
+                completed += request.ok ? 1 : 0;
+                continue;
+            }
+
+            ++stats_.misses;
+            const uintptr_t end = request.address + request.size;
+            auto* out = static_cast<uint8_t*>(request.buffer);
+            request.ok = true;
+            for (uintptr_t address = request.address; address < end && request.ok;)
+            {
+                const uintptr_t page = PageOf(address);
+                const size_t p = std::find(page_addresses.begin(), page_addresses.end(), page) - page_addresses.begin();
+                const size_t offset = address - page;
+                const size_t chunk = std::min<size_t>(kPageSize - offset, end - address);
+                request.ok = batch[forwarded + p].ok;
+                if (request.ok)
+                    std::memcpy(out, page_bytes.data() + p * kPageSize + offset, chunk);
+                out += chunk;
+                address += chunk;
+            }
+            if (request.ok)
+            {
+                ++completed;
+            }
+            else
+            {
+                fallback.push_back(request);
+                fallback_index.push_back(i);
+            }
+        }
+    }
+
+    // A page that cannot be read whole; let the backend decide on the exact range
+    if (!fallback.empty())
+    {
+        inner_->ReadBatch(fallback);
+        for (size_t f = 0; f < fallback.size(); ++f)
+        {
+            requests[fallback_index[f]].ok = fallback[f].ok;
+            completed += fallback[f].ok ? 1 : 0;
+        }
+    }
+    return completed;
+}
+
+bool CachingProcessMemory::WriteMemory(uintptr_t address, const void* buffer, size_t size)
+{
+    const bool written = inner_->WriteMemory(address, buffer, size);
+    Invalidate();
+    return written;
+}
+
+bool CachingProcessMemory::AttachProcess(pid_t pid)
+{
+    Invalidate();
+    return inner_->AttachProcess(pid);
+}
+
+void CachingProcessMemory::DetachProcess()
+{
+    Invalidate();
+    inner_->DetachProcess();
+}
+
+bool CachingProcessMemory::IsProcessAttached() const { return inner_->IsProcessAttached(); }
+
+pid_t CachingProcessMemory::GetAttachedPid() const { return inner_->GetAttachedPid(); }
+
+uintptr_t CachingProcessMemory::AllocateMemory(size_t size, bool executable)
+{
+    return inner_->AllocateMemory(size, executable);
+}
+
+bool CachingProcessMemory::FreeMemory(uintptr_t address, size_t size)
+{
+    const bool freed = inner_->FreeMemory(address, size);
+    Invalidate();
+    return freed;
+}
+
+bool CachingProcessMemory::SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection)
+{
+    const bool changed = inner_->SetMemoryProtection(address, size, protection);
+    Invalidate();
+    return changed;
+}
+
+bool CachingProcessMemory::ReadString(uintptr_t address, std::string& output, size_t max_length)
+{
+    if (!in_tick_.load(std::memory_order_acquire))
+        return inner_->ReadString(address, output, max_length);
+
+    return ReadRemoteString(*this, address, output, max_length);
+}
+
+bool CachingProcessMemory::WriteString(uintptr_t address, const std::string& text)
+{
+    const bool written = inner_->WriteString(address, text);
+    Invalidate();
+    return written;
+}
+
+uintptr_t CachingProcessMemory::GetModuleBaseAddress(const std::string& module_name)
+{
+    return inner_->GetModuleBaseAddress(module_name);
+}
+
+int CachingProcessMemory::ReadInt32(uintptr_t address)
+{
+    int32_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uint64_t CachingProcessMemory::ReadInt64(uintptr_t address)
+{
+    uint64_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uintptr_t CachingProcessMemory::GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets)
+{
+    return inner_->GetPointerAddress(base, offsets);
+}
+
+void CachingProcessMemory::FlushInstructionCache(uintptr_t address, size_t size)
+{
+    inner_->FlushInstructionCache(address, size);
+}
+
+} // namespace dqxclarity
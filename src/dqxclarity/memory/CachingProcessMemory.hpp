@@ -0,0 +1,116 @@
+#pragma once
+
+#include "IProcessMemory.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Hit/miss counters of a CachingProcessMemory
+ */
+struct PageCacheStats
+{
+    uint64_t hits = 0;          // Reads served entirely from cached pages
+    uint64_t misses = 0;        // Cacheable reads that had to fetch pages
+    uint64_t bypassed = 0;      // Reads forwarded uncached (outside a tick, too large, or bypass_cache)
+    uint64_t pages_fetched = 0; // Pages copied from the process
+    uint64_t invalidations = 0; // Tick boundaries and writes
+
+    double HitRate() const { return hits + misses > 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+/**
+ * @brief IProcessMemory decorator caching remote 4 KB pages for one poller tick
+ *
+ * Between BeginTick() and EndTick(), small reads are served from whole pages
+ * copied once per tick, so scanners and hooks reading the same pages in one
+ * tick cost a single cross-process copy. Pages are tagged with a generation
+ * that BeginTick() and every write, free or protection change advance, which
+ * invalidates the cache in O(1). Outside a tick every call is forwarded.
+ *
+ * Reads marked ReadRequest::bypass_cache always go to the process. Thread-safe.
+ */
+class CachingProcessMemory : public IProcessMemory
+{
+public:
+    static constexpr size_t kPageSize = 4096;
+    // Larger reads (region scans) bypass the cache instead of evicting it
+    static constexpr size_t kMaxCachedReadSize = 4 * kPageSize;
+    static constexpr size_t kMaxPages = 1024;
+
+    explicit CachingProcessMemory(std::unique_ptr<IProcessMemory> inner);
+    ~CachingProcessMemory() override;
+
+    /**
+     * @brief Start caching; pages from earlier ticks are discarded
+     */
+    void BeginTick();
+
+    /**
+     * @brief Stop caching until the next BeginTick()
+     */
+    void EndTick();
+
+    void Invalidate();
+
+    PageCacheStats Stats() const;
+
+    void ResetStats();
+
+    /**
+     * @brief The wrapped backend, for readers that must never see cached data
+     */
+    IProcessMemory* Inner() const { return inner_.get(); }
+
+    bool AttachProcess(pid_t pid) override;
+    bool ReadMemory(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(std::span<ReadRequest> requests) override;
+    bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override;
+    void DetachProcess() override;
+    bool IsProcessAttached() const override;
+    pid_t GetAttachedPid() const override;
+    uintptr_t AllocateMemory(size_t size, bool executable = true) override;
+    bool FreeMemory(uintptr_t address, size_t size) override;
+    bool SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection) override;
+
+    bool ReadString(uintptr_t address, std::string& output, size_t max_length = 1024) override;
+    bool WriteString(uintptr_t address, const std::string& text) override;
+    uintptr_t GetModuleBaseAddress(const std::string& module_name = "") override;
+    int ReadInt32(uintptr_t address) override;
+    uint64_t ReadInt64(uintptr_t address) override;
+    uintptr_t GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets) override;
+    void FlushInstructionCache(uintptr_t address, size_t size) override;
+
+private:
+    struct Page
+    {
+        uint64_t generation = 0;
+        std::array<uint8_t, kPageSize> bytes;
+    };
+
+    static bool IsCacheable(const ReadRequest& request);
+
+    // Copies the request from pages of the current generation; caller holds mutex_
+    bool CopyFromCache(const ReadRequest& request);
+
+    // Stores a fetched page unless the generation moved on; caller holds mutex_
+    void StorePage(uintptr_t page_address, const uint8_t* bytes, uint64_t generation);
+
+    std::unique_ptr<IProcessMemory> inner_;
+    std::atomic<bool> in_tick_{ false };
+
+    mutable std::mutex mutex_;
+    uint64_t generation_ = 1;
+    std::unordered_map<uintptr_t, std::unique_ptr<Page>> pages_;
+    PageCacheStats stats_;
+};
+
+} // namespace dqxclarity
@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,18 @@ enum class MemoryProtectionFlags
     ReadWriteExecute = Read | Write | Execute
 };
 
+/**
+ * @brief One range of a batched read
+ */
+struct ReadRequest
+{
+    uintptr_t address = 0;
+    void* buffer = nullptr;
+    size_t size = 0;
+    bool ok = false;           // Set by ReadBatch: the whole range was read
+    bool bypass_cache = false; // Live data another thread writes in order (e.g. a detour's flag): never cache
+};
+
 class IProcessMemory
 {
 public:
@@ -29,6 +42,24 @@ public:
 
     virtual bool ReadMemory(uintptr_t address, void* buffer, size_t size) = 0;
 
+    /**
+     * @brief Read several unrelated ranges, reporting success per request
+     *
+     * A failed request does not affect the others. The default issues one
+     * ReadMemory per request; backends override it with a vectored read.
+     * @return Number of requests read completely
+     */
+    virtual size_t ReadBatch(std::span<ReadRequest> requests)
+    {
+        size_t completed = 0;
+        for (auto& request : requests)
+        {
+            request.ok = ReadMemory(request.address, request.buffer, request.size);
+            completed += request.ok ? 1 : 0;
+        }
+        return completed;
+    }
+
     virtual bool WriteMemory(uintptr_t address, const void* buffer, size_t size) = 0;
 
     virtual void DetachProcess() = 0;
@@ -49,6 +80,7 @@ public:
     virtual uintptr_t GetModuleBaseAddress(const std::string& module_name = "") = 0;
     virtual int ReadInt32(uintptr_t address) = 0;
     virtual uint64_t ReadInt64(uintptr_t address) = 0;
+    // address = base; for each offset, address = *address + offset (pointer-sized reads; see PointerChain)
     virtual uintptr_t GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets) = 0;
     virtual void FlushInstructionCache(uintptr_t address, size_t size) = 0;
 };
@@ -0,0 +1,244 @@
+#include "LinuxProcessMemory.hpp"
+
+#ifdef __linux__
+
+#include "RemoteString.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <string>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace dqxclarity
+{
+namespace
+{
+
+// Ranges per process_vm_readv call (the kernel allows up to UIO_MAXIOV = 1024); poll batches are far smaller
+constexpr size_t kMaxBatchIov = 64;
+
+bool IsSyscallRefused(int error) { return error == ENOSYS || error == EPERM || error == EACCES; }
+
+} // namespace
+
+size_t ProcessVmReadBatch(pid_t pid, std::span<ReadRequest> requests, IProcessMemory& fallback)
+{
+    // The kernel stops at the first range it cannot read, so on a short read that
+    // request is marked failed and the batch is resubmitted from the one after it.
+    iovec local[kMaxBatchIov];
+    iovec remote[kMaxBatchIov];
+    size_t index[kMaxBatchIov];
+    size_t completed = 0;
+    size_t next = 0;
+    while (next < requests.size())
+    {
+        size_t count = 0;
+        for (; next < requests.size() && count < kMaxBatchIov; ++next)
+        {
+            auto& request = requests[next];
+            request.ok = false;
+            if (request.address == 0 || request.buffer == nullptr || request.size == 0)
+                continue;
+            local[count] = iovec{ request.buffer, request.size };
+            remote[count] = iovec{ reinterpret_cast<void*>(request.address), request.size };
+            index[count++] = next;
+        }
+        if (count == 0)
+            break;
+
+        const ssize_t n = ::process_vm_readv(pid, local, count, remote, count, 0);
+        if (n < 0 && errno != EFAULT)
+        {
+            // Syscall unavailable or not permitted: read the rest one by one
+            size_t rest = 0;
+            for (size_t i = index[0]; i < requests.size(); ++i)
+            {
+                auto& request = requests[i];
+                request.ok = request.address != 0 && fallback.ReadMemory(request.address, request.buffer, request.size);
+                rest += request.ok ? 1 : 0;
+            }
+            return completed + rest;
+        }
+
+        size_t transferred = n > 0 ? static_cast<size_t>(n) : 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& request = requests[index[i]];
+            if (transferred < request.size)
+            {
+                next = index[i] + 1; // First unreadable range; resubmit what follows
+                break;
+            }
+            transferred -= request.size;
+            request.ok = true;
+            ++completed;
+        }
+    }
+    return completed;
+}
+
+LinuxProcessMemory::LinuxProcessMemory()
+    : m_process_id(0)
+    , m_mem_fd(-1)
+{
+}
+
+LinuxProcessMemory::~LinuxProcessMemory() { DetachProcess(); }
+
+bool LinuxProcessMemory::AttachProcess(pid_t pid)
+{
+    DetachProcess();
+
+    if (!m_libmem.AttachProcess(pid))
+        return false;
+
+    m_process_id = pid;
+    const std::string path = "/proc/" + std::to_string(pid) + "/mem";
+    m_mem_fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (m_mem_fd < 0)
+        m_mem_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return true;
+}
+
+bool LinuxProcessMemory::PreadMemory(uintptr_t address, void* buffer, size_t size)
+{
+    if (m_mem_fd < 0)
+        return false;
+
+    auto* out = static_cast<uint8_t*>(buffer);
+    size_t done = 0;
+    while (done < size)
+    {
+        const ssize_t n = ::pread(m_mem_fd, out + done, size - done, static_cast<off_t>(address + done));
+        if (n <= 0)
+        {
+            if (n < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool LinuxProcessMemory::ReadMemory(uintptr_t address, void* buffer, size_t size)
+{
+    if (m_process_id == 0 || address == 0 || buffer == nullptr || size == 0)
+        return false;
+
+    iovec local{ buffer, size };
+    iovec remote{ reinterpret_cast<void*>(address), size };
+    const ssize_t n = ::process_vm_readv(m_process_id, &local, 1, &remote, 1, 0);
+    if (n == static_cast<ssize_t>(size))
+        return true;
+    if (n < 0 && IsSyscallRefused(errno))
+        return PreadMemory(address, buffer, size);
+    return false;
+}
+
+size_t LinuxProcessMemory::ReadBatch(std::span<ReadRequest> requests)
+{
+    if (m_process_id == 0)
+    {
+        for (auto& request : requests)
+            request.ok = false;
+        return 0;
+    }
+    return ProcessVmReadBatch(m_process_id, requests, *this);
+}
+
+bool LinuxProcessMemory::WriteMemory(uintptr_t address, const void* buffer, size_t size)
+{
+    if (m_process_id == 0 || address == 0 || buffer == nullptr || size == 0)
+        return false;
+
+    if (m_mem_fd >= 0)
+    {
+        const ssize_t n = ::pwrite(m_mem_fd, buffer, size, static_cast<off_t>(address));
+        if (n == static_cast<ssize_t>(size))
+            return true;
+    }
+
+    // No descriptor (or opened read-only): only succeeds on writable pages
+    iovec local{ const_cast<void*>(buffer), size };
+    iovec remote{ reinterpret_cast<void*>(address), size };
+    return ::process_vm_writev(m_process_id, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+}
+
+void LinuxProcessMemory::DetachProcess()
+{
+    if (m_mem_fd >= 0)
+    {
+        ::close(m_mem_fd);
+        m_mem_fd = -1;
+    }
+    m_process_id = 0;
+    m_libmem.DetachProcess();
+}
+
+bool LinuxProcessMemory::IsProcessAttached() const { return m_process_id != 0 && m_libmem.IsProcessAttached(); }
+
+pid_t LinuxProcessMemory::GetAttachedPid() const { return m_libmem.GetAttachedPid(); }
+
+uintptr_t LinuxProcessMemory::AllocateMemory(size_t size, bool executable)
+{
+    return m_libmem.AllocateMemory(size, executable);
+}
+
+bool LinuxProcessMemory::FreeMemory(uintptr_t address, size_t size) { return m_libmem.FreeMemory(address, size); }
+
+bool LinuxProcessMemory::SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection)
+{
+    return m_libmem.SetMemoryProtection(address, size, protection);
+}
+
+bool LinuxProcessMemory::ReadString(uintptr_t address, std::string& output, size_t max_length)
+{
+    if (m_process_id == 0)
+        return false;
+
+    return ReadRemoteString(*this, address, output, max_length);
+}
+
+bool LinuxProcessMemory::WriteString(uintptr_t address, const std::string& text)
+{
+    return WriteMemory(address, text.c_str(), text.length() + 1);
+}
+
+uintptr_t LinuxProcessMemory::GetModuleBaseAddress(const std::string& module_name)
+{
+    return m_libmem.GetModuleBaseAddress(module_name);
+}
+
+int LinuxProcessMemory::ReadInt32(uintptr_t address)
+{
+    int32_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uint64_t LinuxProcessMemory::ReadInt64(uintptr_t address)
+{
+    uint64_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uintptr_t LinuxProcessMemory::GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets)
+{
+    return m_libmem.GetPointerAddress(base, offsets);
+}
+
+void LinuxProcessMemory::FlushInstructionCache(uintptr_t address, size_t size)
+{
+    // x86 keeps instruction fetch coherent with cross-process writes
+    (void)address;
+    (void)size;
+}
+
+} // namespace dqxclarity
+
+#endif // __linux__
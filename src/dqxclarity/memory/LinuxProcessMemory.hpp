@@ -0,0 +1,69 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "IProcessMemory.hpp"
+#include "ProcessMemory.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Native Linux backend: direct syscalls for reads and writes
+ *
+ * Reads go through process_vm_readv, falling back to pread on a
+ * /proc/<pid>/mem descriptor that stays open while attached (for kernels or
+ * sandboxes that refuse process_vm_readv). Writes use pwrite on that
+ * descriptor, which can patch read-only code pages, and process_vm_writev
+ * when it could not be opened. Allocation, protection changes, module
+ * lookup and pointer chains are delegated to the libmem backend.
+ */
+class LinuxProcessMemory : public IProcessMemory
+{
+public:
+    LinuxProcessMemory();
+    ~LinuxProcessMemory() override;
+
+    bool AttachProcess(pid_t pid) override;
+    bool ReadMemory(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(std::span<ReadRequest> requests) override;
+    bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override;
+    void DetachProcess() override;
+    bool IsProcessAttached() const override;
+    pid_t GetAttachedPid() const override;
+    uintptr_t AllocateMemory(size_t size, bool executable = true) override;
+    bool FreeMemory(uintptr_t address, size_t size) override;
+    bool SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection) override;
+
+    bool ReadString(uintptr_t address, std::string& output, size_t max_length = 1024) override;
+    bool WriteString(uintptr_t address, const std::string& text) override;
+    uintptr_t GetModuleBaseAddress(const std::string& module_name = "") override;
+    int ReadInt32(uintptr_t address) override;
+    uint64_t ReadInt64(uintptr_t address) override;
+    uintptr_t GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets) override;
+    void FlushInstructionCache(uintptr_t address, size_t size) override;
+
+private:
+    bool PreadMemory(uintptr_t address, void* buffer, size_t size);
+
+    ProcessMemory m_libmem;
+    pid_t m_process_id;
+    int m_mem_fd;
+};
+
+/**
+ * @brief ReadBatch over process_vm_readv, up to 64 ranges per call
+ *
+ * After a short read the first unreadable range is marked failed and the rest
+ * resubmitted. If the syscall itself is refused, the remaining requests go
+ * through fallback's one-by-one ReadMemory.
+ */
+size_t ProcessVmReadBatch(pid_t pid, std::span<ReadRequest> requests, IProcessMemory& fallback);
+
+} // namespace dqxclarity
+
+#endif // __linux__
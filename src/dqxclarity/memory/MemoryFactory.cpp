@@ -2,11 +2,21 @@
 #include "ProcessMemory.hpp"
 #include <memory>
 
+#ifdef __linux__
+#include "LinuxProcessMemory.hpp"
+#endif
+
 namespace dqxclarity
 {
 
-std::unique_ptr<IProcessMemory> MemoryFactory::CreatePlatformMemory()
+std::unique_ptr<IProcessMemory> MemoryFactory::CreatePlatformMemory(MemoryBackend backend)
 {
+#ifdef __linux__
+    if (backend == MemoryBackend::NativeLinux)
+        return std::make_unique<LinuxProcessMemory>();
+#else
+    (void)backend;
+#endif
     // Unified implementation using libmem works on all platforms
     return std::make_unique<ProcessMemory>();
 }
@@ -6,10 +6,16 @@
 namespace dqxclarity
 {
 
+enum class MemoryBackend
+{
+    Libmem,     // libmem on every platform
+    NativeLinux // LinuxProcessMemory; falls back to Libmem on other platforms
+};
+
 class MemoryFactory
 {
 public:
-    static std::unique_ptr<IProcessMemory> CreatePlatformMemory();
+    static std::unique_ptr<IProcessMemory> CreatePlatformMemory(MemoryBackend backend = MemoryBackend::Libmem);
 };
 
 } // namespace dqxclarity
\ No newline at end of file
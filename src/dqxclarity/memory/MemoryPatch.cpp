@@ -1,6 +1,7 @@
 #include "MemoryPatch.hpp"
 #include <algorithm>
 #include <cstdio>
+#include <numeric>
 
 namespace dqxclarity
 {
@@ -16,6 +17,52 @@ bool MemoryPatch::WriteWithProtect(IProcessMemory& mem, uintptr_t address, const
     return ok;
 }
 
+size_t MemoryPatch::WriteManyWithProtect(IProcessMemory& mem, std::span<PatchSite> sites,
+                                         MemoryProtectionFlags temp, MemoryProtectionFlags restore)
+{
+    constexpr uintptr_t kPageMask = 0xFFF;
+
+    std::vector<size_t> order(sites.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sites[a].address < sites[b].address; });
+
+    size_t written = 0;
+    size_t first = 0;
+    while (first < order.size())
+    {
+        // Extend the cluster while the next site starts on or before the page after the cluster's end
+        const uintptr_t begin = sites[order[first]].address & ~kPageMask;
+        uintptr_t end = begin;
+        size_t last = first;
+        for (; last < order.size(); ++last)
+        {
+            const PatchSite& site = sites[order[last]];
+            if (last != first && (site.address & ~kPageMask) > end)
+                break;
+            end = (std::max)(end, (site.address + site.bytes.size() + kPageMask) & ~kPageMask);
+        }
+
+        (void)mem.SetMemoryProtection(begin, end - begin, temp);
+        for (size_t i = first; i < last; ++i)
+        {
+            PatchSite& site = sites[order[i]];
+            site.written = mem.WriteMemory(site.address, site.bytes.data(), site.bytes.size());
+        }
+        (void)mem.SetMemoryProtection(begin, end - begin, restore);
+
+        for (size_t i = first; i < last; ++i)
+        {
+            const PatchSite& site = sites[order[i]];
+            if (!site.written)
+                continue;
+            mem.FlushInstructionCache(site.address, site.bytes.size());
+            ++written;
+        }
+        first = last;
+    }
+    return written;
+}
+
 std::vector<uint8_t> MemoryPatch::ReadBack(IProcessMemory& mem, uintptr_t address, size_t size)
 {
     std::vector<uint8_t> out(size);
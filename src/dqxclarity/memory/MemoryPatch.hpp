@@ -2,12 +2,23 @@
 
 #include "IProcessMemory.hpp"
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace dqxclarity
 {
 
+/**
+ * @brief One write of a batched patch
+ */
+struct PatchSite
+{
+    uintptr_t address = 0;
+    std::vector<uint8_t> bytes;
+    bool written = false; // Set by WriteManyWithProtect()
+};
+
 class MemoryPatch
 {
 public:
@@ -22,6 +33,18 @@ public:
         return WriteWithProtect(mem, address, bytes.data(), bytes.size(), temp, restore);
     }
 
+    /**
+     * @brief Write several sites with one protection flip per run of adjacent pages
+     *
+     * Sites whose pages touch share a single temp/restore pair, and all their
+     * writes happen back to back inside it; pages between unrelated sites keep
+     * their protection. The instruction cache is flushed per written site.
+     * @return Number of sites written
+     */
+    static size_t WriteManyWithProtect(IProcessMemory& mem, std::span<PatchSite> sites,
+                                       MemoryProtectionFlags temp = MemoryProtectionFlags::ReadWriteExecute,
+                                       MemoryProtectionFlags restore = MemoryProtectionFlags::ReadExecute);
+
     static std::vector<uint8_t> ReadBack(IProcessMemory& mem, uintptr_t address, size_t size);
 
     static std::string HexFirstN(const std::vector<uint8_t>& bytes, size_t n = 16);
@@ -0,0 +1,218 @@
+#include "PointerChainResolver.hpp"
+
+#include <unordered_map>
+
+namespace dqxclarity
+{
+namespace
+{
+
+// One ReadBatch worth of pointer reads, each distinct address read once
+class PointerBatch
+{
+public:
+    explicit PointerBatch(size_t pointer_size)
+        : pointer_size_(pointer_size)
+    {
+    }
+
+    size_t Add(uintptr_t address)
+    {
+        auto [it, inserted] = slots_.try_emplace(address, addresses_.size());
+        if (inserted)
+            addresses_.push_back(address);
+        return it->second;
+    }
+
+    bool Empty() const { return addresses_.empty(); }
+
+    void Read(IProcessMemory& memory)
+    {
+        values_.assign(addresses_.size(), 0);
+        requests_.resize(addresses_.size());
+        for (size_t i = 0; i < addresses_.size(); ++i)
+            requests_[i] = ReadRequest{ addresses_[i], &values_[i], pointer_size_ };
+        memory.ReadBatch(requests_);
+    }
+
+    bool Ok(size_t slot) const { return requests_[slot].ok; }
+    uintptr_t Value(size_t slot) const { return static_cast<uintptr_t>(values_[slot]); }
+
+    void Clear()
+    {
+        slots_.clear();
+        addresses_.clear();
+    }
+
+private:
+    size_t pointer_size_;
+    std::unordered_map<uintptr_t, size_t> slots_;
+    std::vector<uintptr_t> addresses_;
+    std::vector<uint64_t> values_; // Little-endian target: a 4-byte read fills the low half
+    std::vector<ReadRequest> requests_;
+};
+
+} // namespace
+
+PointerChainResolver::PointerChainResolver(size_t pointer_size)
+    : pointer_size_(pointer_size == sizeof(uint64_t) ? sizeof(uint64_t) : sizeof(uint32_t))
+{
+}
+
+uintptr_t PointerChainResolver::Resolve(IProcessMemory& memory, uintptr_t base, const std::vector<uintptr_t>& offsets)
+{
+    const PointerChain chain{ base, offsets };
+    uintptr_t result = 0;
+    ResolveMany(memory, { &chain, 1 }, { &result, 1 });
+    return result;
+}
+
+void PointerChainResolver::ResolveMany(IProcessMemory& memory, std::span<const PointerChain> chains,
+                                       std::span<uintptr_t> results)
+{
+    std::lock_guard lock(mutex_);
+    stats_.resolves += chains.size();
+
+    struct Cached
+    {
+        size_t chain;
+        const Link* link;
+        std::vector<size_t> slots; // One per level, in chain order
+    };
+    std::vector<Cached> cached;
+    std::vector<size_t> walk;
+    PointerBatch batch(pointer_size_);
+
+    for (size_t i = 0; i < chains.size(); ++i)
+    {
+        const auto& chain = chains[i];
+        results[i] = 0;
+        if (chain.base == 0)
+            continue;
+        if (chain.offsets.empty())
+        {
+            results[i] = chain.base;
+            continue;
+        }
+
+        auto it = cache_.find(Key{ chain.base, chain.offsets });
+        if (it == cache_.end())
+        {
+            walk.push_back(i);
+            continue;
+        }
+        const Link& link = it->second;
+        Cached entry{ i, &link, {} };
+        for (uintptr_t address : link.addresses)
+            entry.slots.push_back(batch.Add(address));
+        cached.push_back(std::move(entry));
+    }
+
+    if (!batch.Empty())
+    {
+        batch.Read(memory);
+        ++stats_.batches;
+    }
+    for (const auto& entry : cached)
+    {
+        const auto& chain = chains[entry.chain];
+        const Link& link = *entry.link;
+
+        // Every link but the last must still hold the pointer the walk followed
+        bool valid = true;
+        for (size_t level = 0; valid && level < entry.slots.size(); ++level)
+        {
+            const size_t slot = entry.slots[level];
+            valid = batch.Ok(slot) &&
+                    (level + 1 < entry.slots.size() ? batch.Value(slot) == link.values[level] : batch.Value(slot) != 0);
+        }
+
+        if (valid)
+        {
+            results[entry.chain] = batch.Value(entry.slots.back()) + chain.offsets.back();
+            ++stats_.cache_hits;
+        }
+        else
+        {
+            walk.push_back(entry.chain);
+        }
+    }
+
+    if (!walk.empty())
+        Walk(memory, chains, walk, results);
+}
+
+void PointerChainResolver::Walk(IProcessMemory& memory, std::span<const PointerChain> chains,
+                                std::span<const size_t> indices, std::span<uintptr_t> results)
+{
+    stats_.walks += indices.size();
+
+    std::vector<Link> links(indices.size());
+    std::vector<size_t> active;
+    for (size_t k = 0; k < indices.size(); ++k)
+    {
+        const auto& chain = chains[indices[k]];
+        cache_.erase(Key{ chain.base, chain.offsets });
+        links[k].addresses.push_back(chain.base);
+        active.push_back(k);
+    }
+
+    PointerBatch batch(pointer_size_);
+    std::vector<size_t> slots(indices.size());
+    for (size_t level = 0; !active.empty(); ++level)
+    {
+        batch.Clear();
+        for (size_t k : active)
+            slots[k] = batch.Add(links[k].addresses.back());
+        batch.Read(memory);
+        ++stats_.batches;
+
+        std::vector<size_t> next;
+        for (size_t k : active)
+        {
+            const auto& chain = chains[indices[k]];
+            if (!batch.Ok(slots[k]))
+                continue;
+
+            const uintptr_t value = batch.Value(slots[k]);
+            const uintptr_t address = value + chain.offsets[level];
+            if (level + 1 < chain.offsets.size())
+            {
+                links[k].values.push_back(value);
+                links[k].addresses.push_back(address);
+                next.push_back(k);
+                continue;
+            }
+
+            results[indices[k]] = address;
+            if (value != 0)
+            {
+                if (cache_.size() >= kMaxCachedChains)
+                    cache_.clear();
+                cache_.insert_or_assign(Key{ chain.base, chain.offsets }, std::move(links[k]));
+            }
+        }
+        active = std::move(next);
+    }
+}
+
+void PointerChainResolver::Invalidate()
+{
+    std::lock_guard lock(mutex_);
+    cache_.clear();
+}
+
+void PointerChainResolver::SetPointerSize(size_t pointer_size)
+{
+    std::lock_guard lock(mutex_);
+    pointer_size_ = pointer_size == sizeof(uint64_t) ? sizeof(uint64_t) : sizeof(uint32_t);
+    cache_.clear();
+}
+
+PointerChainStats PointerChainResolver::Stats() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+} // namespace dqxclarity
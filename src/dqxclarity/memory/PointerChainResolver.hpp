@@ -0,0 +1,94 @@
+#pragma once
+
+#include "IProcessMemory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief A multi-level pointer: read a pointer at base, add offsets[0], read again, ...
+ *
+ * address = base; for each offset, address = *address + offset. The base is
+ * dereferenced before the first offset is added and the final address is
+ * returned without being read. Every IProcessMemory::GetPointerAddress in the
+ * tree follows this contract; it is pinned by test_pointer_chain.cpp and is not
+ * claimed to match libmem::DeepPointer, which ProcessMemory called before.
+ *
+ * No in-tree scanner resolves static chains yet (player and quest data are
+ * located by pattern), so GetPointerAddress callers are external API users.
+ */
+struct PointerChain
+{
+    uintptr_t base = 0;
+    std::vector<uintptr_t> offsets;
+};
+
+struct PointerChainStats
+{
+    uint64_t resolves = 0;
+    uint64_t cache_hits = 0; // Resolved from one batched re-read of the cached links
+    uint64_t walks = 0;      // Full walks (first use, or validation mismatch)
+    uint64_t batches = 0;    // ReadBatch calls issued
+};
+
+/**
+ * @brief Resolves pointer chains, caching the intermediate links
+ *
+ * Object bases along a chain rarely move between polls, so after a full walk
+ * the resolver remembers where every link was read and what it held. A later
+ * resolve re-reads every link in one ReadBatch; if each link but the last
+ * still holds the pointer the walk followed and the final link is non-null,
+ * the result comes from the fresh final link. Otherwise the chain is walked
+ * again.
+ *
+ * ResolveMany() validates all cached chains in one ReadBatch and walks the
+ * rest level by level, one ReadBatch per level, reading each distinct address
+ * once so chains sharing a prefix share its reads.
+ */
+class PointerChainResolver
+{
+public:
+    explicit PointerChainResolver(size_t pointer_size = sizeof(uint32_t));
+
+    uintptr_t Resolve(IProcessMemory& memory, uintptr_t base, const std::vector<uintptr_t>& offsets);
+
+    /**
+     * @brief Resolve several chains; results[i] is 0 where chains[i] could not be followed
+     */
+    void ResolveMany(IProcessMemory& memory, std::span<const PointerChain> chains, std::span<uintptr_t> results);
+
+    void Invalidate();
+    void SetPointerSize(size_t pointer_size);
+
+    PointerChainStats Stats() const;
+
+    // Cached chains are dropped all at once beyond this many
+    static constexpr size_t kMaxCachedChains = 256;
+
+private:
+    struct Link
+    {
+        std::vector<uintptr_t> addresses; // Where each level's pointer was read; addresses[0] == base
+        std::vector<uintptr_t> values;    // Pointer read at each level but the last
+    };
+
+    using Key = std::pair<uintptr_t, std::vector<uintptr_t>>;
+
+    void Walk(IProcessMemory& memory, std::span<const PointerChain> chains, std::span<const size_t> indices,
+              std::span<uintptr_t> results);
+
+    mutable std::mutex mutex_;
+    std::map<Key, Link> cache_;
+    size_t pointer_size_;
+    PointerChainStats stats_;
+};
+
+} // namespace dqxclarity
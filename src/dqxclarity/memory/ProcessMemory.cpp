@@ -1,14 +1,21 @@
 #include "ProcessMemory.hpp"
+#include "PointerChainResolver.hpp"
+#include "RemoteString.hpp"
 #include <libmem/libmem.hpp>
 #include <algorithm>
 #include <memory>
 #include <cstring>
 #include <optional>
 
+#ifdef __linux__
+#include "LinuxProcessMemory.hpp"
+#endif
+
 namespace dqxclarity
 {
 namespace
 {
+
 template <typename E>
 constexpr auto to_underlying(E e) noexcept
 {
@@ -34,6 +41,7 @@ libmem::Prot convert_protection_flags(MemoryProtectionFlags flags)
 struct ProcessMemory::Impl
 {
     std::optional<libmem::Process> process;
+    PointerChainResolver pointer_chains;
 };
 
 ProcessMemory::ProcessMemory()
@@ -55,6 +63,7 @@ bool ProcessMemory::AttachProcess(pid_t pid)
 
     m_impl->process = *process;
     m_process_id = pid;
+    m_impl->pointer_chains.SetPointerSize(process->bits / 8);
     return true;
 }
 
@@ -68,6 +77,21 @@ bool ProcessMemory::ReadMemory(uintptr_t address, void* buffer, size_t size)
     return bytes_read == size;
 }
 
+size_t ProcessMemory::ReadBatch(std::span<ReadRequest> requests)
+{
+#ifdef __linux__
+    if (!m_impl->process)
+    {
+        for (auto& request : requests)
+            request.ok = false;
+        return 0;
+    }
+    return ProcessVmReadBatch(m_process_id, requests, *this);
+#else
+    return IProcessMemory::ReadBatch(requests);
+#endif
+}
+
 bool ProcessMemory::WriteMemory(uintptr_t address, const void* buffer, size_t size)
 {
     if (!m_impl->process || address == 0 || buffer == nullptr || size == 0)
@@ -84,6 +108,7 @@ void ProcessMemory::DetachProcess()
     {
         m_impl->process.reset();
         m_process_id = 0;
+        m_impl->pointer_chains.Invalidate();
     }
 }
 
@@ -127,13 +152,7 @@ bool ProcessMemory::ReadString(uintptr_t address, std::string& output, size_t ma
     if (!m_impl->process)
         return false;
 
-    std::vector<char> buffer(max_length + 1, '\0');
-    if (!ReadMemory(address, buffer.data(), max_length))
-        return false;
-
-    auto null_pos = std::find(buffer.begin(), buffer.end(), '\0');
-    output.assign(buffer.begin(), null_pos);
-    return true;
+    return ReadRemoteString(*this, address, output, max_length);
 }
 
 bool ProcessMemory::WriteString(uintptr_t address, const std::string& text)
@@ -186,10 +205,7 @@ uintptr_t ProcessMemory::GetPointerAddress(uintptr_t base, const std::vector<uin
     if (!m_impl->process || base == 0)
         return 0;
 
-    std::vector<libmem::Address> lm_offsets(offsets.begin(), offsets.end());
-    auto result = libmem::DeepPointer(&m_impl->process.value(), static_cast<libmem::Address>(base), lm_offsets);
-
-    return result.value_or(0);
+    return m_impl->pointer_chains.Resolve(*this, base, offsets);
 }
 
 void ProcessMemory::FlushInstructionCache(uintptr_t address, size_t size)
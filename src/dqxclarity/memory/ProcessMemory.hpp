@@ -16,6 +16,7 @@ public:
 
     bool AttachProcess(pid_t pid) override;
     bool ReadMemory(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(std::span<ReadRequest> requests) override;
     bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override;
     void DetachProcess() override;
     bool IsProcessAttached() const override;
@@ -0,0 +1,134 @@
+#include "RemoteString.hpp"
+#include "../pattern/SimdSupport.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <vector>
+
+namespace dqxclarity
+{
+namespace
+{
+
+constexpr size_t kPageSize = 4096;
+
+struct StringState
+{
+    size_t consumed = 0;
+    size_t chunk = kRemoteStringInitialChunk;
+    size_t scratch_offset = 0;
+    size_t request_size = 0;
+    bool done = false;
+};
+
+} // namespace
+
+size_t FindNul(const char* data, size_t size)
+{
+    size_t i = 0;
+#ifdef DQX_SEARCH_X86_SIMD
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= size; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+        if (bits != 0)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == '\0')
+            return i;
+    }
+    return size;
+}
+
+size_t ReadRemoteStrings(IProcessMemory& memory, std::span<RemoteStringRead> reads, std::span<ReadRequest> riders)
+{
+    // Chunks land in a per-thread scratch buffer that is reused across calls
+    thread_local std::vector<char> scratch;
+    thread_local std::vector<StringState> states;
+    thread_local std::vector<ReadRequest> requests;
+    thread_local std::vector<size_t> pending;
+
+    states.assign(reads.size(), StringState{});
+    for (size_t i = 0; i < reads.size(); ++i)
+    {
+        reads[i].ok = false;
+        reads[i].output->clear();
+        states[i].done = reads[i].address == 0 || reads[i].max_length == 0;
+    }
+
+    for (;;)
+    {
+        pending.clear();
+        requests.clear();
+        size_t scratch_size = 0;
+        for (size_t i = 0; i < reads.size(); ++i)
+        {
+            auto& state = states[i];
+            if (state.done)
+                continue;
+            const uintptr_t position = reads[i].address + state.consumed;
+            const size_t to_page_end = kPageSize - (position & (kPageSize - 1));
+            state.request_size = std::min({ state.chunk, reads[i].max_length - state.consumed, to_page_end });
+            state.scratch_offset = scratch_size;
+            scratch_size += state.request_size;
+            pending.push_back(i);
+        }
+        if (pending.empty() && riders.empty())
+            break;
+
+        if (scratch.size() < scratch_size)
+            scratch.resize(scratch_size);
+        for (size_t i : pending)
+        {
+            const uintptr_t position = reads[i].address + states[i].consumed;
+            requests.push_back({ position, scratch.data() + states[i].scratch_offset, states[i].request_size });
+        }
+
+        requests.insert(requests.end(), riders.begin(), riders.end());
+
+        memory.ReadBatch(requests);
+
+        for (size_t k = 0; k < riders.size(); ++k)
+            riders[k].ok = requests[pending.size() + k].ok;
+        riders = {};
+
+        for (size_t r = 0; r < pending.size(); ++r)
+        {
+            auto& read = reads[pending[r]];
+            auto& state = states[pending[r]];
+            if (!requests[r].ok)
+            {
+                // Before the first chunk the string does not exist; after it, it ends here
+                state.done = true;
+                continue;
+            }
+            if (state.consumed == 0)
+                read.ok = true;
+
+            const char* chunk = scratch.data() + state.scratch_offset;
+            const size_t length = FindNul(chunk, state.request_size);
+            read.output->append(chunk, length);
+            state.consumed += state.request_size;
+            state.chunk *= 2;
+            state.done = length < state.request_size || state.consumed >= read.max_length;
+        }
+    }
+
+    size_t completed = 0;
+    for (const auto& read : reads)
+        completed += read.ok ? 1 : 0;
+    return completed;
+}
+
+bool ReadRemoteString(IProcessMemory& memory, uintptr_t address, std::string& output, size_t max_length)
+{
+    RemoteStringRead read{ address, max_length, &output };
+    return ReadRemoteStrings(memory, { &read, 1 }) == 1;
+}
+
+} // namespace dqxclarity
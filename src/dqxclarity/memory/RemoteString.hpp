@@ -0,0 +1,55 @@
+#pragma once
+
+#include "IProcessMemory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief One NUL-terminated string for ReadRemoteStrings()
+ */
+struct RemoteStringRead
+{
+    uintptr_t address = 0;
+    size_t max_length = 0;
+    std::string* output = nullptr;
+    bool ok = false; // Set by ReadRemoteStrings: the first chunk was readable
+};
+
+// First chunk of an adaptive string read; doubled on every further round
+inline constexpr size_t kRemoteStringInitialChunk = 256;
+
+/**
+ * @brief Read NUL-terminated strings without copying max_length bytes each
+ *
+ * Each string is read in chunks starting at kRemoteStringInitialChunk and
+ * doubling until the terminator or max_length is reached. A chunk never
+ * crosses a 4 KB page boundary, so a short string at the end of a mapping
+ * is read even when the next page is unmapped. Each round issues one
+ * ReadBatch for all unfinished strings.
+ *
+ * The output is cut at the first NUL or at max_length. A string whose first
+ * chunk cannot be read fails (output cleared); a later unreadable chunk
+ * ends the string there.
+ * @param riders Unrelated reads carried in the first round's batch (ok set per request)
+ * @return Number of strings read
+ */
+size_t ReadRemoteStrings(IProcessMemory& memory, std::span<RemoteStringRead> reads,
+                         std::span<ReadRequest> riders = {});
+
+/**
+ * @brief Single-string ReadRemoteStrings()
+ */
+bool ReadRemoteString(IProcessMemory& memory, uintptr_t address, std::string& output, size_t max_length);
+
+/**
+ * @brief Offset of the first NUL byte in data, or size if there is none (SSE2 when available)
+ */
+size_t FindNul(const char* data, size_t size);
+
+} // namespace dqxclarity
@@ -0,0 +1,577 @@
+#include "SnapshotProcessMemory.hpp"
+#include "RemoteString.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dqxclarity
+{
+namespace
+{
+
+// Layout (little-endian): FileHeader, then per region a RegionRecord, its
+// pathname bytes and one uint32_t slot per page, then the page data starting
+// at data_offset. A slot is an index into the data section or one of the
+// sentinels below.
+constexpr char kMagic[8] = { 'D', 'Q', 'X', 'S', 'N', 'A', 'P', '1' };
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kZeroSlot = 0xFFFFFFFE;
+constexpr uint32_t kMissingSlot = 0xFFFFFFFF;
+constexpr size_t kPageSize = SnapshotProcessMemory::kPageSize;
+
+// Pages per ReadMemory while capturing; a failed chunk is retried page by page
+constexpr size_t kCaptureChunkPages = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t page_size;
+    uint64_t region_count;
+    uint64_t source_pid;
+    uint64_t data_offset;
+    uint64_t page_count;
+    uint32_t pointer_size;
+    uint32_t reserved;
+};
+static_assert(sizeof(FileHeader) == 56);
+
+struct RegionRecord
+{
+    uint64_t start;
+    uint64_t end;
+    uint32_t protection;
+    uint32_t path_length;
+};
+static_assert(sizeof(RegionRecord) == 24);
+
+size_t PageCount(uintptr_t start, uintptr_t end) { return (end - start + kPageSize - 1) / kPageSize; }
+
+bool IsZeroPage(const uint8_t* page)
+{
+    static const uint8_t zero[kPageSize] = {};
+    return std::memcmp(page, zero, kPageSize) == 0;
+}
+
+pid_t NextReplayPid()
+{
+    // Far above real pid ranges so registered maps never shadow a live process
+    static std::atomic<uint32_t> next{ 0x40000000 };
+    return static_cast<pid_t>(next.fetch_add(1));
+}
+
+bool EndsWithNoCase(const std::string& text, const std::string& suffix)
+{
+    if (suffix.size() > text.size())
+        return false;
+    return std::equal(suffix.begin(), suffix.end(), text.end() - suffix.size(),
+                      [](char a, char b)
+                      {
+                          return std::tolower(static_cast<unsigned char>(a)) ==
+                                 std::tolower(static_cast<unsigned char>(b));
+                      });
+}
+
+std::string BaseName(const std::string& path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+bool CaptureMemorySnapshot(IProcessMemory& memory, const std::vector<MemoryRegion>& regions, const std::string& path,
+                           SnapshotCaptureStats* stats, uint32_t pointer_size)
+{
+    std::vector<MemoryRegion> sorted;
+    sorted.reserve(regions.size());
+    for (const auto& region : regions)
+    {
+        if (region.end > region.start)
+            sorted.push_back(region);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const MemoryRegion& a, const MemoryRegion& b)
+              {
+                  return a.start < b.start;
+              });
+
+    uint64_t table_bytes = sizeof(FileHeader);
+    for (const auto& region : sorted)
+        table_bytes += sizeof(RegionRecord) + region.pathname.size() + PageCount(region.start, region.end) * 4;
+    const uint64_t data_offset = (table_bytes + kPageSize - 1) / kPageSize * kPageSize;
+
+    // Written beside the target and renamed into place, so a failed capture never leaves a truncated snapshot
+    const std::string temp_path = path + ".tmp";
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    auto discard = [&file, &temp_path]()
+    {
+        file.close();
+        std::error_code ec;
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    };
+
+    // Pages first, then the table once every slot is known
+    file.seekp(static_cast<std::streamoff>(data_offset));
+
+    SnapshotCaptureStats local;
+    local.regions = sorted.size();
+    std::vector<std::vector<uint32_t>> slots(sorted.size());
+    std::vector<uint8_t> chunk(kCaptureChunkPages * kPageSize);
+    uint32_t next_slot = 0;
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        const auto& region = sorted[i];
+        const size_t pages = PageCount(region.start, region.end);
+        slots[i].assign(pages, kMissingSlot);
+        if (!region.IsReadable())
+        {
+            local.unreadable_pages += pages;
+            continue;
+        }
+
+        for (size_t first = 0; first < pages; first += kCaptureChunkPages)
+        {
+            const size_t count = std::min(kCaptureChunkPages, pages - first);
+            const uintptr_t address = region.start + first * kPageSize;
+            const size_t bytes = std::min<size_t>(count * kPageSize, region.end - address);
+            const bool chunk_ok = memory.ReadMemory(address, chunk.data(), bytes);
+
+            for (size_t p = 0; p < count; ++p)
+            {
+                uint8_t* page = chunk.data() + p * kPageSize;
+                const size_t page_bytes = std::min(kPageSize, bytes - p * kPageSize);
+                if (!chunk_ok && !memory.ReadMemory(address + p * kPageSize, page, page_bytes))
+                {
+                    ++local.unreadable_pages;
+                    continue;
+                }
+                if (page_bytes < kPageSize)
+                    std::memset(page + page_bytes, 0, kPageSize - page_bytes);
+
+                if (IsZeroPage(page))
+                {
+                    slots[i][first + p] = kZeroSlot;
+                    ++local.zero_pages;
+                    continue;
+                }
+                if (next_slot == kZeroSlot)
+                    return discard();
+
+                file.write(reinterpret_cast<const char*>(page), kPageSize);
+                slots[i][first + p] = next_slot++;
+                ++local.stored_pages;
+            }
+        }
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.page_size = kPageSize;
+    header.region_count = sorted.size();
+    header.source_pid = static_cast<uint64_t>(memory.GetAttachedPid());
+    header.data_offset = data_offset;
+    header.page_count = next_slot;
+    header.pointer_size = pointer_size;
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        const auto& region = sorted[i];
+        RegionRecord record{ region.start, region.end, static_cast<uint32_t>(region.protection),
+                             static_cast<uint32_t>(region.pathname.size()) };
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(region.pathname.data(), static_cast<std::streamsize>(region.pathname.size()));
+        file.write(reinterpret_cast<const char*>(slots[i].data()),
+                   static_cast<std::streamsize>(slots[i].size() * sizeof(uint32_t)));
+    }
+    file.close();
+    if (!file)
+        return discard();
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec)
+        return discard();
+
+    local.file_bytes = data_offset + static_cast<uint64_t>(next_slot) * kPageSize;
+    if (stats)
+        *stats = local;
+    return true;
+}
+
+SnapshotProcessMemory::SnapshotProcessMemory()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_pages(nullptr)
+    , m_page_count(0)
+    , m_source_pid(0)
+    , m_replay_pid(0)
+    , m_pointer_size(4)
+    , m_attached(false)
+{
+}
+
+SnapshotProcessMemory::~SnapshotProcessMemory() { Close(); }
+
+bool SnapshotProcessMemory::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    m_buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size())))
+        return false;
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader)))
+    {
+        ::close(fd);
+        return false;
+    }
+    void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+        return false;
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    FileHeader header{};
+    if (m_size < sizeof(header))
+    {
+        Close();
+        return false;
+    }
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.page_size != kPageSize || header.data_offset > m_size ||
+        header.page_count > (m_size - header.data_offset) / kPageSize)
+    {
+        Close();
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    for (uint64_t i = 0; i < header.region_count; ++i)
+    {
+        RegionRecord record{};
+        if (m_size - offset < sizeof(record))
+        {
+            Close();
+            return false;
+        }
+        std::memcpy(&record, m_data + offset, sizeof(record));
+        offset += sizeof(record);
+
+        const size_t pages = record.end > record.start ? PageCount(record.start, record.end) : 0;
+        if (pages == 0 || m_size - offset < record.path_length ||
+            (m_size - offset - record.path_length) / sizeof(uint32_t) < pages)
+        {
+            Close();
+            return false;
+        }
+
+        MemoryRegion region;
+        region.start = static_cast<uintptr_t>(record.start);
+        region.end = static_cast<uintptr_t>(record.end);
+        region.protection = static_cast<int>(record.protection);
+        region.pathname.assign(reinterpret_cast<const char*>(m_data + offset), record.path_length);
+        offset += record.path_length;
+
+        std::vector<uint32_t> slots(pages);
+        std::memcpy(slots.data(), m_data + offset, pages * sizeof(uint32_t));
+        offset += pages * sizeof(uint32_t);
+        for (uint32_t slot : slots)
+        {
+            if (slot < kZeroSlot && slot >= header.page_count)
+            {
+                Close();
+                return false;
+            }
+        }
+
+        if (!m_regions.empty() && region.start < m_regions.back().end)
+        {
+            Close();
+            return false;
+        }
+        m_regions.push_back(std::move(region));
+        m_slots.push_back(std::move(slots));
+    }
+
+    m_pages = m_data + header.data_offset;
+    m_page_count = header.page_count;
+    m_source_pid = static_cast<pid_t>(header.source_pid);
+    m_pointer_size = header.pointer_size == 8 ? 8 : 4;
+    m_replay_pid = NextReplayPid();
+    MemoryRegionParser::RegisterMaps(m_replay_pid, m_regions);
+    m_attached = true;
+    return true;
+}
+
+void SnapshotProcessMemory::Close()
+{
+    if (m_replay_pid != 0)
+        MemoryRegionParser::UnregisterMaps(m_replay_pid);
+
+#ifndef _WIN32
+    if (m_data)
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_pages = nullptr;
+    m_page_count = 0;
+    m_regions.clear();
+    m_slots.clear();
+    m_source_pid = 0;
+    m_replay_pid = 0;
+    m_attached = false;
+
+    std::unique_lock lock(m_overlay_mutex);
+    m_overlay.clear();
+}
+
+size_t SnapshotProcessMemory::FindRegion(uintptr_t address) const
+{
+    auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+                               [](uintptr_t value, const MemoryRegion& region)
+                               {
+                                   return value < region.start;
+                               });
+    if (it == m_regions.begin() || address >= std::prev(it)->end)
+        return SIZE_MAX;
+    return static_cast<size_t>(std::prev(it) - m_regions.begin());
+}
+
+const uint8_t* SnapshotProcessMemory::StoredPage(size_t region, size_t page) const
+{
+    const uint32_t slot = m_slots[region][page];
+    if (slot >= kZeroSlot)
+        return nullptr;
+    return m_pages + static_cast<size_t>(slot) * kPageSize;
+}
+
+bool SnapshotProcessMemory::AttachProcess(pid_t pid)
+{
+    (void)pid;
+    m_attached = IsOpen();
+    return m_attached;
+}
+
+bool SnapshotProcessMemory::ReadMemory(uintptr_t address, void* buffer, size_t size)
+{
+    if (!m_attached || address == 0 || buffer == nullptr || size == 0)
+        return false;
+
+    auto* out = static_cast<uint8_t*>(buffer);
+    std::shared_lock lock(m_overlay_mutex);
+    size_t region = SIZE_MAX;
+    while (size > 0)
+    {
+        if (region == SIZE_MAX || address >= m_regions[region].end)
+        {
+            region = FindRegion(address);
+            if (region == SIZE_MAX)
+                return false;
+        }
+
+        const auto& info = m_regions[region];
+        const size_t page = (address - info.start) / kPageSize;
+        const size_t offset = (address - info.start) % kPageSize;
+        const size_t count = std::min({ size, kPageSize - offset, static_cast<size_t>(info.end - address) });
+
+        auto overlay = m_overlay.empty() ? m_overlay.end() : m_overlay.find(info.start + page * kPageSize);
+        if (overlay != m_overlay.end())
+            std::memcpy(out, overlay->second.data() + offset, count);
+        else if (m_slots[region][page] == kMissingSlot)
+            return false;
+        else if (const uint8_t* stored = StoredPage(region, page))
+            std::memcpy(out, stored + offset, count);
+        else
+            std::memset(out, 0, count);
+
+        out += count;
+        address += count;
+        size -= count;
+    }
+    return true;
+}
+
+bool SnapshotProcessMemory::WriteMemory(uintptr_t address, const void* buffer, size_t size)
+{
+    if (!m_attached || address == 0 || buffer == nullptr || size == 0)
+        return false;
+
+    // Every page must exist before anything is written
+    for (uintptr_t cursor = address; cursor < address + size;)
+    {
+        const size_t region = FindRegion(cursor);
+        if (region == SIZE_MAX || m_slots[region][(cursor - m_regions[region].start) / kPageSize] == kMissingSlot)
+            return false;
+        const uintptr_t page_start = cursor - (cursor - m_regions[region].start) % kPageSize;
+        cursor = std::min<uintptr_t>(page_start + kPageSize, m_regions[region].end);
+    }
+
+    const auto* in = static_cast<const uint8_t*>(buffer);
+    std::unique_lock lock(m_overlay_mutex);
+    while (size > 0)
+    {
+        const size_t region = FindRegion(address);
+        const auto& info = m_regions[region];
+        const size_t page = (address - info.start) / kPageSize;
+        const size_t offset = (address - info.start) % kPageSize;
+        const size_t count = std::min({ size, kPageSize - offset, static_cast<size_t>(info.end - address) });
+
+        auto [it, inserted] = m_overlay.try_emplace(info.start + page * kPageSize);
+        if (inserted)
+        {
+            if (const uint8_t* stored = StoredPage(region, page))
+                std::memcpy(it->second.data(), stored, kPageSize);
+            else
+                it->second.fill(0);
+        }
+        std::memcpy(it->second.data() + offset, in, count);
+
+        in += count;
+        address += count;
+        size -= count;
+    }
+    return true;
+}
+
+void SnapshotProcessMemory::DetachProcess() { m_attached = false; }
+
+bool SnapshotProcessMemory::IsProcessAttached() const { return m_attached; }
+
+pid_t SnapshotProcessMemory::GetAttachedPid() const { return m_attached ? m_replay_pid : 0; }
+
+uintptr_t SnapshotProcessMemory::AllocateMemory(size_t size, bool executable)
+{
+    (void)size;
+    (void)executable;
+    return 0;
+}
+
+bool SnapshotProcessMemory::FreeMemory(uintptr_t address, size_t size)
+{
+    (void)address;
+    (void)size;
+    return false;
+}
+
+bool SnapshotProcessMemory::SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection)
+{
+    (void)address;
+    (void)size;
+    (void)protection;
+    return false;
+}
+
+bool SnapshotProcessMemory::ReadString(uintptr_t address, std::string& output, size_t max_length)
+{
+    if (!m_attached)
+        return false;
+
+    return ReadRemoteString(*this, address, output, max_length);
+}
+
+bool SnapshotProcessMemory::WriteString(uintptr_t address, const std::string& text)
+{
+    return WriteMemory(address, text.c_str(), text.length() + 1);
+}
+
+uintptr_t SnapshotProcessMemory::GetModuleBaseAddress(const std::string& module_name)
+{
+    if (!m_attached)
+        return 0;
+
+    // Without a name, the main executable (the first .exe mapping, else the first file mapping)
+    const MemoryRegion* fallback = nullptr;
+    for (const auto& region : m_regions)
+    {
+        if (region.pathname.empty())
+            continue;
+        if (module_name.empty())
+        {
+            if (EndsWithNoCase(region.pathname, ".exe"))
+                return region.start;
+            if (!fallback)
+                fallback = &region;
+        }
+        else if (BaseName(region.pathname).size() == module_name.size() &&
+                 EndsWithNoCase(region.pathname, module_name))
+        {
+            return region.start;
+        }
+    }
+    return fallback ? fallback->start : 0;
+}
+
+int SnapshotProcessMemory::ReadInt32(uintptr_t address)
+{
+    int32_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uint64_t SnapshotProcessMemory::ReadInt64(uintptr_t address)
+{
+    uint64_t value = 0;
+    if (!ReadMemory(address, &value, sizeof(value)))
+        return 0;
+    return value;
+}
+
+uintptr_t SnapshotProcessMemory::GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets)
+{
+    if (!m_attached || base == 0)
+        return 0;
+
+    uintptr_t address = base;
+    for (uintptr_t offset : offsets)
+    {
+        uint64_t next = 0;
+        if (!ReadMemory(address, &next, m_pointer_size))
+            return 0;
+        address = static_cast<uintptr_t>(next) + offset;
+    }
+    return address;
+}
+
+void SnapshotProcessMemory::FlushInstructionCache(uintptr_t address, size_t size)
+{
+    (void)address;
+    (void)size;
+}
+
+} // namespace dqxclarity
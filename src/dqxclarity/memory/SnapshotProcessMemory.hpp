@@ -0,0 +1,120 @@
+#pragma once
+
+#include "IProcessMemory.hpp"
+#include "../pattern/MemoryRegion.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Counters reported by CaptureMemorySnapshot()
+ */
+struct SnapshotCaptureStats
+{
+    size_t regions = 0;
+    size_t stored_pages = 0;
+    size_t zero_pages = 0;       // All-zero pages, recorded in the page table only
+    size_t unreadable_pages = 0; // Not readable at capture time; reads of them fail on replay
+    uint64_t file_bytes = 0;
+};
+
+/**
+ * @brief Dump the given regions of an attached process into a snapshot file
+ *
+ * The file holds a header, the region table (range, protection, pathname and
+ * one slot per 4 KB page) and a page-aligned data section. All-zero pages are
+ * not stored, which shrinks typical heap-heavy dumps considerably while the
+ * data section stays uncompressed so replay can memory-map it. The file is
+ * written to path + ".tmp" and renamed on success, so a failed capture leaves
+ * any existing snapshot at path untouched.
+ * @param pointer_size Width of a pointer in the target (4 for DQXGame.exe), used by GetPointerAddress on replay
+ */
+bool CaptureMemorySnapshot(IProcessMemory& memory, const std::vector<MemoryRegion>& regions, const std::string& path,
+                           SnapshotCaptureStats* stats = nullptr, uint32_t pointer_size = 4);
+
+/**
+ * @brief IProcessMemory that replays a snapshot written by CaptureMemorySnapshot()
+ *
+ * The file is memory-mapped read-only (read whole on Windows). While open,
+ * its region table is registered with MemoryRegionParser under a synthetic
+ * pid, so PatternScanner and RegionMap see the captured layout through
+ * GetAttachedPid(). Reads may span adjacent regions; reads touching an
+ * unmapped or unreadable page fail. Writes go to a private overlay and never
+ * reach the file. Allocation and protection changes are not supported.
+ */
+class SnapshotProcessMemory : public IProcessMemory
+{
+public:
+    static constexpr size_t kPageSize = 4096;
+
+    SnapshotProcessMemory();
+    ~SnapshotProcessMemory() override;
+
+    SnapshotProcessMemory(const SnapshotProcessMemory&) = delete;
+    SnapshotProcessMemory& operator=(const SnapshotProcessMemory&) = delete;
+
+    /**
+     * @brief Map a snapshot file and attach to it
+     */
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief pid of the process the snapshot was captured from
+     */
+    pid_t GetSourcePid() const { return m_source_pid; }
+    const std::vector<MemoryRegion>& Regions() const { return m_regions; }
+
+    // Attach succeeds for any pid while a snapshot is open
+    bool AttachProcess(pid_t pid) override;
+    bool ReadMemory(uintptr_t address, void* buffer, size_t size) override;
+    bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override;
+    void DetachProcess() override;
+    bool IsProcessAttached() const override;
+    pid_t GetAttachedPid() const override;
+    uintptr_t AllocateMemory(size_t size, bool executable = true) override;
+    bool FreeMemory(uintptr_t address, size_t size) override;
+    bool SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection) override;
+
+    bool ReadString(uintptr_t address, std::string& output, size_t max_length = 1024) override;
+    bool WriteString(uintptr_t address, const std::string& text) override;
+    uintptr_t GetModuleBaseAddress(const std::string& module_name = "") override;
+    int ReadInt32(uintptr_t address) override;
+    uint64_t ReadInt64(uintptr_t address) override;
+    uintptr_t GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets) override;
+    void FlushInstructionCache(uintptr_t address, size_t size) override;
+
+private:
+    using Page = std::array<uint8_t, kPageSize>;
+
+    size_t FindRegion(uintptr_t address) const;
+    const uint8_t* StoredPage(size_t region, size_t page) const;
+
+    const uint8_t* m_data;
+    size_t m_size;
+    std::vector<uint8_t> m_buffer; // File contents where mmap is unavailable
+    const uint8_t* m_pages;
+    uint64_t m_page_count;
+
+    std::vector<MemoryRegion> m_regions;        // sorted by start
+    std::vector<std::vector<uint32_t>> m_slots; // per region, one slot per page
+
+    pid_t m_source_pid;
+    pid_t m_replay_pid;
+    uint32_t m_pointer_size;
+    bool m_attached;
+
+    mutable std::shared_mutex m_overlay_mutex;
+    std::unordered_map<uintptr_t, Page> m_overlay; // keyed by page address
+};
+
+} // namespace dqxclarity
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../api/scan_stats.hpp"
+#include "../memory/IProcessMemory.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Reusable scan buffer that counts the bytes it had to allocate
+ *
+ * Owned by a scanner and shared by all of its region reads so steady-state
+ * scanning does not allocate at all.
+ */
+class ScratchBuffer
+{
+public:
+    /**
+     * @brief Get a buffer of at least size bytes, growing only when needed
+     */
+    uint8_t* Get(size_t size)
+    {
+        if (size > buffer_.size())
+        {
+            std::vector<uint8_t>(size).swap(buffer_);
+            bytes_allocated_ += size;
+        }
+        return buffer_.data();
+    }
+
+    size_t Capacity() const { return buffer_.size(); }
+
+    /**
+     * @brief Total bytes allocated by this buffer since construction
+     */
+    uint64_t BytesAllocated() const { return bytes_allocated_; }
+
+private:
+    std::vector<uint8_t> buffer_;
+    uint64_t bytes_allocated_ = 0;
+};
+
+/**
+ * @brief Streams a remote address range through a fixed-size window
+ *
+ * Consecutive windows overlap by `overlap` bytes (pattern.Size() - 1 for pattern
+ * scans) so no match is split across two reads. Peak memory is bounded by
+ * chunk_size + overlap regardless of the region size.
+ *
+ * With a ScanCost attached, every walk counts as one visited range and every
+ * window read to read_calls (bytes_read counts the successful ones only).
+ */
+class ChunkedRegionReader
+{
+public:
+    static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+
+    ChunkedRegionReader(IProcessMemory* memory, ScratchBuffer& scratch, size_t chunk_size = kDefaultChunkSize,
+                        ScanCost* cost = nullptr)
+        : memory_(memory)
+        , scratch_(scratch)
+        , chunk_size_(chunk_size > 0 ? chunk_size : kDefaultChunkSize)
+        , cost_(cost)
+    {
+    }
+
+    ChunkedRegionReader(IProcessMemory* memory, ScratchBuffer& scratch, ScanCost* cost)
+        : ChunkedRegionReader(memory, scratch, kDefaultChunkSize, cost)
+    {
+    }
+
+    /**
+     * @brief Visit [start, start + size) window by window
+     *
+     * The callback receives (window_address, data, length, owned) and returns false to
+     * stop. Match start offsets below `owned` belong to this window; later ones are
+     * repeated at the beginning of the next window. Windows that fail to read are skipped.
+     *
+     * @return false if the callback stopped the walk, true otherwise
+     */
+    template <typename Fn>
+    bool ForEachChunk(uintptr_t start, size_t size, size_t overlap, Fn&& fn)
+    {
+        uint8_t* data = scratch_.Get((std::min)(size, chunk_size_ + overlap));
+        if (cost_)
+            ++cost_->regions_visited;
+        bool previous_read = false;
+        for (size_t offset = 0; offset < size; offset += chunk_size_)
+        {
+            const size_t remaining = size - offset;
+            const size_t length = (std::min)(remaining, chunk_size_ + overlap);
+            if (length <= overlap && previous_read)
+                break; // tail already covered by the previous window
+
+            previous_read = memory_->ReadMemory(start + offset, data, length);
+            if (cost_)
+            {
+                ++cost_->read_calls;
+                cost_->bytes_read += previous_read ? length : 0;
+            }
+            if (!previous_read)
+                continue;
+
+            const size_t owned = length == remaining ? length : chunk_size_;
+            if (!fn(start + offset, static_cast<const uint8_t*>(data), length, owned))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    IProcessMemory* memory_;
+    ScratchBuffer& scratch_;
+    size_t chunk_size_;
+    ScanCost* cost_;
+};
+
+} // namespace dqxclarity
@@ -0,0 +1,90 @@
+#include "CompiledPattern.hpp"
+#include "Pattern.hpp"
+#include "PatternSearch.hpp"
+
+#include <algorithm>
+
+namespace dqxclarity
+{
+
+size_t CompiledPattern::BuildShiftTable(const std::vector<uint8_t>& bytes, const std::vector<uint8_t>& mask,
+                                        size_t offset, size_t length, std::array<uint32_t, 256>& table)
+{
+    // The byte under the window end is compared against every earlier window position;
+    // a wildcard at position j matches it, so shifts past length - 1 - j are unsafe.
+    size_t cap = length;
+    for (size_t j = 0; j + 1 < length; ++j)
+    {
+        if (!mask[offset + j])
+            cap = length - 1 - j;
+    }
+    cap = (std::max)(cap, size_t{ 1 });
+
+    table.fill(static_cast<uint32_t>(cap));
+    for (size_t j = 0; j + 1 < length; ++j)
+    {
+        if (!mask[offset + j])
+            continue;
+        auto& shift = table[bytes[offset + j]];
+        shift = (std::min)(shift, static_cast<uint32_t>(length - 1 - j));
+    }
+    return cap;
+}
+
+CompiledPattern CompiledPattern::FromPattern(const Pattern& pattern)
+{
+    CompiledPattern compiled;
+    if (!pattern.IsValid())
+        return compiled;
+
+    const size_t size = pattern.Size();
+    compiled.bytes.resize(size);
+    compiled.mask.resize(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        compiled.mask[i] = pattern.mask[i] ? 0xFF : 0x00;
+        compiled.bytes[i] = pattern.mask[i] ? pattern.bytes[i] : 0x00;
+    }
+    compiled.anchor = PatternSearch::SelectAnchor(pattern);
+
+    for (size_t i = 0; i < size;)
+    {
+        if (!pattern.mask[i])
+        {
+            ++i;
+            continue;
+        }
+        size_t end = i;
+        while (end < size && pattern.mask[end])
+            ++end;
+        if (end - i > compiled.fixed_run_length)
+        {
+            compiled.fixed_run_offset = i;
+            compiled.fixed_run_length = end - i;
+        }
+        i = end;
+    }
+    if (compiled.fixed_run_length == 0)
+        return compiled;
+
+    // Window over the whole pattern (capped by its last wildcard) vs. the longest fixed run
+    std::array<uint32_t, 256> whole{};
+    const size_t whole_shift = BuildShiftTable(compiled.bytes, compiled.mask, 0, size, whole);
+    if (whole_shift > compiled.fixed_run_length)
+    {
+        compiled.skip_offset = 0;
+        compiled.skip_length = size;
+        compiled.max_shift = whole_shift;
+        compiled.shift_table = whole;
+    }
+    else
+    {
+        compiled.skip_offset = compiled.fixed_run_offset;
+        compiled.skip_length = compiled.fixed_run_length;
+        compiled.max_shift = BuildShiftTable(compiled.bytes, compiled.mask, compiled.skip_offset,
+                                             compiled.skip_length, compiled.shift_table);
+    }
+    return compiled;
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dqxclarity
+{
+
+struct Pattern;
+
+/**
+ * @brief Fixed byte (or adjacent fixed byte pair) used to filter SIMD candidates
+ */
+struct PatternAnchor
+{
+    size_t offset = 0;  ///< Offset of the anchor byte inside the pattern
+    uint8_t first = 0;  ///< Byte at offset
+    uint8_t second = 0; ///< Byte at offset + 1 (only meaningful when pair is true)
+    bool pair = false;  ///< True if two adjacent fixed bytes are matched
+    bool valid = false; ///< False if the pattern has no fixed byte at all
+};
+
+// Rough frequency classes of bytes in x86 code and the data around it (0 = rare, 3 = everywhere).
+// Only the ordering matters: the anchor should land on a byte that produces few candidates.
+constexpr std::array<uint8_t, 256> BuildByteCommonness()
+{
+    std::array<uint8_t, 256> table{};
+    constexpr uint8_t frequent[] = { 0x02, 0x0D, 0x14, 0x18, 0x1C, 0x20, 0x33, 0x3B, 0x40, 0x46, 0x4E, 0x50, 0x51,
+                                     0x52, 0x53, 0x56, 0x57, 0x5E, 0x5F, 0x68, 0x6A, 0x80, 0xC0, 0xC4, 0xC7, 0xE9,
+                                     0xEB, 0xF8, 0xFC };
+    constexpr uint8_t common[] = { 0x01, 0x04, 0x08, 0x0C, 0x0F, 0x10, 0x24, 0x45, 0x48, 0x4D, 0x55, 0x5D,
+                                   0x74, 0x75, 0x83, 0x84, 0x85, 0x89, 0x8B, 0x8D, 0xC3, 0xE5, 0xE8, 0xEC };
+    constexpr uint8_t everywhere[] = { 0x00, 0x90, 0xCC, 0xFF };
+    for (uint8_t b : frequent)
+        table[b] = 1;
+    for (uint8_t b : common)
+        table[b] = 2;
+    for (uint8_t b : everywhere)
+        table[b] = 3;
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> kByteCommonness = BuildByteCommonness();
+
+/**
+ * @brief Select the least common fixed byte pair (or single byte) of a pattern
+ *
+ * Shared by CompiledPattern (runtime) and StaticSignature (compile time), so both
+ * anchor on the same bytes. Works on any indexable bytes/mask pair.
+ */
+template <typename Bytes, typename Mask>
+constexpr PatternAnchor SelectPatternAnchor(const Bytes& bytes, const Mask& mask, size_t size)
+{
+    PatternAnchor best;
+
+    // Prefer an adjacent fixed pair: two compares per block cut candidates far more than one.
+    int best_score = 0;
+    for (size_t i = 0; i + 1 < size; ++i)
+    {
+        if (!mask[i] || !mask[i + 1])
+            continue;
+        int score = kByteCommonness[bytes[i]] + kByteCommonness[bytes[i + 1]];
+        // Identical pair bytes (00 00, CC CC) are padding runs in practice
+        if (bytes[i] == bytes[i + 1])
+            score += 2;
+        if (!best.valid || score < best_score)
+        {
+            best = PatternAnchor{ i, static_cast<uint8_t>(bytes[i]), static_cast<uint8_t>(bytes[i + 1]), true, true };
+            best_score = score;
+        }
+    }
+    if (best.valid)
+        return best;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (!mask[i])
+            continue;
+        int score = kByteCommonness[bytes[i]];
+        if (!best.valid || score < best_score)
+        {
+            best = PatternAnchor{ i, static_cast<uint8_t>(bytes[i]), 0, false, true };
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Search-ready form of a Pattern, built once per signature
+ *
+ * Holds everything the search kernel would otherwise derive on every call:
+ * the packed byte/mask pair used for verification, the SIMD anchor, the longest
+ * run of fixed bytes and a Horspool shift table.
+ *
+ * The shift table covers a "skip window" of the pattern. Wildcards inside the
+ * window match any byte, so no shift may move past the last wildcard; the table
+ * is capped accordingly and stays correct for any window. In practice the
+ * window is the longest fixed run, which makes the cap irrelevant and lets
+ * patterns with long literal stretches (quest_text, corner_text) skip through
+ * memory instead of visiting every byte.
+ *
+ * On x86 the SIMD anchor scan still wins at every window length measured
+ * (7-48 bytes, see bench_pattern_search.cpp): Horspool does fewer compares but
+ * each shift depends on the previous load. The skip path is therefore only
+ * picked automatically on builds without the SIMD kernel.
+ */
+struct CompiledPattern
+{
+    /// Smallest maximum shift at which non-SIMD builds switch to the skip path
+    static constexpr size_t kMinSkipShift = 12;
+
+    std::vector<uint8_t> bytes; ///< Pattern bytes with wildcard positions zeroed
+    std::vector<uint8_t> mask;  ///< 0xFF for fixed bytes, 0x00 for wildcards
+    PatternAnchor anchor;
+
+    size_t fixed_run_offset = 0; ///< Start of the longest run of fixed bytes
+    size_t fixed_run_length = 0; ///< Length of that run (0 for all-wildcard patterns)
+
+    size_t skip_offset = 0;                  ///< Start of the window the shift table was built for
+    size_t skip_length = 0;                  ///< Window length
+    size_t max_shift = 0;                    ///< Largest shift the table can produce
+    std::array<uint32_t, 256> shift_table{}; ///< Horspool shift keyed by the byte under the window end
+
+    /// First-match search generated for this exact byte/mask sequence (built-in signatures only, see
+    /// StaticSignature); PatternSearch::FindFirst prefers it under Strategy::Auto
+    size_t (*specialized_find_first)(const uint8_t* buffer, size_t buffer_size) = nullptr;
+
+    static CompiledPattern FromPattern(const Pattern& pattern);
+
+    size_t Size() const { return bytes.size(); }
+
+    /**
+     * @brief True if the shift table is long enough to pay off without SIMD
+     */
+    bool PrefersSkipSearch() const { return max_shift >= kMinSkipShift; }
+
+    /**
+     * @brief Build a shift table for bytes/mask[offset, offset + length)
+     *
+     * Shifts never exceed the distance from the window's last wildcard to its
+     * end, since a wildcard can line up with any byte.
+     * @return Largest shift in the table
+     */
+    static size_t BuildShiftTable(const std::vector<uint8_t>& bytes, const std::vector<uint8_t>& mask,
+                                  size_t offset, size_t length, std::array<uint32_t, 256>& table);
+};
+
+} // namespace dqxclarity
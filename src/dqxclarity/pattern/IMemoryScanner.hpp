@@ -16,6 +16,22 @@ public:
 
     virtual std::optional<uintptr_t> ScanProcess(const Pattern& pattern, bool require_executable) = 0;
     virtual std::vector<uintptr_t> ScanProcessAll(const Pattern& pattern, bool require_executable) = 0;
+
+    /**
+     * @brief First match of each pattern; results[i] belongs to patterns[i]
+     *
+     * Implementations should read memory once for all patterns. The default
+     * falls back to one ScanProcess per pattern.
+     */
+    virtual std::vector<std::optional<uintptr_t>> ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                                  bool require_executable)
+    {
+        std::vector<std::optional<uintptr_t>> results;
+        results.reserve(patterns.size());
+        for (const Pattern* pattern : patterns)
+            results.push_back(pattern ? ScanProcess(*pattern, require_executable) : std::nullopt);
+        return results;
+    }
 };
 
 class ProcessMemoryScanner : public IMemoryScanner
@@ -25,6 +41,8 @@ public:
 
     std::optional<uintptr_t> ScanProcess(const Pattern& pattern, bool require_executable) override;
     std::vector<uintptr_t> ScanProcessAll(const Pattern& pattern, bool require_executable) override;
+    std::vector<std::optional<uintptr_t>> ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                          bool require_executable) override;
 
 private:
     class IProcessMemory* memory_;
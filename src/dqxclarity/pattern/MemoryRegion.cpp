@@ -1,6 +1,10 @@
 #include "MemoryRegion.hpp"
 #include <libmem/libmem.hpp>
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 namespace dqxclarity
 {
 
@@ -30,6 +34,18 @@ int ToInternalProtection(libmem::Prot prot)
     }
 }
 
+std::mutex& RegisteredMapsMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<pid_t, std::vector<MemoryRegion>>& RegisteredMaps()
+{
+    static std::unordered_map<pid_t, std::vector<MemoryRegion>> maps;
+    return maps;
+}
+
 std::vector<MemoryRegion> ParseMapsFilteredInternal(libmem::Pid pid, bool require_readable, bool require_executable)
 {
     std::vector<MemoryRegion> regions;
@@ -48,6 +64,21 @@ std::vector<MemoryRegion> ParseMapsFilteredInternal(libmem::Pid pid, bool requir
         return regions;
     }
 
+    // Sorted by base so each segment finds its module with a binary search instead of a full walk
+    std::vector<const libmem::Module*> sorted_modules;
+    if (modules)
+    {
+        sorted_modules.reserve(modules->size());
+        for (const auto& module : *modules)
+            sorted_modules.push_back(&module);
+        std::sort(sorted_modules.begin(), sorted_modules.end(),
+                  [](const libmem::Module* a, const libmem::Module* b)
+                  {
+                      return a->base < b->base;
+                  });
+    }
+
+    regions.reserve(segments->size());
     for (const auto& segment : *segments)
     {
         MemoryRegion region;
@@ -55,16 +86,14 @@ std::vector<MemoryRegion> ParseMapsFilteredInternal(libmem::Pid pid, bool requir
         region.end = segment.end;
         region.protection = ToInternalProtection(segment.prot);
 
-        if (modules)
+        auto it = std::upper_bound(sorted_modules.begin(), sorted_modules.end(), segment.base,
+                                   [](libmem::Address base, const libmem::Module* module)
+                                   {
+                                       return base < module->base;
+                                   });
+        if (it != sorted_modules.begin() && segment.base < (*std::prev(it))->end)
         {
-            for (const auto& module : *modules)
-            {
-                if (segment.base >= module.base && segment.base < module.end)
-                {
-                    region.pathname = module.path;
-                    break;
-                }
-            }
+            region.pathname = (*std::prev(it))->path;
         }
 
         if (require_readable && !region.IsReadable())
@@ -88,7 +117,40 @@ std::vector<MemoryRegion> MemoryRegionParser::ParseMaps(pid_t pid) { return Pars
 std::vector<MemoryRegion> MemoryRegionParser::ParseMapsFiltered(pid_t pid, bool require_readable,
                                                                 bool require_executable)
 {
+    std::vector<MemoryRegion> registered;
+    if (FindRegisteredMaps(pid, registered))
+    {
+        std::erase_if(registered,
+                      [&](const MemoryRegion& region)
+                      {
+                          return (require_readable && !region.IsReadable()) ||
+                                 (require_executable && !region.IsExecutable());
+                      });
+        return registered;
+    }
     return ParseMapsFilteredInternal(static_cast<libmem::Pid>(pid), require_readable, require_executable);
 }
 
+void MemoryRegionParser::RegisterMaps(pid_t pid, std::vector<MemoryRegion> regions)
+{
+    std::lock_guard lock(RegisteredMapsMutex());
+    RegisteredMaps()[pid] = std::move(regions);
+}
+
+void MemoryRegionParser::UnregisterMaps(pid_t pid)
+{
+    std::lock_guard lock(RegisteredMapsMutex());
+    RegisteredMaps().erase(pid);
+}
+
+bool MemoryRegionParser::FindRegisteredMaps(pid_t pid, std::vector<MemoryRegion>& out)
+{
+    std::lock_guard lock(RegisteredMapsMutex());
+    auto it = RegisteredMaps().find(pid);
+    if (it == RegisteredMaps().end())
+        return false;
+    out = it->second;
+    return true;
+}
+
 } // namespace dqxclarity
@@ -37,6 +37,17 @@ class MemoryRegionParser
 public:
     static std::vector<MemoryRegion> ParseMaps(pid_t pid);
     static std::vector<MemoryRegion> ParseMapsFiltered(pid_t pid, bool require_readable, bool require_executable);
+
+    /**
+     * @brief Answer queries for pid from a stored region list instead of the live process
+     *
+     * Used by snapshot replay (SnapshotProcessMemory), which registers its
+     * stored maps under a synthetic pid so scanners and RegionMap see the
+     * captured layout.
+     */
+    static void RegisterMaps(pid_t pid, std::vector<MemoryRegion> regions);
+    static void UnregisterMaps(pid_t pid);
+    static bool FindRegisteredMaps(pid_t pid, std::vector<MemoryRegion>& out);
 };
 
 } // namespace dqxclarity
@@ -0,0 +1,255 @@
+#include "MultiPatternSearch.hpp"
+#include "PatternSearch.hpp"
+#include "SimdSupport.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+// Scalar anchor pass from `begin`; returns false if on_candidate stopped it.
+template <typename OnCandidate>
+bool AnchorPassScalar(const uint8_t* buffer, size_t buffer_size, size_t begin, const std::array<uint8_t, 256>& first,
+                      const std::array<uint8_t, 256>& second, uint8_t single_byte_groups, OnCandidate& on_candidate)
+{
+    for (size_t i = begin; i < buffer_size; ++i)
+    {
+        uint8_t groups = first[buffer[i]];
+        if (!groups)
+            continue;
+        // The last byte has no successor, so only single-byte anchors can still start there
+        groups &= i + 1 < buffer_size ? second[buffer[i + 1]] : single_byte_groups;
+        if (groups && !on_candidate(i, groups))
+            return false;
+    }
+    return true;
+}
+
+#ifdef DQX_SEARCH_X86_SIMD
+
+// Looks every byte and its successor up in the nibble tables (16 bytes each: first lo/hi, second lo/hi).
+// Returns the first position left for the scalar tail, or SIZE_MAX if on_candidate stopped the pass.
+template <typename OnCandidate>
+DQX_TARGET_AVX2 size_t AnchorPassAvx2(const uint8_t* buffer, size_t buffer_size, const uint8_t* first_lo,
+                                      const uint8_t* first_hi, const uint8_t* second_lo, const uint8_t* second_hi,
+                                      OnCandidate& on_candidate)
+{
+    constexpr size_t kWidth = 32;
+    // pshufb looks up within each 128-bit lane, so both lanes carry the same 16-entry table
+    const __m256i t_first_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first_lo)));
+    const __m256i t_first_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first_hi)));
+    const __m256i t_second_lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(second_lo)));
+    const __m256i t_second_hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(second_hi)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    alignas(32) uint8_t lanes[kWidth];
+    size_t i = 0;
+    for (; i + kWidth + 1 <= buffer_size; i += kWidth)
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + i + 1));
+        const __m256i a_groups =
+            _mm256_and_si256(_mm256_shuffle_epi8(t_first_lo, _mm256_and_si256(a, nibble)),
+                             _mm256_shuffle_epi8(t_first_hi, _mm256_and_si256(_mm256_srli_epi16(a, 4), nibble)));
+        const __m256i b_groups =
+            _mm256_and_si256(_mm256_shuffle_epi8(t_second_lo, _mm256_and_si256(b, nibble)),
+                             _mm256_shuffle_epi8(t_second_hi, _mm256_and_si256(_mm256_srli_epi16(b, 4), nibble)));
+        const __m256i groups = _mm256_and_si256(a_groups, b_groups);
+        auto bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(groups, zero)));
+        if (!bits)
+            continue;
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), groups);
+        while (bits)
+        {
+            const auto lane = static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (!on_candidate(i + lane, lanes[lane]))
+                return SIZE_MAX;
+        }
+    }
+    return i;
+}
+
+#endif // DQX_SEARCH_X86_SIMD
+
+bool SameAnchor(const PatternAnchor& a, const PatternAnchor& b)
+{
+    return a.first == b.first && a.pair == b.pair && (!a.pair || a.second == b.second);
+}
+
+} // namespace
+
+MultiPatternSearch::MultiPatternSearch(const std::vector<const Pattern*>& patterns)
+{
+    for (size_t i = 0; i < patterns.size(); ++i)
+    {
+        const Pattern* pattern = patterns[i];
+        if (!pattern || !pattern->IsValid())
+            continue;
+
+        const CompiledPattern* compiled = pattern->compiled.get();
+        if (!compiled)
+        {
+            owned_.push_back(std::make_shared<const CompiledPattern>(CompiledPattern::FromPattern(*pattern)));
+            compiled = owned_.back().get();
+        }
+
+        max_pattern_size_ = (std::max)(max_pattern_size_, compiled->Size());
+        min_pattern_size_ = pending_ == 0 ? compiled->Size() : (std::min)(min_pattern_size_, compiled->Size());
+        ++pending_;
+
+        if (!compiled->anchor.valid)
+        {
+            wildcard_only_.push_back({ i, compiled });
+            continue;
+        }
+
+        auto bucket = std::find_if(buckets_.begin(), buckets_.end(),
+                                   [&](const Bucket& b)
+                                   {
+                                       return SameAnchor(b.anchor, compiled->anchor);
+                                   });
+        if (bucket == buckets_.end())
+        {
+            const size_t group = buckets_.size() % kGroups;
+            group_buckets_[group].push_back(buckets_.size());
+            buckets_.push_back({ compiled->anchor, static_cast<uint8_t>(1u << group), {} });
+            bucket = buckets_.end() - 1;
+        }
+        bucket->members.push_back({ i, compiled });
+    }
+}
+
+void MultiPatternSearch::RebuildTables()
+{
+    first_table_.fill(0);
+    second_table_.fill(0);
+    first_lo_.fill(0);
+    first_hi_.fill(0);
+    second_lo_.fill(0);
+    second_hi_.fill(0);
+    single_byte_groups_ = 0;
+
+    for (const auto& bucket : buckets_)
+    {
+        if (bucket.members.empty())
+            continue;
+        const uint8_t bit = bucket.group_bit;
+        const auto& anchor = bucket.anchor;
+        first_table_[anchor.first] |= bit;
+        first_lo_[anchor.first & 0x0F] |= bit;
+        first_hi_[anchor.first >> 4] |= bit;
+        if (anchor.pair)
+        {
+            second_table_[anchor.second] |= bit;
+            second_lo_[anchor.second & 0x0F] |= bit;
+            second_hi_[anchor.second >> 4] |= bit;
+        }
+        else
+        {
+            // Any successor byte is fine for a single-byte anchor
+            for (auto& entry : second_table_)
+                entry |= bit;
+            for (size_t n = 0; n < 16; ++n)
+            {
+                second_lo_[n] |= bit;
+                second_hi_[n] |= bit;
+            }
+            single_byte_groups_ |= bit;
+        }
+    }
+    tables_dirty_ = false;
+}
+
+bool MultiPatternSearch::CheckCandidate(const uint8_t* buffer, size_t buffer_size, size_t position, uint8_t groups,
+                                        const std::function<void(size_t, size_t)>& on_match)
+{
+    while (groups)
+    {
+        const auto group = static_cast<size_t>(std::countr_zero(static_cast<unsigned>(groups)));
+        groups &= static_cast<uint8_t>(groups - 1);
+
+        for (size_t bucket_index : group_buckets_[group])
+        {
+            auto& bucket = buckets_[bucket_index];
+            const auto& anchor = bucket.anchor;
+            // Nibble tables and shared groups only narrow the candidates down; confirm the exact anchor
+            if (bucket.members.empty() || buffer[position] != anchor.first)
+                continue;
+            if (anchor.pair && (position + 1 >= buffer_size || buffer[position + 1] != anchor.second))
+                continue;
+
+            for (size_t m = 0; m < bucket.members.size();)
+            {
+                const Member member = bucket.members[m];
+                const size_t offset = member.compiled->anchor.offset;
+                if (position < offset || position - offset + member.compiled->Size() > buffer_size ||
+                    !PatternSearch::MatchesAt(buffer + position - offset, *member.compiled))
+                {
+                    ++m;
+                    continue;
+                }
+                bucket.members.erase(bucket.members.begin() + static_cast<std::ptrdiff_t>(m));
+                --pending_;
+                tables_dirty_ |= bucket.members.empty();
+                on_match(member.index, position - offset);
+            }
+        }
+    }
+    return pending_ > 0;
+}
+
+size_t MultiPatternSearch::FindFirstEach(const uint8_t* buffer, size_t buffer_size,
+                                         const std::function<void(size_t index, size_t offset)>& on_match)
+{
+    if (!buffer || pending_ == 0)
+        return pending_;
+
+    // All-wildcard patterns match at the start of any buffer that fits them
+    for (auto it = wildcard_only_.begin(); it != wildcard_only_.end();)
+    {
+        if (it->compiled->Size() > buffer_size)
+        {
+            ++it;
+            continue;
+        }
+        const size_t index = it->index;
+        it = wildcard_only_.erase(it);
+        --pending_;
+        on_match(index, 0);
+    }
+    if (pending_ == wildcard_only_.size())
+        return pending_;
+
+    if (tables_dirty_)
+        RebuildTables();
+    bytes_scanned_ += buffer_size;
+
+    auto on_candidate = [&](size_t position, uint8_t groups)
+    {
+        return CheckCandidate(buffer, buffer_size, position, groups, on_match);
+    };
+
+    size_t next = 0;
+#ifdef DQX_SEARCH_X86_SIMD
+    if (PatternSearch::HasAvx2())
+    {
+        next = AnchorPassAvx2(buffer, buffer_size, first_lo_.data(), first_hi_.data(), second_lo_.data(),
+                              second_hi_.data(), on_candidate);
+        if (next == SIZE_MAX)
+            return pending_;
+    }
+#endif
+    AnchorPassScalar(buffer, buffer_size, next, first_table_, second_table_, single_byte_groups_, on_candidate);
+    return pending_;
+}
+
+} // namespace dqxclarity
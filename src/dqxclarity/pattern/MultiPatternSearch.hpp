@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Pattern.hpp"
+#include "CompiledPattern.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief First-match search for a whole pattern table in one pass per buffer
+ *
+ * Patterns are bucketed by their anchor (PatternAnchor first/second byte), and
+ * buckets are spread over eight groups. A single anchor pass over the buffer
+ * looks up every byte pair in per-group nibble tables (AVX2 shuffles, or a
+ * 256-entry byte table on other targets) and only the buckets of the groups
+ * that hit are checked, so a buffer is walked once no matter how many patterns
+ * are pending. Patterns that found their first match are retired and the
+ * tables are rebuilt without them before the next buffer.
+ *
+ * Matches are reported in ascending offset order per pattern, so chained calls
+ * over consecutive, overlapping windows keep first-match semantics.
+ */
+class MultiPatternSearch
+{
+public:
+    /**
+     * @brief Build the matcher; null or invalid patterns never match
+     *
+     * Patterns without a compiled form are compiled once here. The Pattern
+     * objects themselves need not outlive the matcher.
+     */
+    explicit MultiPatternSearch(const std::vector<const Pattern*>& patterns);
+
+    /**
+     * @brief Report the first match of every pending pattern in the buffer and retire it
+     * @param on_match Called with (pattern index, buffer offset) for each newly found pattern
+     * @return Number of patterns still pending
+     */
+    size_t FindFirstEach(const uint8_t* buffer, size_t buffer_size,
+                         const std::function<void(size_t index, size_t offset)>& on_match);
+
+    size_t Pending() const { return pending_; }
+
+    /**
+     * @brief Largest/smallest size of the searchable patterns (0 if there are none)
+     */
+    size_t MaxPatternSize() const { return max_pattern_size_; }
+    size_t MinPatternSize() const { return min_pattern_size_; }
+
+    /**
+     * @brief Bytes run through the anchor pass, each buffer counted once
+     */
+    uint64_t BytesScanned() const { return bytes_scanned_; }
+
+private:
+    static constexpr size_t kGroups = 8;
+
+    struct Member
+    {
+        size_t index = 0;
+        const CompiledPattern* compiled = nullptr;
+    };
+
+    struct Bucket
+    {
+        PatternAnchor anchor;
+        uint8_t group_bit = 0;
+        std::vector<Member> members;
+    };
+
+    void RebuildTables();
+
+    // Verifies the members of every bucket in `groups` whose anchor sits at position; false once nothing is pending
+    bool CheckCandidate(const uint8_t* buffer, size_t buffer_size, size_t position, uint8_t groups,
+                        const std::function<void(size_t, size_t)>& on_match);
+
+    std::vector<std::shared_ptr<const CompiledPattern>> owned_;
+    std::vector<Bucket> buckets_;
+    std::vector<Member> wildcard_only_;
+    std::array<std::vector<size_t>, kGroups> group_buckets_;
+
+    // Group bits per anchor byte at the candidate position and the one after it
+    std::array<uint8_t, 256> first_table_{};
+    std::array<uint8_t, 256> second_table_{};
+    // Nibble-split versions of the same tables for the shuffle-based pass
+    std::array<uint8_t, 16> first_lo_{};
+    std::array<uint8_t, 16> first_hi_{};
+    std::array<uint8_t, 16> second_lo_{};
+    std::array<uint8_t, 16> second_hi_{};
+    uint8_t single_byte_groups_ = 0;
+
+    size_t pending_ = 0;
+    size_t max_pattern_size_ = 0;
+    size_t min_pattern_size_ = 0;
+    uint64_t bytes_scanned_ = 0;
+    bool tables_dirty_ = true;
+};
+
+} // namespace dqxclarity
@@ -0,0 +1,313 @@
+#include "PageChangeTracker.hpp"
+
+#include "../util/Profile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+constexpr uint64_t kSoftDirtyBit = 1ull << 55;
+constexpr size_t kPagemapBatch = 4096; // entries per pread (32 KB)
+
+#ifndef _WIN32
+bool ReadPagemapEntry(int fd, const void* address, uint64_t& entry)
+{
+    const off_t offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(address) / PageChangeTracker::kPageSize *
+                                            sizeof(uint64_t));
+    return ::pread(fd, &entry, sizeof(entry), offset) == static_cast<ssize_t>(sizeof(entry));
+}
+
+bool ProbeSoftDirty()
+{
+    if (::sysconf(_SC_PAGESIZE) != static_cast<long>(PageChangeTracker::kPageSize))
+        return false;
+
+    const int pagemap = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    const int clear_refs = ::open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+    void* page = ::mmap(nullptr, PageChangeTracker::kPageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1, 0);
+
+    bool supported = false;
+    if (pagemap >= 0 && clear_refs >= 0 && page != MAP_FAILED)
+    {
+        // Clean after the reset, dirty again after a write: anything else means the bits are not maintained
+        auto* byte = static_cast<volatile uint8_t*>(page);
+        *byte = 1;
+        uint64_t before = 0;
+        uint64_t after = 0;
+        if (::write(clear_refs, "4", 1) == 1 && ReadPagemapEntry(pagemap, page, before))
+        {
+            *byte = 2;
+            supported = ReadPagemapEntry(pagemap, page, after) && (before & kSoftDirtyBit) == 0 &&
+                        (after & kSoftDirtyBit) != 0;
+        }
+    }
+
+    if (page != MAP_FAILED)
+        ::munmap(page, PageChangeTracker::kPageSize);
+    if (clear_refs >= 0)
+        ::close(clear_refs);
+    if (pagemap >= 0)
+        ::close(pagemap);
+    return supported;
+}
+#endif
+
+} // namespace
+
+PageChangeTracker::PageChangeTracker(IProcessMemory* memory, std::shared_ptr<RegionMap> region_map,
+                                     RegionFilter filter, PageTrackingBackend backend, size_t max_region_size)
+    : memory_(memory)
+    , region_map_(std::move(region_map))
+    , filter_(filter)
+    , backend_(PageTrackingBackend::PageHash)
+    , max_region_size_(max_region_size)
+{
+#ifndef _WIN32
+    if (backend != PageTrackingBackend::PageHash && memory_ && SoftDirtySupported())
+    {
+        const std::string proc = "/proc/" + std::to_string(memory_->GetAttachedPid());
+        pagemap_fd_ = ::open((proc + "/pagemap").c_str(), O_RDONLY | O_CLOEXEC);
+        clear_refs_fd_ = ::open((proc + "/clear_refs").c_str(), O_WRONLY | O_CLOEXEC);
+        if (pagemap_fd_ >= 0 && clear_refs_fd_ >= 0)
+            backend_ = PageTrackingBackend::SoftDirty;
+    }
+#else
+    (void)backend;
+#endif
+}
+
+PageChangeTracker::~PageChangeTracker()
+{
+#ifndef _WIN32
+    if (pagemap_fd_ >= 0)
+        ::close(pagemap_fd_);
+    if (clear_refs_fd_ >= 0)
+        ::close(clear_refs_fd_);
+#endif
+}
+
+bool PageChangeTracker::SoftDirtySupported()
+{
+#ifdef _WIN32
+    return false;
+#else
+    static const bool supported = ProbeSoftDirty();
+    return supported;
+#endif
+}
+
+uint64_t PageChangeTracker::Sample(std::chrono::milliseconds max_age)
+{
+    PROFILE_SCOPE_FUNCTION();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (generation_ > 0 && now - last_sample_ < max_age)
+        return generation_;
+
+    if (region_map_)
+        region_map_->RefreshIfStale(max_age);
+
+    ++generation_;
+    last_changed_pages_ = 0;
+    const bool resync = generation_ == 1 || now - last_resync_ >= kResyncInterval;
+    if (resync)
+        last_resync_ = now;
+
+    SyncRegions(resync);
+    if (backend_ == PageTrackingBackend::SoftDirty && !SampleSoftDirty())
+    {
+        // Lost access to the target's proc files; hashes keep working through IProcessMemory
+        backend_ = PageTrackingBackend::PageHash;
+        last_changed_pages_ = 0;
+        for (auto& [start, region] : regions_)
+        {
+            std::fill(region.page_generation.begin(), region.page_generation.end(), generation_);
+            last_changed_pages_ += region.page_generation.size();
+        }
+    }
+    if (backend_ == PageTrackingBackend::PageHash)
+        SampleHashes();
+
+    last_sample_ = now;
+    return generation_;
+}
+
+void PageChangeTracker::SyncRegions(bool resync)
+{
+    std::vector<MemoryRegion> current;
+    if (region_map_)
+        current = region_map_->Regions(filter_);
+
+    std::map<uintptr_t, TrackedRegion> next;
+    for (const auto& region : current)
+    {
+        if (region.Size() == 0 || region.Size() > max_region_size_)
+            continue;
+
+        const size_t pages = (region.Size() + kPageSize - 1) / kPageSize;
+        auto it = regions_.find(region.start);
+        TrackedRegion tracked;
+        if (it != regions_.end() && it->second.end == region.end)
+        {
+            tracked = std::move(it->second);
+            if (resync)
+            {
+                std::fill(tracked.page_generation.begin(), tracked.page_generation.end(), generation_);
+                last_changed_pages_ += pages;
+            }
+        }
+        else
+        {
+            // New or resized mapping: everything in it is unseen
+            tracked.end = region.end;
+            tracked.page_generation.assign(pages, generation_);
+            last_changed_pages_ += pages;
+        }
+        next.emplace(region.start, std::move(tracked));
+    }
+    regions_.swap(next);
+}
+
+bool PageChangeTracker::SampleSoftDirty()
+{
+#ifdef _WIN32
+    return false;
+#else
+    auto* entries = reinterpret_cast<uint64_t*>(scratch_.Get(kPagemapBatch * sizeof(uint64_t)));
+    for (auto& [start, region] : regions_)
+    {
+        const size_t pages = region.page_generation.size();
+        for (size_t first = 0; first < pages; first += kPagemapBatch)
+        {
+            const size_t count = (std::min)(kPagemapBatch, pages - first);
+            const off_t offset = static_cast<off_t>((start / kPageSize + first) * sizeof(uint64_t));
+            const ssize_t n = ::pread(pagemap_fd_, entries, count * sizeof(uint64_t), offset);
+            if (n < 0)
+                return false;
+
+            const size_t read = static_cast<size_t>(n) / sizeof(uint64_t);
+            for (size_t i = 0; i < read; ++i)
+            {
+                uint64_t& generation = region.page_generation[first + i];
+                if ((entries[i] & kSoftDirtyBit) != 0 && generation != generation_)
+                {
+                    generation = generation_;
+                    ++last_changed_pages_;
+                }
+            }
+        }
+    }
+
+    // Reset right after the read to keep the unobserved window short
+    return ::write(clear_refs_fd_, "4", 1) == 1;
+#endif
+}
+
+void PageChangeTracker::SampleHashes()
+{
+    if (!memory_)
+        return;
+
+    ChunkedRegionReader reader(memory_, scratch_);
+    for (auto& entry : regions_)
+    {
+        const uintptr_t region_start = entry.first;
+        TrackedRegion& region = entry.second;
+        const bool first_pass = region.page_hash.empty();
+        if (first_pass)
+            region.page_hash.assign(region.page_generation.size(), 0);
+
+        reader.ForEachChunk(region_start, region.end - region_start, 0,
+                            [&](uintptr_t address, const uint8_t* data, size_t length, size_t)
+                            {
+                                for (size_t offset = 0; offset < length; offset += kPageSize)
+                                {
+                                    const size_t page = (address - region_start + offset) / kPageSize;
+                                    const size_t page_length = (std::min)(kPageSize, length - offset);
+                                    const uint64_t hash = HashPage(data + offset, page_length);
+                                    if (!first_pass && region.page_hash[page] != hash &&
+                                        region.page_generation[page] != generation_)
+                                    {
+                                        region.page_generation[page] = generation_;
+                                        ++last_changed_pages_;
+                                    }
+                                    region.page_hash[page] = hash;
+                                }
+                                return true;
+                            });
+    }
+}
+
+uint64_t PageChangeTracker::HashPage(const uint8_t* data, size_t length)
+{
+    // Word-at-a-time multiply-xor; only used to compare a page with itself
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ length;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 32;
+    }
+    for (; i < length; ++i)
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    return hash;
+}
+
+std::vector<ChangedRange> PageChangeTracker::ChangedSince(uint64_t since) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ChangedRange> ranges;
+    for (const auto& [start, region] : regions_)
+    {
+        const auto& generations = region.page_generation;
+        for (size_t page = 0; page < generations.size();)
+        {
+            if (generations[page] <= since)
+            {
+                ++page;
+                continue;
+            }
+            size_t last = page;
+            while (last + 1 < generations.size() && generations[last + 1] > since)
+                ++last;
+
+            ChangedRange range;
+            range.start = start + page * kPageSize;
+            range.end = (std::min)(region.end, start + (last + 1) * kPageSize);
+            range.region_start = start;
+            range.region_end = region.end;
+            ranges.push_back(range);
+            page = last + 1;
+        }
+    }
+    return ranges;
+}
+
+uint64_t PageChangeTracker::Generation() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+size_t PageChangeTracker::LastChangedPages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_changed_pages_;
+}
+
+} // namespace dqxclarity
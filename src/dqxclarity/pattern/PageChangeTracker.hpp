@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../memory/IProcessMemory.hpp"
+#include "ChunkedRegionReader.hpp"
+#include "MemoryRegion.hpp"
+#include "RegionMap.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dqxclarity
+{
+
+enum class PageTrackingBackend
+{
+    Auto,      // SoftDirty when the kernel supports it, PageHash otherwise
+    SoftDirty, // Linux soft-dirty bits: /proc/pid/pagemap, reset through /proc/pid/clear_refs
+    PageHash   // Read every tracked page and compare a per-page hash
+};
+
+/**
+ * @brief A run of changed pages, with the bounds of the region it lies in
+ */
+struct ChangedRange
+{
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    uintptr_t region_start = 0;
+    uintptr_t region_end = 0;
+};
+
+/**
+ * @brief Tracks which pages of the target changed between samples
+ *
+ * Every Sample() stamps the pages written since the previous one with a new
+ * generation; consumers remember the generation they last looked at and ask
+ * ChangedSince() for the pages they have not seen yet. Pages of mappings that
+ * are new (or were resized) count as changed.
+ *
+ * The hash backend is the default. The soft-dirty backend is opt-in (Auto or
+ * SoftDirty, see Config::soft_dirty_page_tracking) because resetting the bits
+ * writes to the target's /proc/pid/clear_refs, which changes the game's page
+ * tables and wipes soft-dirty state other tools may depend on.
+ *
+ * The soft-dirty backend costs 8 bytes of pagemap per page and no target reads.
+ * Soft-dirty bits are process-wide, so one tracker is shared by all scanners of
+ * an Engine; every method is thread-safe. Writes landing between the pagemap
+ * read and the clear_refs reset are not seen, so all pages are re-stamped every
+ * kResyncInterval as a safety net.
+ *
+ * The hash backend still reads tracked memory on each sample, but only changed
+ * pages are handed to the (far more expensive) pattern search.
+ */
+class PageChangeTracker
+{
+public:
+    static constexpr size_t kPageSize = 4096;
+    static constexpr std::chrono::seconds kResyncInterval{ 10 };
+
+    PageChangeTracker(IProcessMemory* memory, std::shared_ptr<RegionMap> region_map,
+                      RegionFilter filter = RegionFilter::NonExecutable,
+                      PageTrackingBackend backend = PageTrackingBackend::PageHash, size_t max_region_size = SIZE_MAX);
+    ~PageChangeTracker();
+
+    PageChangeTracker(const PageChangeTracker&) = delete;
+    PageChangeTracker& operator=(const PageChangeTracker&) = delete;
+
+    /**
+     * @brief Whether the kernel exposes working soft-dirty tracking (probed once on this process)
+     */
+    static bool SoftDirtySupported();
+
+    PageTrackingBackend Backend() const { return backend_; }
+
+    RegionFilter Filter() const { return filter_; }
+
+    /**
+     * @brief Take a new sample unless the last one is younger than max_age
+     * @return Generation of the latest sample
+     */
+    uint64_t Sample(std::chrono::milliseconds max_age = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Page-aligned, coalesced ranges stamped after generation `since` (0 = everything)
+     */
+    std::vector<ChangedRange> ChangedSince(uint64_t since) const;
+
+    uint64_t Generation() const;
+
+    /**
+     * @brief Pages stamped by the most recent sample
+     */
+    size_t LastChangedPages() const;
+
+private:
+    struct TrackedRegion
+    {
+        uintptr_t end = 0;
+        std::vector<uint64_t> page_generation;
+        std::vector<uint64_t> page_hash; // PageHash backend only
+    };
+
+    void SyncRegions(bool resync);
+    bool SampleSoftDirty();
+    void SampleHashes();
+    static uint64_t HashPage(const uint8_t* data, size_t length);
+
+    IProcessMemory* memory_;
+    std::shared_ptr<RegionMap> region_map_;
+    RegionFilter filter_;
+    PageTrackingBackend backend_;
+    size_t max_region_size_;
+
+    mutable std::mutex mutex_;
+    std::map<uintptr_t, TrackedRegion> regions_; // keyed by region start
+    uint64_t generation_ = 0;
+    size_t last_changed_pages_ = 0;
+    std::chrono::steady_clock::time_point last_sample_{};
+    std::chrono::steady_clock::time_point last_resync_{};
+    ScratchBuffer scratch_;
+
+    int pagemap_fd_ = -1;
+    int clear_refs_fd_ = -1;
+};
+
+} // namespace dqxclarity
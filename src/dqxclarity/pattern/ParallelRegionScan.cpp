@@ -0,0 +1,219 @@
+#include "ParallelRegionScan.hpp"
+#include "ChunkedRegionReader.hpp"
+#include "PatternSearch.hpp"
+
+#include "../util/Profile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#undef min
+#undef max
+#endif
+#include "../util/BS_thread_pool.hpp"
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+struct WorkUnit
+{
+    uintptr_t start;  // first match start owned by this unit
+    size_t size;      // number of match start positions owned by this unit
+    size_t read_size; // size plus pattern overlap, clipped to the region end
+};
+
+std::vector<WorkUnit> Partition(const std::vector<MemoryRegion>& regions, size_t pattern_size)
+{
+    std::vector<WorkUnit> units;
+    for (const auto& region : regions)
+    {
+        if (region.Size() < pattern_size)
+            continue;
+
+        for (size_t offset = 0; offset < region.Size(); offset += ParallelRegionScan::kUnitSize)
+        {
+            const size_t remaining = region.Size() - offset;
+            if (remaining < pattern_size)
+                break;
+            const size_t owned = (std::min)(ParallelRegionScan::kUnitSize, remaining);
+            const size_t read = (std::min)(owned + pattern_size - 1, remaining);
+            units.push_back(WorkUnit{ region.start + offset, owned, read });
+        }
+    }
+
+    std::sort(units.begin(), units.end(),
+              [](const WorkUnit& a, const WorkUnit& b)
+              {
+                  return a.start < b.start;
+              });
+    return units;
+}
+
+struct ScanJob
+{
+    IProcessMemory* memory = nullptr;
+    Pattern pattern;
+    std::vector<WorkUnit> units;
+    bool first_only = true;
+
+    std::atomic<size_t> next_unit{ 0 };
+    std::atomic<uintptr_t> best{ UINTPTR_MAX };
+    std::vector<std::vector<uintptr_t>> unit_matches; // FindAll only, one slot per unit
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t active_helpers = 0;
+    bool closed = false;
+    ScanCost cost; // merged from every worker under mutex
+
+    void LowerBest(uintptr_t address)
+    {
+        uintptr_t current = best.load(std::memory_order_relaxed);
+        while (address < current &&
+               !best.compare_exchange_weak(current, address, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void Work()
+    {
+        ScratchBuffer scratch;
+        ScanCost local;
+        ChunkedRegionReader reader(memory, scratch, &local);
+        std::vector<size_t> offsets;
+
+        for (;;)
+        {
+            const size_t index = next_unit.fetch_add(1, std::memory_order_relaxed);
+            if (index >= units.size())
+                break;
+
+            const WorkUnit& unit = units[index];
+            // Units are handed out in ascending order, so nothing after this one can beat best
+            if (first_only && unit.start >= best.load(std::memory_order_acquire))
+                break;
+
+            reader.ForEachChunk(unit.start, unit.read_size, pattern.Size() - 1,
+                                [&](uintptr_t address, const uint8_t* data, size_t length, size_t owned)
+                                {
+                                    if (first_only)
+                                    {
+                                        if (address >= best.load(std::memory_order_acquire))
+                                            return false;
+                                        size_t offset = PatternSearch::FindFirst(data, length, pattern);
+                                        if (offset == PatternSearch::kNotFound)
+                                            return true;
+                                        LowerBest(address + offset);
+                                        return false;
+                                    }
+
+                                    offsets.clear();
+                                    PatternSearch::FindAll(data, length, pattern, offsets);
+                                    for (size_t offset : offsets)
+                                    {
+                                        // Skip starts repeated by the next window or owned by the next unit
+                                        if (offset < owned && address + offset < unit.start + unit.size)
+                                            unit_matches[index].push_back(address + offset);
+                                    }
+                                    return true;
+                                });
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        cost += local;
+    }
+};
+
+std::shared_ptr<ScanJob> RunJob(IProcessMemory* memory, ScanThreadPool* pool, const std::vector<MemoryRegion>& regions,
+                                const Pattern& pattern, bool first_only)
+{
+    auto job = std::make_shared<ScanJob>();
+    job->memory = memory;
+    job->pattern = pattern;
+    job->first_only = first_only;
+    job->units = Partition(regions, pattern.Size());
+    if (!first_only)
+        job->unit_matches.resize(job->units.size());
+
+    if (pool && job->units.size() > 1)
+    {
+        const size_t helpers = (std::min)(static_cast<size_t>(pool->get_thread_count()), job->units.size() - 1);
+        for (size_t i = 0; i < helpers; ++i)
+        {
+            pool->detach_task(
+                [job]
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(job->mutex);
+                        if (job->closed)
+                            return;
+                        ++job->active_helpers;
+                    }
+                    job->Work();
+                    {
+                        std::lock_guard<std::mutex> lock(job->mutex);
+                        --job->active_helpers;
+                    }
+                    job->cv.notify_all();
+                });
+        }
+    }
+
+    // The caller works too, then only waits for helpers that actually started;
+    // helpers still queued behind a busy pool see `closed` and return immediately.
+    job->Work();
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->closed = true;
+        job->cv.wait(lock,
+                     [&job]
+                     {
+                         return job->active_helpers == 0;
+                     });
+    }
+    return job;
+}
+
+} // namespace
+
+std::optional<uintptr_t> ParallelRegionScan::FindFirst(IProcessMemory* memory, ScanThreadPool* pool,
+                                                       const std::vector<MemoryRegion>& regions,
+                                                       const Pattern& pattern, ScanCost* cost)
+{
+    PROFILE_SCOPE_FUNCTION();
+    if (!memory || !pattern.IsValid())
+        return std::nullopt;
+
+    auto job = RunJob(memory, pool, regions, pattern, true);
+    const uintptr_t best = job->best.load(std::memory_order_acquire);
+    if (cost)
+        *cost += job->cost;
+    if (best == UINTPTR_MAX)
+        return std::nullopt;
+    return best;
+}
+
+std::vector<uintptr_t> ParallelRegionScan::FindAll(IProcessMemory* memory, ScanThreadPool* pool,
+                                                   const std::vector<MemoryRegion>& regions, const Pattern& pattern,
+                                                   ScanCost* cost)
+{
+    PROFILE_SCOPE_FUNCTION();
+    std::vector<uintptr_t> results;
+    if (!memory || !pattern.IsValid())
+        return results;
+
+    auto job = RunJob(memory, pool, regions, pattern, false);
+    for (const auto& matches : job->unit_matches)
+        results.insert(results.end(), matches.begin(), matches.end());
+    if (cost)
+        *cost += job->cost;
+    return results;
+}
+
+} // namespace dqxclarity
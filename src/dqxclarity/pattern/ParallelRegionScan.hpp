@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Pattern.hpp"
+#include "MemoryRegion.hpp"
+#include "../api/scan_stats.hpp"
+#include "../memory/IProcessMemory.hpp"
+#include "../util/ThreadPoolFwd.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Region scans split across the engine's thread pool
+ *
+ * Regions are cut into byte-sized work units (so one huge Wine heap does not end
+ * up on a single worker) and handed out in ascending address order. First-match
+ * scans share an atomic best address: a worker stops as soon as its position is
+ * past the current best, and the lowest matching address always wins, so results
+ * are identical to a sequential scan.
+ *
+ * The calling thread takes part in the scan and never blocks on queued helper
+ * tasks, which keeps it safe to call from inside a task of the same pool.
+ * A null pool runs the scan on the calling thread only.
+ *
+ * An optional ScanCost receives the reads of all workers once the scan is done;
+ * each work unit counts as one visited range. Matches are left to the caller.
+ */
+class ParallelRegionScan
+{
+public:
+    static constexpr size_t kUnitSize = 4 * 1024 * 1024;
+
+    /**
+     * @brief Lowest address in regions matching pattern
+     */
+    static std::optional<uintptr_t> FindFirst(IProcessMemory* memory, ScanThreadPool* pool,
+                                              const std::vector<MemoryRegion>& regions, const Pattern& pattern,
+                                              ScanCost* cost = nullptr);
+
+    /**
+     * @brief All matches in regions, in ascending address order
+     */
+    static std::vector<uintptr_t> FindAll(IProcessMemory* memory, ScanThreadPool* pool,
+                                          const std::vector<MemoryRegion>& regions, const Pattern& pattern,
+                                          ScanCost* cost = nullptr);
+};
+
+} // namespace dqxclarity
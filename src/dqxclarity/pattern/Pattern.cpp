@@ -1,4 +1,5 @@
 #include "Pattern.hpp"
+#include "CompiledPattern.hpp"
 #include <sstream>
 
 namespace dqxclarity
@@ -32,6 +33,8 @@ Pattern Pattern::FromString(const std::string& pattern_str)
         }
     }
 
+    if (pattern.IsValid())
+        pattern.compiled = std::make_shared<const CompiledPattern>(CompiledPattern::FromPattern(pattern));
     return pattern;
 }
 
@@ -40,6 +43,8 @@ Pattern Pattern::FromBytes(const uint8_t* data, size_t size)
     Pattern pattern;
     pattern.bytes.assign(data, data + size);
     pattern.mask.assign(size, true);
+    if (pattern.IsValid())
+        pattern.compiled = std::make_shared<const CompiledPattern>(CompiledPattern::FromPattern(pattern));
     return pattern;
 }
 
@@ -2,16 +2,22 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace dqxclarity
 {
 
+struct CompiledPattern;
+
 struct Pattern
 {
     std::vector<uint8_t> bytes;
     std::vector<bool> mask;
 
+    /// Search tables built once by FromString/FromBytes; null for hand-assembled patterns
+    std::shared_ptr<const CompiledPattern> compiled;
+
     static Pattern FromString(const std::string& pattern_str);
 
     static Pattern FromBytes(const uint8_t* data, size_t size);
@@ -1,8 +1,13 @@
 #include "PatternScanner.hpp"
+#include "PatternSearch.hpp"
+#include "MultiPatternSearch.hpp"
+#include "ChunkedRegionReader.hpp"
+#include "ParallelRegionScan.hpp"
 
 #include "../util/Profile.hpp"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 namespace dqxclarity
 {
@@ -19,175 +24,180 @@ static std::string ToLowerCase(const std::string& str)
     return result;
 }
 
+/**
+ * @brief Counts the outermost public call as one scan and adds its wall time
+ */
+class PatternScanner::CostScope
+{
+public:
+    explicit CostScope(PatternScanner& scanner)
+        : scanner_(scanner)
+        , start_(std::chrono::steady_clock::now())
+    {
+        ++scanner_.m_cost_depth;
+    }
+
+    ~CostScope()
+    {
+        if (--scanner_.m_cost_depth > 0)
+            return;
+        ++scanner_.m_cost.scans;
+        scanner_.m_cost.wall_time +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+    }
+
+    CostScope(const CostScope&) = delete;
+    CostScope& operator=(const CostScope&) = delete;
+
+private:
+    PatternScanner& scanner_;
+    std::chrono::steady_clock::time_point start_;
+};
+
 PatternScanner::PatternScanner(IProcessMemory* memory)
     : m_memory(memory)
 {
 }
 
-std::vector<size_t> PatternScanner::BuildBadCharTable(const Pattern& pattern)
+PatternScanner::PatternScanner(IProcessMemory* memory, ScanThreadPool* pool)
+    : m_memory(memory)
+    , m_pool(pool)
 {
-    std::vector<size_t> table(256, pattern.Size());
-
-    for (size_t i = 0; i < pattern.Size() - 1; ++i)
-    {
-        if (pattern.mask[i])
-        {
-            table[pattern.bytes[i]] = pattern.Size() - 1 - i;
-        }
-    }
-
-    return table;
 }
 
-std::optional<size_t> PatternScanner::FindPatternInBuffer(const uint8_t* buffer, size_t buffer_size,
-                                                          const Pattern& pattern,
-                                                          const std::vector<size_t>& bad_char_table)
+std::optional<uintptr_t> PatternScanner::ScanRegion(const MemoryRegion& region, const Pattern& pattern)
 {
-    if (buffer_size < pattern.Size())
+    PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
+    if (!pattern.IsValid() || region.Size() < pattern.Size())
     {
         return std::nullopt;
     }
 
-    size_t i = 0;
-    while (i <= buffer_size - pattern.Size())
-    {
-        size_t j = pattern.Size();
+    std::optional<uintptr_t> result;
+    ChunkedRegionReader reader(m_memory, m_scratch, &m_cost);
+    reader.ForEachChunk(region.start, region.Size(), pattern.Size() - 1,
+                        [&](uintptr_t address, const uint8_t* data, size_t length, size_t)
+                        {
+                            PROFILE_SCOPE_CUSTOM("ScanRegion.Search");
+                            size_t offset = PatternSearch::FindFirst(data, length, pattern);
+                            if (offset != PatternSearch::kNotFound)
+                                result = address + offset;
+                            return !result.has_value();
+                        });
+
+    m_cost.matches += result ? 1 : 0;
+    return result;
+}
 
-        while (j > 0)
-        {
-            --j;
-            if (!pattern.mask[j] || buffer[i + j] == pattern.bytes[j])
-            {
-                if (j == 0)
+std::vector<uintptr_t> PatternScanner::ScanRegionAll(const MemoryRegion& region, const Pattern& pattern)
+{
+    CostScope cost_scope(*this);
+    std::vector<uintptr_t> results;
+    VisitRegion(region, pattern,
+                [&results](uintptr_t address)
                 {
-                    return i;
-                }
-            }
-            else
-            {
-                break;
-            }
-        }
-
-        uint8_t bad_char = buffer[i + pattern.Size() - 1];
-        i += bad_char_table[bad_char];
-    }
-
-    return std::nullopt;
+                    results.push_back(address);
+                    return true;
+                });
+    return results;
 }
 
-std::vector<size_t> PatternScanner::FindPatternInBufferAll(const uint8_t* buffer, size_t buffer_size,
-                                                           const Pattern& pattern)
+ScanVisitResult PatternScanner::VisitRegion(const MemoryRegion& region, const Pattern& pattern,
+                                            const MatchVisitor& visitor, const ScanVisitOptions& options)
 {
-    std::vector<size_t> results;
-
-    if (buffer_size < pattern.Size())
+    CostScope cost_scope(*this);
+    ScanVisitResult result;
+    if (!pattern.IsValid() || region.Size() < pattern.Size())
+    {
+        return result;
+    }
+    if (options.max_matches == 0)
     {
-        return results;
+        result.stopped = true;
+        return result;
     }
 
-    for (size_t i = 0; i <= buffer_size - pattern.Size(); ++i)
+    uintptr_t window = 0;
+    size_t owned_bytes = 0;
+    const std::function<bool(size_t)> on_match = [&](size_t offset)
     {
-        bool match = true;
-        for (size_t j = 0; j < pattern.Size(); ++j)
-        {
-            if (pattern.mask[j] && buffer[i + j] != pattern.bytes[j])
-            {
-                match = false;
-                break;
-            }
-        }
-        if (match)
+        // Matches starting in the overlap are reported by the next window
+        if (offset >= owned_bytes)
+            return false;
+        ++result.matches;
+        ++m_cost.matches;
+        if (!visitor(window + offset) || result.matches >= options.max_matches)
         {
-            results.push_back(i);
+            result.stopped = true;
+            return false;
         }
-    }
+        return true;
+    };
+
+    ChunkedRegionReader reader(m_memory, m_scratch, &m_cost);
+    reader.ForEachChunk(region.start, region.Size(), pattern.Size() - 1,
+                        [&](uintptr_t address, const uint8_t* data, size_t length, size_t owned)
+                        {
+                            if (options.cancel && options.cancel->load(std::memory_order_relaxed))
+                            {
+                                result.stopped = result.canceled = true;
+                                return false;
+                            }
+                            window = address;
+                            owned_bytes = owned;
+                            PatternSearch::ForEachMatch(data, length, pattern, on_match);
+                            return !result.stopped;
+                        });
 
-    return results;
+    return result;
 }
 
-std::optional<uintptr_t> PatternScanner::ScanRegion(const MemoryRegion& region, const Pattern& pattern)
+ScanVisitResult PatternScanner::VisitRegions(const std::vector<MemoryRegion>& regions, const Pattern& pattern,
+                                             const MatchVisitor& visitor, const ScanVisitOptions& options)
 {
     PROFILE_SCOPE_FUNCTION();
-    if (!pattern.IsValid() || region.Size() < pattern.Size())
-    {
-        return std::nullopt;
-    }
-
-    std::vector<uint8_t> buffer(region.Size());
+    CostScope cost_scope(*this);
+    ScanVisitResult total;
+    ScanVisitOptions remaining = options;
+    for (const auto& region : regions)
     {
-        PROFILE_SCOPE_CUSTOM("ScanRegion.ReadMemory");
-        if (!m_memory->ReadMemory(region.start, buffer.data(), buffer.size()))
+        if (options.cancel && options.cancel->load(std::memory_order_relaxed))
         {
-            return std::nullopt;
+            total.stopped = total.canceled = true;
+            break;
         }
-    }
 
-    bool has_wildcards = false;
-    {
-        PROFILE_SCOPE_CUSTOM("ScanRegion.CheckWildcards");
-        has_wildcards = std::find(pattern.mask.begin(), pattern.mask.end(), false) != pattern.mask.end();
-    }
-
-    if (has_wildcards)
-    {
-        PROFILE_SCOPE_CUSTOM("ScanRegion.NaiveScan");
-        auto all = FindPatternInBufferAll(buffer.data(), buffer.size(), pattern);
-        if (!all.empty())
+        remaining.max_matches = options.max_matches - total.matches;
+        auto result = VisitRegion(region, pattern, visitor, remaining);
+        total.matches += result.matches;
+        if (result.stopped)
         {
-            return region.start + all.front();
+            total.stopped = true;
+            total.canceled = result.canceled;
+            break;
         }
-        return std::nullopt;
     }
-
-    std::vector<size_t> bad_char_table;
-    {
-        PROFILE_SCOPE_CUSTOM("ScanRegion.BuildBadCharTable");
-        bad_char_table = BuildBadCharTable(pattern);
-    }
-
-    std::optional<size_t> offset;
-    {
-        PROFILE_SCOPE_CUSTOM("ScanRegion.BMHSearch");
-        offset = FindPatternInBuffer(buffer.data(), buffer.size(), pattern, bad_char_table);
-    }
-
-    if (offset)
-    {
-        return region.start + *offset;
-    }
-
-    return std::nullopt;
+    return total;
 }
 
-std::vector<uintptr_t> PatternScanner::ScanRegionAll(const MemoryRegion& region, const Pattern& pattern)
+ScanVisitResult PatternScanner::VisitProcess(const Pattern& pattern, bool require_executable,
+                                             const MatchVisitor& visitor, const ScanVisitOptions& options)
 {
-    std::vector<uintptr_t> results;
-
-    if (!pattern.IsValid() || region.Size() < pattern.Size())
-    {
-        return results;
-    }
-
-    std::vector<uint8_t> buffer(region.Size());
-    if (!m_memory->ReadMemory(region.start, buffer.data(), buffer.size()))
-    {
-        return results;
-    }
-
-    auto offsets = FindPatternInBufferAll(buffer.data(), buffer.size(), pattern);
-
-    for (auto offset : offsets)
+    CostScope cost_scope(*this);
+    if (!m_memory->IsProcessAttached())
     {
-        results.push_back(region.start + offset);
+        return {};
     }
 
-    return results;
+    auto regions = MemoryRegionParser::ParseMapsFiltered(m_memory->GetAttachedPid(), true, require_executable);
+    return VisitRegions(regions, pattern, visitor, options);
 }
 
 std::optional<uintptr_t> PatternScanner::ScanProcess(const Pattern& pattern, bool require_executable)
 {
     PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
     if (!m_memory->IsProcessAttached())
     {
         return std::nullopt;
@@ -199,6 +209,14 @@ std::optional<uintptr_t> PatternScanner::ScanProcess(const Pattern& pattern, boo
         regions = MemoryRegionParser::ParseMapsFiltered(m_memory->GetAttachedPid(), true, require_executable);
     }
 
+    if (m_pool)
+    {
+        PROFILE_SCOPE_CUSTOM("ScanProcess.Parallel");
+        auto result = ParallelRegionScan::FindFirst(m_memory, m_pool, regions, pattern, &m_cost);
+        m_cost.matches += result ? 1 : 0;
+        return result;
+    }
+
     for (const auto& region : regions)
     {
         PROFILE_SCOPE_CUSTOM("ScanProcess.RegionIteration");
@@ -215,6 +233,7 @@ std::optional<uintptr_t> PatternScanner::ScanProcess(const Pattern& pattern, boo
 std::optional<uintptr_t> PatternScanner::ScanModule(const Pattern& pattern, const std::string& module_name)
 {
     PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
     if (!m_memory->IsProcessAttached())
     {
         return std::nullopt;
@@ -233,6 +252,7 @@ std::optional<uintptr_t> PatternScanner::ScanModuleWithRegions(const Pattern& pa
                                                                const std::vector<MemoryRegion>& regions)
 {
     PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
     if (!m_memory->IsProcessAttached())
     {
         return std::nullopt;
@@ -289,6 +309,7 @@ std::optional<uintptr_t> PatternScanner::ScanModuleWithRegions(const Pattern& pa
 
 std::vector<uintptr_t> PatternScanner::ScanProcessAll(const Pattern& pattern, bool require_executable)
 {
+    CostScope cost_scope(*this);
     std::vector<uintptr_t> all_results;
 
     if (!m_memory->IsProcessAttached())
@@ -298,13 +319,75 @@ std::vector<uintptr_t> PatternScanner::ScanProcessAll(const Pattern& pattern, bo
 
     auto regions = MemoryRegionParser::ParseMapsFiltered(m_memory->GetAttachedPid(), true, require_executable);
 
-    for (const auto& region : regions)
+    if (m_pool)
     {
-        auto results = ScanRegionAll(region, pattern);
-        all_results.insert(all_results.end(), results.begin(), results.end());
+        all_results = ParallelRegionScan::FindAll(m_memory, m_pool, regions, pattern, &m_cost);
+        m_cost.matches += all_results.size();
+        return all_results;
     }
 
+    VisitRegions(regions, pattern,
+                 [&all_results](uintptr_t address)
+                 {
+                     all_results.push_back(address);
+                     return true;
+                 });
     return all_results;
 }
 
+std::vector<std::optional<uintptr_t>> PatternScanner::ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                                      bool require_executable)
+{
+    PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
+    if (!m_memory->IsProcessAttached())
+    {
+        return std::vector<std::optional<uintptr_t>>(patterns.size());
+    }
+
+    std::vector<MemoryRegion> regions;
+    {
+        PROFILE_SCOPE_CUSTOM("ScanProcessMany.ParseRegions");
+        regions = MemoryRegionParser::ParseMapsFiltered(m_memory->GetAttachedPid(), true, require_executable);
+    }
+    return ScanRegionsMany(regions, patterns);
+}
+
+std::vector<std::optional<uintptr_t>> PatternScanner::ScanRegionsMany(const std::vector<MemoryRegion>& regions,
+                                                                      const std::vector<const Pattern*>& patterns)
+{
+    PROFILE_SCOPE_FUNCTION();
+    CostScope cost_scope(*this);
+    std::vector<std::optional<uintptr_t>> results(patterns.size());
+
+    MultiPatternSearch search(patterns);
+    const size_t max_pattern_size = search.MaxPatternSize();
+
+    ChunkedRegionReader reader(m_memory, m_scratch, &m_cost);
+    for (const auto& region : regions)
+    {
+        if (search.Pending() == 0)
+            break;
+        if (region.Size() < search.MinPatternSize())
+            continue;
+
+        // Overlap covers the largest pattern; smaller ones may be seen twice, which is harmless for first-match
+        reader.ForEachChunk(region.start, region.Size(), max_pattern_size - 1,
+                            [&](uintptr_t address, const uint8_t* data, size_t length, size_t)
+                            {
+                                const uint64_t scanned = search.BytesScanned();
+                                search.FindFirstEach(data, length,
+                                                     [&](size_t index, size_t offset)
+                                                     {
+                                                         results[index] = address + offset;
+                                                         ++m_cost.matches;
+                                                     });
+                                m_cost.bytes_searched += search.BytesScanned() - scanned;
+                                return search.Pending() > 0;
+                            });
+    }
+
+    return results;
+}
+
 } // namespace dqxclarity
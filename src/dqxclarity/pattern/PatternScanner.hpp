@@ -2,7 +2,12 @@
 
 #include "Pattern.hpp"
 #include "MemoryRegion.hpp"
+#include "ChunkedRegionReader.hpp"
+#include "../api/scan_stats.hpp"
 #include "../memory/IProcessMemory.hpp"
+#include "../util/ThreadPoolFwd.hpp"
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <optional>
@@ -10,11 +15,38 @@
 namespace dqxclarity
 {
 
+/**
+ * @brief Receives matches of a streaming scan; return false to stop the scan
+ */
+using MatchVisitor = std::function<bool(uintptr_t address)>;
+
+/**
+ * @brief Limits for streaming scans
+ */
+struct ScanVisitOptions
+{
+    size_t max_matches = SIZE_MAX;             // Stop after delivering this many matches
+    const std::atomic<bool>* cancel = nullptr; // Checked before every region and chunk (nullptr = never)
+};
+
+struct ScanVisitResult
+{
+    size_t matches = 0;    // Matches delivered to the visitor
+    bool stopped = false;  // Ended before the last region: visitor, match limit or cancellation
+    bool canceled = false; // The cancel flag was seen
+};
+
 class PatternScanner
 {
 public:
     explicit PatternScanner(IProcessMemory* memory);
 
+    /**
+     * @brief Scanner whose process-wide scans are split across a thread pool
+     * @param pool Worker pool for ScanProcess/ScanProcessAll (nullptr = sequential)
+     */
+    PatternScanner(IProcessMemory* memory, ScanThreadPool* pool);
+
     std::optional<uintptr_t> ScanRegion(const MemoryRegion& region, const Pattern& pattern);
 
     std::vector<uintptr_t> ScanRegionAll(const MemoryRegion& region, const Pattern& pattern);
@@ -28,15 +60,76 @@ public:
 
     std::vector<uintptr_t> ScanProcessAll(const Pattern& pattern, bool require_executable = true);
 
-private:
-    IProcessMemory* m_memory;
+    /**
+     * @brief Stream matches in a region to visitor in ascending address order
+     *
+     * Matches go straight from the read window to the visitor; nothing is
+     * collected, so memory stays at one chunk however many matches there are.
+     */
+    ScanVisitResult VisitRegion(const MemoryRegion& region, const Pattern& pattern, const MatchVisitor& visitor,
+                                const ScanVisitOptions& options = {});
+
+    /**
+     * @brief Stream matches across regions, in region order, until the visitor or options stop it
+     */
+    ScanVisitResult VisitRegions(const std::vector<MemoryRegion>& regions, const Pattern& pattern,
+                                 const MatchVisitor& visitor, const ScanVisitOptions& options = {});
+
+    /**
+     * @brief Streaming counterpart of ScanProcessAll
+     *
+     * Always runs on the calling thread so matches arrive in address order and
+     * the scan ends as soon as the consumer is satisfied.
+     */
+    ScanVisitResult VisitProcess(const Pattern& pattern, bool require_executable, const MatchVisitor& visitor,
+                                 const ScanVisitOptions& options = {});
+
+    /**
+     * @brief First match of every pattern from a single pass over the process
+     * @return results[i] is the lowest match of patterns[i]
+     */
+    std::vector<std::optional<uintptr_t>> ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                          bool require_executable = true);
+
+    /**
+     * @brief Multi-pattern pass over the given regions
+     *
+     * Each region is read once in chunks and each chunk goes through one
+     * MultiPatternSearch anchor pass for all still-unresolved patterns, so both
+     * the reads and the bytes searched depend on the regions only, not on how
+     * many patterns are searched.
+     */
+    std::vector<std::optional<uintptr_t>> ScanRegionsMany(const std::vector<MemoryRegion>& regions,
+                                                          const std::vector<const Pattern*>& patterns);
 
-    std::vector<size_t> BuildBadCharTable(const Pattern& pattern);
+    /**
+     * @brief Total bytes allocated for region reads by this scanner
+     *
+     * Regions are streamed through one reused window, so this stays at roughly
+     * one chunk no matter how many or how large the scanned regions are.
+     */
+    uint64_t ScratchBytesAllocated() const { return m_scratch.BytesAllocated(); }
 
-    std::optional<size_t> FindPatternInBuffer(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern,
-                                              const std::vector<size_t>& bad_char_table);
+    /**
+     * @brief Accumulated cost of every scan made through this scanner
+     *
+     * Each public scan call counts as one scan with its wall time; reads, ranges
+     * and matches include the work of pool threads. Callers that know which
+     * signature they scanned for take the difference around their call, or
+     * ResetCost() before it.
+     */
+    const ScanCost& Cost() const { return m_cost; }
 
-    std::vector<size_t> FindPatternInBufferAll(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern);
+    void ResetCost() { m_cost = {}; }
+
+private:
+    class CostScope;
+
+    IProcessMemory* m_memory;
+    ScanThreadPool* m_pool = nullptr;
+    ScratchBuffer m_scratch;
+    ScanCost m_cost;
+    int m_cost_depth = 0; // Nested public calls (ScanProcess -> ScanRegion) count once
 };
 
 } // namespace dqxclarity
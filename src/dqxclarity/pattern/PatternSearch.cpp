@@ -0,0 +1,356 @@
+#include "PatternSearch.hpp"
+#include "CompiledPattern.hpp"
+#include "SimdSupport.hpp"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+constexpr size_t kStopped = SIZE_MAX;
+
+inline bool Verify(const uint8_t* data, const CompiledPattern& packed)
+{
+    const size_t size = packed.bytes.size();
+    const uint8_t* bytes = packed.bytes.data();
+    const uint8_t* mask = packed.mask.data();
+    size_t j = 0;
+#ifdef DQX_SEARCH_X86_SIMD
+    for (; j + 16 <= size; j += 16)
+    {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + j));
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + j));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + j));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(d, m), b)) != 0xFFFF)
+            return false;
+    }
+#endif
+    for (; j < size; ++j)
+    {
+        if ((data[j] & mask[j]) != bytes[j])
+            return false;
+    }
+    return true;
+}
+
+// Handles the positions SIMD blocks could not cover, starting at candidate offset `begin`.
+template <typename OnMatch>
+void ScanScalar(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& packed, size_t begin,
+                OnMatch& on_match)
+{
+    const auto& anchor = packed.anchor;
+    const size_t last = buffer_size - packed.bytes.size();
+    size_t i = begin;
+    while (i <= last)
+    {
+        const void* hit = std::memchr(buffer + i + anchor.offset, anchor.first, last - i + 1);
+        if (!hit)
+            return;
+        i = static_cast<size_t>(static_cast<const uint8_t*>(hit) - buffer) - anchor.offset;
+        if ((!anchor.pair || buffer[i + anchor.offset + 1] == anchor.second) && Verify(buffer + i, packed))
+        {
+            if (!on_match(i))
+                return;
+        }
+        ++i;
+    }
+}
+
+#ifdef DQX_SEARCH_X86_SIMD
+
+// Returns the first candidate offset left for the scalar tail, or kStopped if on_match ended the search.
+template <bool Pair, typename OnMatch>
+size_t ScanSse2(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& packed, OnMatch& on_match)
+{
+    constexpr size_t kWidth = 16;
+    const size_t n = packed.bytes.size();
+    const uint8_t* anchor_ptr = buffer + packed.anchor.offset;
+    const __m128i first = _mm_set1_epi8(static_cast<char>(packed.anchor.first));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(packed.anchor.second));
+
+    size_t i = 0;
+    for (; i + kWidth + n - 1 <= buffer_size; i += kWidth)
+    {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(anchor_ptr + i)), first);
+        if constexpr (Pair)
+        {
+            eq = _mm_and_si128(
+                eq, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(anchor_ptr + i + 1)), second));
+        }
+        auto bits = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        while (bits)
+        {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (Verify(buffer + candidate, packed) && !on_match(candidate))
+                return kStopped;
+        }
+    }
+    return i;
+}
+
+template <bool Pair, typename OnMatch>
+DQX_TARGET_AVX2 size_t ScanAvx2(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& packed,
+                                OnMatch& on_match)
+{
+    constexpr size_t kWidth = 32;
+    const size_t n = packed.bytes.size();
+    const uint8_t* anchor_ptr = buffer + packed.anchor.offset;
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(packed.anchor.first));
+    const __m256i second = _mm256_set1_epi8(static_cast<char>(packed.anchor.second));
+
+    size_t i = 0;
+    for (; i + kWidth + n - 1 <= buffer_size; i += kWidth)
+    {
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(anchor_ptr + i)), first);
+        if constexpr (Pair)
+        {
+            eq = _mm256_and_si256(
+                eq,
+                _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(anchor_ptr + i + 1)), second));
+        }
+        auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (bits)
+        {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (Verify(buffer + candidate, packed) && !on_match(candidate))
+                return kStopped;
+        }
+    }
+    return i;
+}
+
+bool DetectAvx2()
+{
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // DQX_SEARCH_X86_SIMD
+
+// Horspool over the compiled skip window; every window hit is verified against the full pattern.
+template <typename OnMatch>
+void ScanSkip(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& packed, OnMatch& on_match)
+{
+    const size_t last = buffer_size - packed.Size();
+    const size_t tail = packed.skip_offset + packed.skip_length - 1;
+    const uint8_t tail_byte = packed.bytes[tail];
+    const bool tail_fixed = packed.mask[tail] != 0;
+    const auto& shift = packed.shift_table;
+
+    size_t i = 0;
+    while (i <= last)
+    {
+        const uint8_t byte = buffer[i + tail];
+        if ((!tail_fixed || byte == tail_byte) && Verify(buffer + i, packed))
+        {
+            if (!on_match(i))
+                return;
+        }
+        i += shift[byte];
+    }
+}
+
+template <typename OnMatch>
+void Search(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& packed,
+            PatternSearch::Strategy strategy, OnMatch on_match)
+{
+    if (!buffer || packed.Size() == 0 || buffer_size < packed.Size())
+        return;
+
+    if (!packed.anchor.valid)
+    {
+        // All-wildcard pattern matches everywhere
+        for (size_t i = 0; i + packed.Size() <= buffer_size; ++i)
+        {
+            if (!on_match(i))
+                return;
+        }
+        return;
+    }
+
+    if (strategy == PatternSearch::Strategy::Skip)
+    {
+        ScanSkip(buffer, buffer_size, packed, on_match);
+        return;
+    }
+
+    size_t next = 0;
+#ifndef DQX_SEARCH_X86_SIMD
+    if (strategy == PatternSearch::Strategy::Auto && packed.PrefersSkipSearch())
+    {
+        ScanSkip(buffer, buffer_size, packed, on_match);
+        return;
+    }
+#else
+    if (PatternSearch::HasAvx2())
+    {
+        next = packed.anchor.pair ? ScanAvx2<true>(buffer, buffer_size, packed, on_match)
+                                  : ScanAvx2<false>(buffer, buffer_size, packed, on_match);
+    }
+    else
+    {
+        next = packed.anchor.pair ? ScanSse2<true>(buffer, buffer_size, packed, on_match)
+                                  : ScanSse2<false>(buffer, buffer_size, packed, on_match);
+    }
+    if (next == kStopped)
+        return;
+#endif
+    ScanScalar(buffer, buffer_size, packed, next, on_match);
+}
+
+// Patterns from FromString/FromBytes carry their compiled form; hand-built ones are compiled per call.
+template <typename Fn>
+void WithCompiled(const Pattern& pattern, Fn&& fn)
+{
+    if (!pattern.IsValid())
+        return;
+    if (pattern.compiled)
+    {
+        fn(*pattern.compiled);
+        return;
+    }
+    const CompiledPattern compiled = CompiledPattern::FromPattern(pattern);
+    fn(compiled);
+}
+
+} // namespace
+
+PatternSearch::Anchor PatternSearch::SelectAnchor(const Pattern& pattern)
+{
+    if (!pattern.IsValid())
+        return Anchor{};
+    return SelectPatternAnchor(pattern.bytes, pattern.mask, pattern.Size());
+}
+
+size_t PatternSearch::FindFirst(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                                Strategy strategy)
+{
+    if (strategy == Strategy::Auto && pattern.specialized_find_first)
+        return pattern.specialized_find_first(buffer, buffer_size);
+
+    size_t result = kNotFound;
+    Search(buffer, buffer_size, pattern, strategy,
+           [&result](size_t offset)
+           {
+               result = offset;
+               return false;
+           });
+    return result;
+}
+
+void PatternSearch::FindAll(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                            std::vector<size_t>& out, Strategy strategy)
+{
+    Search(buffer, buffer_size, pattern, strategy,
+           [&out](size_t offset)
+           {
+               out.push_back(offset);
+               return true;
+           });
+}
+
+bool PatternSearch::ForEachMatch(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                                 const std::function<bool(size_t)>& on_match, Strategy strategy)
+{
+    bool completed = true;
+    Search(buffer, buffer_size, pattern, strategy,
+           [&](size_t offset)
+           {
+               completed = on_match(offset);
+               return completed;
+           });
+    return completed;
+}
+
+size_t PatternSearch::FindFirst(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern)
+{
+    size_t result = kNotFound;
+    WithCompiled(pattern,
+                 [&](const CompiledPattern& compiled)
+                 {
+                     result = FindFirst(buffer, buffer_size, compiled);
+                 });
+    return result;
+}
+
+void PatternSearch::FindAll(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern,
+                            std::vector<size_t>& out)
+{
+    WithCompiled(pattern,
+                 [&](const CompiledPattern& compiled)
+                 {
+                     FindAll(buffer, buffer_size, compiled, out);
+                 });
+}
+
+bool PatternSearch::ForEachMatch(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern,
+                                 const std::function<bool(size_t)>& on_match)
+{
+    bool completed = true;
+    WithCompiled(pattern,
+                 [&](const CompiledPattern& compiled)
+                 {
+                     completed = ForEachMatch(buffer, buffer_size, compiled, on_match);
+                 });
+    return completed;
+}
+
+bool PatternSearch::MatchesAt(const uint8_t* data, const CompiledPattern& pattern)
+{
+    return Verify(data, pattern);
+}
+
+size_t PatternSearch::FindFirstScalar(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern)
+{
+    if (!buffer || !pattern.IsValid() || buffer_size < pattern.Size())
+        return kNotFound;
+
+    for (size_t i = 0; i <= buffer_size - pattern.Size(); ++i)
+    {
+        bool match = true;
+        for (size_t j = 0; j < pattern.Size(); ++j)
+        {
+            if (pattern.mask[j] && buffer[i + j] != pattern.bytes[j])
+            {
+                match = false;
+                break;
+            }
+        }
+        if (match)
+            return i;
+    }
+    return kNotFound;
+}
+
+bool PatternSearch::HasAvx2()
+{
+#ifdef DQX_SEARCH_X86_SIMD
+    static const bool supported = DetectAvx2();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Pattern.hpp"
+#include "CompiledPattern.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Wildcard-aware buffer search kernel shared by all scanners
+ *
+ * Picks the rarest fixed byte (or adjacent fixed byte pair) of a pattern as an
+ * anchor, locates anchor candidates with SSE2/AVX2 compares and verifies each
+ * candidate against the packed pattern mask. Falls back to a memchr-driven
+ * scalar loop on targets without SIMD support.
+ *
+ * Without SIMD, patterns whose compiled skip window allows long Horspool
+ * shifts are searched with the shift table instead.
+ */
+class PatternSearch
+{
+public:
+    static constexpr size_t kNotFound = SIZE_MAX;
+
+    using Anchor = PatternAnchor;
+
+    /**
+     * @brief Search loop selection (Auto: SIMD anchor scan, Horspool on non-SIMD builds when worthwhile)
+     */
+    enum class Strategy
+    {
+        Auto,
+        Anchor,
+        Skip,
+    };
+
+    /**
+     * @brief Select the least common fixed byte/byte pair of a pattern
+     */
+    static Anchor SelectAnchor(const Pattern& pattern);
+
+    /**
+     * @brief Find the first match of a pattern in a buffer
+     * @return Offset of the first match, or kNotFound
+     */
+    static size_t FindFirst(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                            Strategy strategy = Strategy::Auto);
+
+    /**
+     * @brief Append offsets of all (possibly overlapping) matches to out
+     */
+    static void FindAll(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                        std::vector<size_t>& out, Strategy strategy = Strategy::Auto);
+
+    /**
+     * @brief Report matches in ascending order until on_match returns false
+     * @return false if on_match stopped the search
+     */
+    static bool ForEachMatch(const uint8_t* buffer, size_t buffer_size, const CompiledPattern& pattern,
+                             const std::function<bool(size_t)>& on_match, Strategy strategy = Strategy::Auto);
+
+    /**
+     * @brief Convenience overloads using pattern.compiled (compiled per call if absent)
+     */
+    static size_t FindFirst(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern);
+
+    static void FindAll(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern, std::vector<size_t>& out);
+
+    static bool ForEachMatch(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern,
+                             const std::function<bool(size_t)>& on_match);
+
+    /**
+     * @brief True if the pattern matches at data (caller guarantees pattern.Size() readable bytes)
+     */
+    static bool MatchesAt(const uint8_t* data, const CompiledPattern& pattern);
+
+    /**
+     * @brief Plain byte-by-byte reference search (no anchor, no SIMD)
+     *
+     * Kept for tests and benchmarks as the baseline the kernel must agree with.
+     */
+    static size_t FindFirstScalar(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern);
+
+    /**
+     * @brief True if the AVX2 path is compiled in and supported by the running CPU
+     */
+    static bool HasAvx2();
+};
+
+} // namespace dqxclarity
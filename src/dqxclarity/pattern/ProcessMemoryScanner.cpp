@@ -33,4 +33,16 @@ std::vector<uintptr_t> ProcessMemoryScanner::ScanProcessAll(const Pattern& patte
     return scanner.ScanProcessAll(pattern, require_executable);
 }
 
+std::vector<std::optional<uintptr_t>> ProcessMemoryScanner::ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                                            bool require_executable)
+{
+    if (!memory_ || !memory_->IsProcessAttached())
+    {
+        return std::vector<std::optional<uintptr_t>>(patterns.size());
+    }
+
+    PatternScanner scanner(memory_);
+    return scanner.ScanProcessMany(patterns, require_executable);
+}
+
 } // namespace dqxclarity
@@ -0,0 +1,446 @@
+#include "RegionMap.hpp"
+
+#include "../util/Profile.hpp"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+constexpr size_t kInitialMapsBuffer = 64 * 1024;
+// Interned pathnames are rebuilt from the live entries once dead ones outnumber them this much
+constexpr size_t kPathCompactionFactor = 4;
+constexpr size_t kMinPathsBeforeCompaction = 256;
+
+bool ParseHex(std::string_view& text, uintptr_t& value)
+{
+    value = 0;
+    size_t i = 0;
+    for (; i < text.size(); ++i)
+    {
+        const char c = text[i];
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            break;
+        value = (value << 4) | static_cast<uintptr_t>(digit);
+    }
+    text.remove_prefix(i);
+    return i > 0;
+}
+
+void SkipField(std::string_view& text)
+{
+    while (!text.empty() && text.front() == ' ')
+        text.remove_prefix(1);
+    while (!text.empty() && text.front() != ' ')
+        text.remove_prefix(1);
+}
+
+bool ContainsCaseInsensitive(std::string_view haystack, std::string_view needle)
+{
+    auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+                          [](char a, char b)
+                          {
+                              return std::tolower(static_cast<unsigned char>(a)) ==
+                                     std::tolower(static_cast<unsigned char>(b));
+                          });
+    return it != haystack.end();
+}
+
+bool IsModulePath(std::string_view path) { return !path.empty() && path.front() != '['; }
+
+} // namespace
+
+RegionMap::RegionMap(pid_t pid)
+    : pid_(pid)
+{
+    paths_.emplace_back();
+    path_ids_.emplace(std::string(), 0);
+}
+
+bool RegionMap::ParseLine(std::string_view line, Entry& entry, std::string_view& path)
+{
+    // 00400000-00452000 r-xp 00000000 08:02 173521      /usr/bin/dbus-daemon
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    if (!ParseHex(line, start) || line.empty() || line.front() != '-')
+        return false;
+    line.remove_prefix(1);
+    if (!ParseHex(line, end) || line.size() < 5 || line.front() != ' ')
+        return false;
+
+    int protection = 0;
+    if (line[1] == 'r')
+        protection |= static_cast<int>(MemoryProtection::Read);
+    if (line[2] == 'w')
+        protection |= static_cast<int>(MemoryProtection::Write);
+    if (line[3] == 'x')
+        protection |= static_cast<int>(MemoryProtection::Execute);
+    line.remove_prefix(5);
+
+    SkipField(line); // offset
+    SkipField(line); // dev
+    SkipField(line); // inode
+    while (!line.empty() && line.front() == ' ')
+        line.remove_prefix(1);
+
+    entry.start = start;
+    entry.end = end;
+    entry.protection = protection;
+    path = line;
+    return true;
+}
+
+uint32_t RegionMap::InternPath(std::string_view path)
+{
+    auto it = path_ids_.find(path);
+    if (it != path_ids_.end())
+        return it->second;
+
+    const auto id = static_cast<uint32_t>(paths_.size());
+    paths_.emplace_back(path);
+    path_ids_.emplace(paths_.back(), id);
+    return id;
+}
+
+void RegionMap::ParseInto(std::string_view maps_text, std::vector<Entry>& out)
+{
+    out.clear();
+    while (!maps_text.empty())
+    {
+        const size_t newline = maps_text.find('\n');
+        const std::string_view line = maps_text.substr(0, newline);
+        maps_text.remove_prefix(newline == std::string_view::npos ? maps_text.size() : newline + 1);
+
+        Entry entry;
+        std::string_view path;
+        if (!ParseLine(line, entry, path))
+            continue;
+        entry.path_id = InternPath(path);
+        out.push_back(entry);
+    }
+    // The kernel emits mappings in address order; keep the invariant for other sources
+    if (!std::is_sorted(out.begin(), out.end(),
+                        [](const Entry& a, const Entry& b)
+                        {
+                            return a.start < b.start;
+                        }))
+    {
+        std::sort(out.begin(), out.end(),
+                  [](const Entry& a, const Entry& b)
+                  {
+                      return a.start < b.start;
+                  });
+    }
+}
+
+bool RegionMap::Refresh()
+{
+    PROFILE_SCOPE_FUNCTION();
+    std::unique_lock lock(mutex_);
+    last_refresh_ = std::chrono::steady_clock::now();
+
+#ifdef _WIN32
+    LoadRegions(MemoryRegionParser::ParseMaps(pid_), next_);
+    if (next_.empty())
+        return false;
+#else
+    // Snapshot replays register their stored maps under a synthetic pid
+    std::vector<MemoryRegion> registered;
+    if (MemoryRegionParser::FindRegisteredMaps(pid_, registered))
+    {
+        LoadRegions(registered, next_);
+        Commit();
+        return true;
+    }
+
+    const std::string path = "/proc/" + std::to_string(pid_) + "/maps";
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    if (text_.size() < kInitialMapsBuffer)
+        text_.resize(kInitialMapsBuffer);
+    size_t length = 0;
+    for (;;)
+    {
+        if (length == text_.size())
+            text_.resize(text_.size() * 2);
+        const ssize_t n = ::read(fd, text_.data() + length, text_.size() - length);
+        if (n < 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        if (n == 0)
+            break;
+        length += static_cast<size_t>(n);
+    }
+    ::close(fd);
+
+    ParseInto(std::string_view(text_.data(), length), next_);
+#endif
+
+    Commit();
+    return true;
+}
+
+bool RegionMap::RefreshIfStale(std::chrono::milliseconds max_age)
+{
+    {
+        std::shared_lock lock(mutex_);
+        if (generation_ > 0 && std::chrono::steady_clock::now() - last_refresh_ < max_age)
+            return true;
+    }
+    return Refresh();
+}
+
+void RegionMap::Update(std::string_view maps_text)
+{
+    std::unique_lock lock(mutex_);
+    last_refresh_ = std::chrono::steady_clock::now();
+    ParseInto(maps_text, next_);
+    Commit();
+}
+
+void RegionMap::LoadRegions(const std::vector<MemoryRegion>& regions, std::vector<Entry>& out)
+{
+    out.clear();
+    for (const auto& region : regions)
+    {
+        Entry entry;
+        entry.start = region.start;
+        entry.end = region.end;
+        entry.protection = region.protection;
+        entry.path_id = InternPath(region.pathname);
+        out.push_back(entry);
+    }
+}
+
+void RegionMap::Commit()
+{
+    // Merge-walk both sorted snapshots; most refreshes change nothing or a handful of heap mappings
+    Diff diff;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < entries_.size() || j < next_.size())
+    {
+        if (j == next_.size() || (i < entries_.size() && entries_[i].start < next_[j].start))
+        {
+            ++diff.removed;
+            ++i;
+        }
+        else if (i == entries_.size() || next_[j].start < entries_[i].start)
+        {
+            ++diff.added;
+            ++j;
+        }
+        else
+        {
+            if (!entries_[i].SameMapping(next_[j]))
+                ++diff.changed;
+            ++i;
+            ++j;
+        }
+    }
+
+    last_diff_ = diff;
+    if (diff.Empty() && generation_ > 0)
+        return;
+
+    entries_.swap(next_);
+    CompactPaths();
+    AttributeModules();
+    ++generation_;
+}
+
+void RegionMap::CompactPaths()
+{
+    // Transient mappings (Wine temp files, deleted shm segments) would otherwise grow the table for the whole session
+    if (paths_.size() <= (std::max)(kMinPathsBeforeCompaction, kPathCompactionFactor * entries_.size()))
+        return;
+
+    std::vector<uint32_t> remap(paths_.size(), UINT32_MAX);
+    std::vector<std::string> paths;
+    paths.emplace_back();
+    remap[0] = 0;
+    for (auto& entry : entries_)
+    {
+        uint32_t& id = remap[entry.path_id];
+        if (id == UINT32_MAX)
+        {
+            id = static_cast<uint32_t>(paths.size());
+            paths.push_back(std::move(paths_[entry.path_id]));
+        }
+        entry.path_id = id;
+    }
+
+    paths_ = std::move(paths);
+    path_ids_.clear();
+    for (uint32_t id = 0; id < paths_.size(); ++id)
+        path_ids_.emplace(paths_[id], id);
+    next_.clear(); // Holds ids from the old table
+}
+
+void RegionMap::AttributeModules()
+{
+    struct Extent
+    {
+        uintptr_t start;
+        uintptr_t end;
+        uint32_t path_id;
+    };
+
+    std::vector<Extent> extents(paths_.size(), Extent{ UINTPTR_MAX, 0, 0 });
+    for (const auto& entry : entries_)
+    {
+        if (!IsModulePath(paths_[entry.path_id]))
+            continue;
+        auto& extent = extents[entry.path_id];
+        extent.start = (std::min)(extent.start, entry.start);
+        extent.end = (std::max)(extent.end, entry.end);
+        extent.path_id = entry.path_id;
+    }
+    extents.erase(std::remove_if(extents.begin(), extents.end(),
+                                 [](const Extent& e)
+                                 {
+                                     return e.end == 0;
+                                 }),
+                  extents.end());
+    std::sort(extents.begin(), extents.end(),
+              [](const Extent& a, const Extent& b)
+              {
+                  return a.start < b.start;
+              });
+
+    for (auto& entry : entries_)
+    {
+        entry.module_id = 0;
+        if (IsModulePath(paths_[entry.path_id]))
+        {
+            entry.module_id = entry.path_id;
+            continue;
+        }
+        if (entry.path_id != 0)
+            continue; // [heap], [stack], ...
+
+        auto it = std::upper_bound(extents.begin(), extents.end(), entry.start,
+                                   [](uintptr_t address, const Extent& e)
+                                   {
+                                       return address < e.start;
+                                   });
+        if (it != extents.begin() && entry.start < std::prev(it)->end)
+            entry.module_id = std::prev(it)->path_id;
+    }
+}
+
+MemoryRegion RegionMap::ToRegion(const Entry& entry) const
+{
+    const uint32_t name = entry.module_id != 0 ? entry.module_id : entry.path_id;
+    return MemoryRegion{ entry.start, entry.end, entry.protection, paths_[name] };
+}
+
+bool RegionMap::Matches(const Entry& entry, RegionFilter filter)
+{
+    const bool readable = (entry.protection & static_cast<int>(MemoryProtection::Read)) != 0;
+    const bool executable = (entry.protection & static_cast<int>(MemoryProtection::Execute)) != 0;
+    switch (filter)
+    {
+    case RegionFilter::All:
+        return true;
+    case RegionFilter::Readable:
+        return readable;
+    case RegionFilter::Executable:
+        return readable && executable;
+    case RegionFilter::NonExecutable:
+        return readable && !executable;
+    }
+    return false;
+}
+
+std::optional<MemoryRegion> RegionMap::Find(uintptr_t address) const
+{
+    std::shared_lock lock(mutex_);
+    auto it = std::upper_bound(entries_.begin(), entries_.end(), address,
+                               [](uintptr_t value, const Entry& e)
+                               {
+                                   return value < e.start;
+                               });
+    if (it == entries_.begin())
+        return std::nullopt;
+    --it;
+    if (address >= it->end)
+        return std::nullopt;
+    return ToRegion(*it);
+}
+
+std::vector<MemoryRegion> RegionMap::Regions(RegionFilter filter) const
+{
+    std::shared_lock lock(mutex_);
+    std::vector<MemoryRegion> regions;
+    regions.reserve(entries_.size());
+    for (const auto& entry : entries_)
+    {
+        if (Matches(entry, filter))
+            regions.push_back(ToRegion(entry));
+    }
+    return regions;
+}
+
+std::optional<std::pair<uintptr_t, uintptr_t>> RegionMap::ModuleRange(std::string_view module_name) const
+{
+    std::shared_lock lock(mutex_);
+    uintptr_t start = UINTPTR_MAX;
+    uintptr_t end = 0;
+    for (const auto& entry : entries_)
+    {
+        if (entry.module_id == 0 || !ContainsCaseInsensitive(paths_[entry.module_id], module_name))
+            continue;
+        start = (std::min)(start, entry.start);
+        end = (std::max)(end, entry.end);
+    }
+    if (end == 0)
+        return std::nullopt;
+    return std::make_pair(start, end);
+}
+
+uint64_t RegionMap::Generation() const
+{
+    std::shared_lock lock(mutex_);
+    return generation_;
+}
+
+RegionMap::Diff RegionMap::LastDiff() const
+{
+    std::shared_lock lock(mutex_);
+    return last_diff_;
+}
+
+size_t RegionMap::Size() const
+{
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+}
+
+size_t RegionMap::InternedPaths() const
+{
+    std::shared_lock lock(mutex_);
+    return paths_.size();
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "MemoryRegion.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Region subsets scanners ask for
+ */
+enum class RegionFilter
+{
+    All,
+    Readable,      // r--, rw-, r-x, ...
+    Executable,    // readable and executable
+    NonExecutable, // readable but not executable
+};
+
+/**
+ * @brief Live, sorted index of a process's memory mappings
+ *
+ * Shared by all scanners of an Engine. Refresh() re-reads /proc/pid/maps into a
+ * reused buffer and parses it in place (no per-line allocation; a string is only
+ * created the first time a pathname is seen), then diffs the result against the
+ * previous snapshot. Module attribution is recomputed only when the map changed.
+ *
+ * Anonymous mappings that lie inside a module's extent (Wine maps PE sections
+ * such as .bss anonymously) are attributed to that module, matching what
+ * MemoryRegionParser reports via libmem.
+ *
+ * All queries are safe to call concurrently with Refresh().
+ */
+class RegionMap
+{
+public:
+    /**
+     * @brief What changed during the last refresh
+     */
+    struct Diff
+    {
+        size_t added = 0;
+        size_t removed = 0;
+        size_t changed = 0; ///< Same start address, different end or protection
+
+        bool Empty() const { return added == 0 && removed == 0 && changed == 0; }
+    };
+
+    explicit RegionMap(pid_t pid);
+
+    /**
+     * @brief Re-read the process mappings
+     * @return false if the mappings could not be read (process gone)
+     */
+    bool Refresh();
+
+    /**
+     * @brief Refresh only if the last refresh is older than max_age
+     *
+     * Lets every scanner that hits its slow path in the same tick share one read.
+     */
+    bool RefreshIfStale(std::chrono::milliseconds max_age);
+
+    /**
+     * @brief Replace the snapshot with the contents of a maps file
+     */
+    void Update(std::string_view maps_text);
+
+    /**
+     * @brief Region containing address, in O(log n)
+     */
+    std::optional<MemoryRegion> Find(uintptr_t address) const;
+
+    /**
+     * @brief Regions matching filter, in ascending address order
+     */
+    std::vector<MemoryRegion> Regions(RegionFilter filter = RegionFilter::All) const;
+
+    /**
+     * @brief Address range spanned by a module (case-insensitive substring match on its path)
+     */
+    std::optional<std::pair<uintptr_t, uintptr_t>> ModuleRange(std::string_view module_name) const;
+
+    /**
+     * @brief Incremented whenever a refresh changes the map
+     */
+    uint64_t Generation() const;
+
+    Diff LastDiff() const;
+
+    size_t Size() const;
+
+    /**
+     * @brief Distinct pathnames currently interned; compacted on refresh so it stays proportional to Size()
+     */
+    size_t InternedPaths() const;
+
+private:
+    struct Entry
+    {
+        uintptr_t start = 0;
+        uintptr_t end = 0;
+        int protection = 0;
+        uint32_t path_id = 0;   // Raw pathname from the maps line (0 = anonymous)
+        uint32_t module_id = 0; // Owning module's path (0 = none)
+
+        bool SameMapping(const Entry& other) const
+        {
+            return start == other.start && end == other.end && protection == other.protection &&
+                   path_id == other.path_id;
+        }
+    };
+
+    struct PathHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+    };
+
+    static bool ParseLine(std::string_view line, Entry& entry, std::string_view& path);
+
+    uint32_t InternPath(std::string_view path);
+    void ParseInto(std::string_view maps_text, std::vector<Entry>& out);
+    void LoadRegions(const std::vector<MemoryRegion>& regions, std::vector<Entry>& out);
+    void Commit();
+    void CompactPaths();
+    void AttributeModules();
+    MemoryRegion ToRegion(const Entry& entry) const;
+    static bool Matches(const Entry& entry, RegionFilter filter);
+
+    pid_t pid_;
+    mutable std::shared_mutex mutex_;
+
+    std::vector<Entry> entries_; // sorted by start
+    std::vector<Entry> next_;    // parse target, swapped with entries_ on commit
+    std::vector<std::string> paths_;
+    std::unordered_map<std::string, uint32_t, PathHash, std::equal_to<>> path_ids_;
+    std::string text_;
+
+    uint64_t generation_ = 0;
+    Diff last_diff_;
+    std::chrono::steady_clock::time_point last_refresh_{};
+};
+
+} // namespace dqxclarity
@@ -0,0 +1,75 @@
+#include "ScanStats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace dqxclarity
+{
+
+void ScanStatsRegistry::RecordStartup(const std::string& signature, const ScanCost& cost)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& report = reports_[signature];
+    report.signature = signature;
+    report.startup += cost;
+}
+
+void ScanStatsRegistry::RecordTick(const std::string& signature, const ScanCost& cost)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& report = reports_[signature];
+    report.signature = signature;
+    report.steady += cost;
+    report.last_tick = cost;
+    ++report.ticks;
+}
+
+std::vector<SignatureScanReport> ScanStatsRegistry::Snapshot() const
+{
+    std::vector<SignatureScanReport> reports;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reports.reserve(reports_.size());
+        for (const auto& [name, report] : reports_)
+            reports.push_back(report);
+    }
+    std::stable_sort(reports.begin(), reports.end(),
+                     [](const SignatureScanReport& a, const SignatureScanReport& b)
+                     {
+                         return a.startup.wall_time + a.steady.wall_time > b.startup.wall_time + b.steady.wall_time;
+                     });
+    return reports;
+}
+
+void ScanStatsRegistry::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reports_.clear();
+}
+
+std::string FormatScanReport(const std::vector<SignatureScanReport>& reports)
+{
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-22s %5s %10s %8s %8s %10s | %6s %10s %8s %10s %9s\n", "signature", "scans",
+                  "start_ms", "regions", "reads", "start_KB", "ticks", "steady_ms", "reads", "steady_KB", "tick_us");
+    out += line;
+    for (const auto& r : reports)
+    {
+        const uint64_t tick_us =
+            r.ticks > 0 ? static_cast<uint64_t>(r.steady.wall_time.count()) / r.ticks : uint64_t{ 0 };
+        std::snprintf(line, sizeof(line), "%-22s %5llu %10.2f %8llu %8llu %10llu | %6llu %10.2f %8llu %10llu %9llu\n",
+                      r.signature.c_str(), static_cast<unsigned long long>(r.startup.scans + r.steady.scans),
+                      r.startup.wall_time.count() / 1000.0, static_cast<unsigned long long>(r.startup.regions_visited),
+                      static_cast<unsigned long long>(r.startup.read_calls),
+                      static_cast<unsigned long long>(r.startup.bytes_read / 1024),
+                      static_cast<unsigned long long>(r.ticks), r.steady.wall_time.count() / 1000.0,
+                      static_cast<unsigned long long>(r.steady.read_calls),
+                      static_cast<unsigned long long>(r.steady.bytes_read / 1024),
+                      static_cast<unsigned long long>(tick_us));
+        out += line;
+    }
+    return out;
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../api/scan_stats.hpp"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Adds the elapsed wall time to a ScanCost when it goes out of scope
+ */
+class ScanCostTimer
+{
+public:
+    explicit ScanCostTimer(ScanCost& cost)
+        : cost_(cost)
+        , start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScanCostTimer()
+    {
+        cost_.wall_time +=
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+    }
+
+    ScanCostTimer(const ScanCostTimer&) = delete;
+    ScanCostTimer& operator=(const ScanCostTimer&) = delete;
+
+private:
+    ScanCost& cost_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Per-signature scan costs collected from every scanner of an Engine
+ *
+ * Scanners record their initialization as startup cost and every Poll() as one
+ * tick; one-off multi-signature passes (hook resolution) are recorded as startup
+ * cost under a single name. Thread-safe.
+ */
+class ScanStatsRegistry
+{
+public:
+    void RecordStartup(const std::string& signature, const ScanCost& cost);
+
+    void RecordTick(const std::string& signature, const ScanCost& cost);
+
+    /**
+     * @brief Reports sorted by total wall time, most expensive first
+     */
+    std::vector<SignatureScanReport> Snapshot() const;
+
+    void Reset();
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, SignatureScanReport> reports_;
+};
+
+/**
+ * @brief Fixed-width text table of reports, one line per signature
+ */
+std::string FormatScanReport(const std::vector<SignatureScanReport>& reports);
+
+} // namespace dqxclarity
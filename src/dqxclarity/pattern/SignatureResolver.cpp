@@ -0,0 +1,177 @@
+#include "SignatureResolver.hpp"
+#include "MultiPatternSearch.hpp"
+#include "ChunkedRegionReader.hpp"
+#include "../signatures/SignatureCache.hpp"
+
+#include "../util/Profile.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace dqxclarity
+{
+
+static std::string ToLowerCase(const std::string& str)
+{
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c)
+                   {
+                       return static_cast<char>(std::tolower(c));
+                   });
+    return result;
+}
+
+void ResolvedSignatures::Set(const std::string& name, const Pattern& pattern, uintptr_t address)
+{
+    entries_[name] = Entry{ pattern, address };
+}
+
+std::optional<uintptr_t> ResolvedSignatures::Find(const std::string& name) const
+{
+    auto it = entries_.find(name);
+    if (it == entries_.end())
+        return std::nullopt;
+    return it->second.address;
+}
+
+std::optional<uintptr_t> ResolvedSignatures::Lookup(const Pattern& pattern) const
+{
+    for (const auto& [name, entry] : entries_)
+    {
+        if (entry.pattern.bytes == pattern.bytes && entry.pattern.mask == pattern.mask)
+            return entry.address;
+    }
+    return std::nullopt;
+}
+
+std::unordered_map<std::string, uintptr_t> ResolvedSignatures::Addresses() const
+{
+    std::unordered_map<std::string, uintptr_t> result;
+    for (const auto& [name, entry] : entries_)
+        result[name] = entry.address;
+    return result;
+}
+
+SignatureResolver::SignatureResolver(IProcessMemory* memory)
+    : memory_(memory)
+{
+}
+
+ResolvedSignatures SignatureResolver::Resolve(const std::vector<NamedPattern>& signatures,
+                                              const std::string& module_name,
+                                              const std::vector<MemoryRegion>& regions)
+{
+    last_cost_ = {};
+    ScanCostTimer timer(last_cost_);
+    return ScanModule(signatures, module_name, regions, last_cost_);
+}
+
+ResolvedSignatures SignatureResolver::ScanModule(const std::vector<NamedPattern>& signatures,
+                                                 const std::string& module_name,
+                                                 const std::vector<MemoryRegion>& regions, ScanCost& cost)
+{
+    PROFILE_SCOPE_FUNCTION();
+    ResolvedSignatures resolved;
+    if (!memory_ || !memory_->IsProcessAttached())
+        return resolved;
+
+    std::vector<const Pattern*> patterns;
+    patterns.reserve(signatures.size());
+    for (const auto& signature : signatures)
+        patterns.push_back(&signature.second);
+    MultiPatternSearch search(patterns);
+    const size_t max_pattern_size = search.MaxPatternSize();
+    cost.scans += search.Pending();
+
+    const std::string module_name_lower = ToLowerCase(module_name);
+    ScratchBuffer scratch;
+    ChunkedRegionReader reader(memory_, scratch, &cost);
+
+    for (const auto& region : regions)
+    {
+        if (search.Pending() == 0)
+            break;
+
+        if (!region.IsReadable() || region.Size() > kMaxRegionSize || region.Size() < max_pattern_size)
+            continue;
+        if (ToLowerCase(region.pathname).find(module_name_lower) == std::string::npos)
+            continue;
+
+        PROFILE_SCOPE_CUSTOM("SignatureResolver.MatchRegion");
+        reader.ForEachChunk(region.start, region.Size(), max_pattern_size - 1,
+                            [&](uintptr_t address, const uint8_t* data, size_t length, size_t)
+                            {
+                                const uint64_t scanned = search.BytesScanned();
+                                search.FindFirstEach(data, length,
+                                                     [&](size_t index, size_t offset)
+                                                     {
+                                                         const auto& [name, pattern] = signatures[index];
+                                                         resolved.Set(name, pattern, address + offset);
+                                                         ++cost.matches;
+                                                     });
+                                cost.bytes_searched += search.BytesScanned() - scanned;
+                                return search.Pending() > 0;
+                            });
+    }
+
+    return resolved;
+}
+
+ResolvedSignatures SignatureResolver::Resolve(const std::vector<NamedPattern>& signatures,
+                                              const std::string& module_name,
+                                              const std::vector<MemoryRegion>& regions, SignatureCache& cache)
+{
+    PROFILE_SCOPE_FUNCTION();
+    last_cache_hits_ = 0;
+    last_cost_ = {};
+    ScanCostTimer timer(last_cost_);
+    if (!memory_ || !memory_->IsProcessAttached())
+        return {};
+
+    uintptr_t base = 0;
+    auto identity = SignatureCache::IdentifyModule(*memory_, module_name, regions, base);
+    if (!identity)
+        return ScanModule(signatures, module_name, regions, last_cost_);
+
+    ResolvedSignatures resolved;
+    std::vector<NamedPattern> misses;
+    {
+        PROFILE_SCOPE_CUSTOM("SignatureResolver.ValidateCache");
+        for (const auto& [name, pattern] : signatures)
+        {
+            auto offset = cache.Get(*identity, name);
+            last_cost_.read_calls += offset ? 1 : 0;
+            if (offset && SignatureCache::Validate(*memory_, base + *offset, pattern))
+            {
+                resolved.Set(name, pattern, base + *offset);
+                ++last_cache_hits_;
+                ++last_cost_.scans;
+                ++last_cost_.matches;
+                last_cost_.bytes_read += pattern.Size();
+            }
+            else
+            {
+                misses.emplace_back(name, pattern);
+            }
+        }
+    }
+
+    if (misses.empty())
+        return resolved;
+
+    auto scanned = ScanModule(misses, module_name, regions, last_cost_);
+    for (const auto& [name, pattern] : misses)
+    {
+        auto address = scanned.Find(name);
+        if (!address || *address < base)
+            continue;
+        resolved.Set(name, pattern, *address);
+        cache.Put(*identity, name, static_cast<uint32_t>(*address - base));
+    }
+    if (cache.IsDirty())
+        cache.Save();
+
+    return resolved;
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Pattern.hpp"
+#include "MemoryRegion.hpp"
+#include "ScanStats.hpp"
+#include "../memory/IProcessMemory.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dqxclarity
+{
+
+class SignatureCache;
+
+/**
+ * @brief Result of a multi-signature resolve: signature name → address
+ *
+ * Entries keep the pattern they were resolved for so consumers that only know
+ * their Pattern (e.g. HookBase::GetSignature()) can look the address up.
+ */
+class ResolvedSignatures
+{
+public:
+    void Set(const std::string& name, const Pattern& pattern, uintptr_t address);
+
+    /**
+     * @brief Address resolved for a signature name
+     */
+    std::optional<uintptr_t> Find(const std::string& name) const;
+
+    /**
+     * @brief Address resolved for a pattern with identical bytes and mask
+     */
+    std::optional<uintptr_t> Lookup(const Pattern& pattern) const;
+
+    size_t Size() const { return entries_.size(); }
+    bool Empty() const { return entries_.empty(); }
+
+    /**
+     * @brief All resolved names and addresses
+     */
+    std::unordered_map<std::string, uintptr_t> Addresses() const;
+
+private:
+    struct Entry
+    {
+        Pattern pattern;
+        uintptr_t address = 0;
+    };
+
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+/**
+ * @brief Resolves a whole signature table against a module in a single pass
+ *
+ * Each candidate region is streamed from the target once and every window goes
+ * through a single MultiPatternSearch anchor pass that matches all unresolved
+ * signatures at once, so cost scales with image size rather than with
+ * image size × signature count. Region selection and first-match semantics are
+ * the same as PatternScanner::ScanModuleWithRegions.
+ */
+class SignatureResolver
+{
+public:
+    using NamedPattern = std::pair<std::string, Pattern>;
+
+    explicit SignatureResolver(IProcessMemory* memory);
+
+    /**
+     * @brief Resolve all signatures inside a module
+     * @param signatures Name/pattern pairs to resolve
+     * @param module_name Module to restrict the scan to (case-insensitive pathname match)
+     * @param regions Pre-parsed memory regions of the target
+     * @return Addresses of every signature that was found
+     */
+    ResolvedSignatures Resolve(const std::vector<NamedPattern>& signatures, const std::string& module_name,
+                               const std::vector<MemoryRegion>& regions);
+
+    /**
+     * @brief Resolve with a persistent offset cache in front of the scan
+     *
+     * Cached offsets recorded for the same module identity are validated by reading
+     * pattern.Size() bytes each; only misses go through the single-pass scan, and
+     * their results are written back to the cache.
+     */
+    ResolvedSignatures Resolve(const std::vector<NamedPattern>& signatures, const std::string& module_name,
+                               const std::vector<MemoryRegion>& regions, SignatureCache& cache);
+
+    /**
+     * @brief Number of signatures served from the cache by the last cached Resolve
+     */
+    size_t LastCacheHits() const { return last_cache_hits_; }
+
+    /**
+     * @brief Cost of the last Resolve: one scan per signature, cache validations included
+     *
+     * Signatures share their reads, so the cost is only meaningful for the whole table.
+     */
+    const ScanCost& LastCost() const { return last_cost_; }
+
+private:
+    static constexpr size_t kMaxRegionSize = 10 * 1024 * 1024;
+
+    ResolvedSignatures ScanModule(const std::vector<NamedPattern>& signatures, const std::string& module_name,
+                                  const std::vector<MemoryRegion>& regions, ScanCost& cost);
+
+    IProcessMemory* memory_;
+    size_t last_cache_hits_ = 0;
+    ScanCost last_cost_;
+};
+
+} // namespace dqxclarity
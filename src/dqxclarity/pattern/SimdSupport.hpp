@@ -0,0 +1,18 @@
+#pragma once
+
+// x86 SIMD availability shared by the generic search kernel and the per-signature matchers.
+// SSE2 is part of every x86-64 target; AVX2 code is compiled per function and picked at runtime.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DQX_SEARCH_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(DQX_SEARCH_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define DQX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DQX_TARGET_AVX2
+#endif
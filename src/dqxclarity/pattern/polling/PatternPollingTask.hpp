@@ -26,6 +26,8 @@ public:
 
     TaskDecision Evaluate(IMemoryScanner& scanner, const TickContext& ctx) override;
 
+    std::optional<PlannedScan> Scan() const override { return PlannedScan{ &pattern_, require_executable_ }; }
+
 private:
     std::string name_;
     const Pattern& pattern_;
@@ -1,9 +1,106 @@
 #include "PollingRunner.hpp"
+#include "../../util/Profile.hpp"
+#include <algorithm>
+#include <numeric>
 #include <thread>
 
 namespace dqxclarity
 {
 
+namespace
+{
+
+constexpr size_t kWheelSlots = 64;
+
+// Finer GCD resolutions would only add wakeups; due times are then rounded down to this step
+constexpr std::chrono::milliseconds kMinWheelResolution{ 5 };
+
+/**
+ * @brief Hashed timer wheel: task indices bucketed by due tick modulo the slot count
+ */
+class TimerWheel
+{
+public:
+    void Schedule(size_t task, uint64_t due_tick) { slots_[due_tick % kWheelSlots].push_back({ task, due_tick }); }
+
+    // Every task due at or before through, from the slots of ticks first..through
+    void PopDue(uint64_t first, uint64_t through, std::vector<size_t>& out)
+    {
+        out.clear();
+        const uint64_t count = (std::min)(through - first + 1, uint64_t{ kWheelSlots });
+        for (uint64_t tick = through + 1 - count; tick <= through; ++tick)
+        {
+            auto& slot = slots_[tick % kWheelSlots];
+            for (auto it = slot.begin(); it != slot.end();)
+            {
+                if (it->due_tick <= through)
+                {
+                    out.push_back(it->task);
+                    it = slot.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        size_t task;
+        uint64_t due_tick;
+    };
+
+    std::vector<Entry> slots_[kWheelSlots];
+};
+
+/**
+ * @brief Answers ScanProcess from one coalesced pass, delegating anything else
+ */
+class PrefetchedScanner : public IMemoryScanner
+{
+public:
+    explicit PrefetchedScanner(IMemoryScanner& scanner)
+        : scanner_(scanner)
+    {
+    }
+
+    void Add(const Pattern* pattern, bool require_executable, std::optional<uintptr_t> result)
+    {
+        results_.push_back({ pattern, require_executable, result });
+    }
+
+    std::optional<uintptr_t> ScanProcess(const Pattern& pattern, bool require_executable) override
+    {
+        for (const auto& entry : results_)
+        {
+            if (entry.pattern == &pattern && entry.require_executable == require_executable)
+                return entry.result;
+        }
+        return scanner_.ScanProcess(pattern, require_executable);
+    }
+
+    std::vector<uintptr_t> ScanProcessAll(const Pattern& pattern, bool require_executable) override
+    {
+        return scanner_.ScanProcessAll(pattern, require_executable);
+    }
+
+private:
+    struct Entry
+    {
+        const Pattern* pattern;
+        bool require_executable;
+        std::optional<uintptr_t> result;
+    };
+
+    IMemoryScanner& scanner_;
+    std::vector<Entry> results_;
+};
+
+} // namespace
+
 PollingRunner::PollingRunner(IMemoryScanner* scanner)
     : scanner_(scanner)
 {
@@ -68,4 +165,147 @@ PollingResult PollingRunner::Run(IPollingTask& task, std::atomic<bool>& cancel_t
     return result;
 }
 
+std::vector<PollingResult> PollingRunner::RunAll(const std::vector<IPollingTask*>& tasks,
+                                                 std::atomic<bool>& cancel_token) const
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<PollingResult> results(tasks.size());
+    if (tasks.empty())
+        return results;
+
+    const auto start = Clock::now();
+    if (!scanner_)
+    {
+        for (auto& result : results)
+        {
+            result.status = PollingResult::Status::Error;
+            result.error_message = "PollingRunner: scanner unavailable";
+        }
+        return results;
+    }
+
+    // Wheel resolution: coarsest step that still hits every task's due times exactly, but not below the floor
+    int64_t resolution_ms = 0;
+    for (const auto* task : tasks)
+        resolution_ms = std::gcd(resolution_ms, (std::max)(task->PollInterval().count(), int64_t{ 1 }));
+    const std::chrono::milliseconds resolution = (std::max)(std::chrono::milliseconds{ resolution_ms },
+                                                            kMinWheelResolution);
+    auto current_tick = [&](Clock::time_point now)
+    {
+        return static_cast<uint64_t>((now - start) / resolution);
+    };
+
+    std::vector<size_t> ticks(tasks.size(), 0);
+    std::vector<bool> finished(tasks.size(), false);
+    size_t active = tasks.size();
+
+    auto finish = [&](size_t i, PollingResult::Status status, std::string message = {})
+    {
+        results[i].status = status;
+        results[i].error_message = std::move(message);
+        results[i].ticks = ticks[i];
+        results[i].elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+        finished[i] = true;
+        --active;
+    };
+
+    TimerWheel wheel;
+    for (size_t i = 0; i < tasks.size(); ++i)
+        wheel.Schedule(i, 0);
+
+    std::vector<size_t> due;
+    for (uint64_t tick = 0; active > 0; ++tick)
+    {
+        if (cancel_token.load())
+        {
+            for (size_t i = 0; i < tasks.size(); ++i)
+            {
+                if (!finished[i])
+                    finish(i, PollingResult::Status::Canceled);
+            }
+            break;
+        }
+
+        const auto tick_time = start + tick * resolution;
+        auto now = Clock::now();
+        if (now < tick_time)
+        {
+            std::this_thread::sleep_for(tick_time - now);
+            now = Clock::now();
+        }
+
+        // After an overrun, fold the missed ticks into this one instead of replaying them back to back
+        const uint64_t first_tick = tick;
+        tick = (std::max)(tick, current_tick(now));
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            const auto timeout = tasks[i]->Timeout();
+            if (!finished[i] && timeout && now - start >= *timeout)
+                finish(i, PollingResult::Status::Timeout);
+        }
+
+        wheel.PopDue(first_tick, tick, due);
+        std::erase_if(due,
+                      [&](size_t i)
+                      {
+                          return finished[i];
+                      });
+        if (due.empty())
+            continue;
+
+        PROFILE_SCOPE_CUSTOM("PollingRunner.CoalescedTick");
+
+        // One pass per executable class over the union of due patterns (deduplicated by identity)
+        PrefetchedScanner prefetched(*scanner_);
+        for (bool executable : { true, false })
+        {
+            std::vector<const Pattern*> patterns;
+            for (size_t i : due)
+            {
+                auto scan = tasks[i]->Scan();
+                if (scan && scan->pattern && scan->require_executable == executable &&
+                    std::find(patterns.begin(), patterns.end(), scan->pattern) == patterns.end())
+                {
+                    patterns.push_back(scan->pattern);
+                }
+            }
+            if (patterns.empty())
+                continue;
+
+            auto found = scanner_->ScanProcessMany(patterns, executable);
+            for (size_t p = 0; p < patterns.size(); ++p)
+                prefetched.Add(patterns[p], executable, p < found.size() ? found[p] : std::nullopt);
+        }
+
+        for (size_t i : due)
+        {
+            TickContext ctx{ start, now, ticks[i] };
+            auto decision = tasks[i]->Evaluate(prefetched, ctx);
+            ++ticks[i];
+
+            if (decision.status == TaskDecision::Status::Error)
+            {
+                finish(i, PollingResult::Status::Error, decision.error_message);
+                continue;
+            }
+            if (decision.status == TaskDecision::Status::Match && tasks[i]->Mode() == TerminationMode::FirstMatch)
+            {
+                finish(i, PollingResult::Status::Matched);
+                continue;
+            }
+
+            // On schedule: the next multiple of the interval. Late: one interval from now, skipping missed ticks
+            const auto interval = tasks[i]->PollInterval();
+            const auto next_due = static_cast<uint64_t>(ticks[i] * interval / resolution);
+            const uint64_t late_tick = current_tick(Clock::now());
+            const auto interval_ticks = (std::max)(static_cast<uint64_t>(interval / resolution), uint64_t{ 1 });
+            wheel.Schedule(i, next_due > late_tick ? next_due : late_tick + interval_ticks);
+        }
+    }
+
+    return results;
+}
+
 } // namespace dqxclarity
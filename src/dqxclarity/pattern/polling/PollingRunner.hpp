@@ -5,6 +5,7 @@
 #include <chrono>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace dqxclarity
 {
@@ -32,6 +33,23 @@ public:
 
     PollingResult Run(IPollingTask& task, std::atomic<bool>& cancel_token) const;
 
+    /**
+     * @brief Drive several tasks together on a timer wheel
+     *
+     * Each task is slotted by its next due time (start + ticks * PollInterval()) at
+     * a resolution equal to the GCD of all intervals, floored at a few milliseconds.
+     * A task whose next due time has already passed (a tick overran) is rescheduled
+     * one interval from now, so missed ticks are skipped rather than replayed back
+     * to back. Tasks falling due in the same tick that declare a PlannedScan share
+     * one ScanProcessMany pass per executable class, and then evaluate against the
+     * prefetched results; memory reads per tick therefore scale with regions, not
+     * with the number of tasks. Timeout() and Mode() are honoured per task; the call
+     * returns once every task has finished.
+     *
+     * @return One result per task, in input order
+     */
+    std::vector<PollingResult> RunAll(const std::vector<IPollingTask*>& tasks, std::atomic<bool>& cancel_token) const;
+
 private:
     IMemoryScanner* scanner_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../IMemoryScanner.hpp"
+#include "../Pattern.hpp"
 #include <chrono>
 #include <optional>
 #include <string>
@@ -41,6 +42,18 @@ struct TaskDecision
     static TaskDecision Error(std::string message) { return TaskDecision{ Status::Error, std::move(message) }; }
 };
 
+/**
+ * @brief Memory scan a task performs on every tick, declared up front
+ *
+ * Lets PollingRunner::RunAll fold the scans of all tasks due in the same tick
+ * into one pass over memory.
+ */
+struct PlannedScan
+{
+    const Pattern* pattern = nullptr;
+    bool require_executable = true;
+};
+
 class IPollingTask
 {
 public:
@@ -51,6 +64,11 @@ public:
     virtual std::optional<std::chrono::milliseconds> Timeout() const = 0;
     virtual TerminationMode Mode() const = 0;
     virtual TaskDecision Evaluate(IMemoryScanner& scanner, const TickContext& ctx) = 0;
+
+    /**
+     * @brief Scan Evaluate() will request, if known in advance (nullopt = not coalescable)
+     */
+    virtual std::optional<PlannedScan> Scan() const { return std::nullopt; }
 };
 
 } // namespace dqxclarity
@@ -0,0 +1,245 @@
+#include "RegionPriority.hpp"
+#include "../process/ProcessFinder.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+template <typename T>
+void WritePod(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void ReadPod(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+RegionTraits RegionTraits::FromRegion(const MemoryRegion& region)
+{
+    RegionTraits traits;
+    const uint64_t size = region.Size();
+    traits.size_class = size == 0 ? 0 : static_cast<uint8_t>(63 - std::countl_zero(size));
+    traits.protection = static_cast<uint8_t>(region.protection & 0x7);
+    traits.anonymous = region.pathname.empty() || region.pathname.front() == '[';
+    const uint64_t start = region.start;
+    traits.address_class = start > 0xFFFFFFFFull ? 16 : static_cast<uint8_t>(start >> 28);
+    return traits;
+}
+
+uint32_t RegionTraits::Pack() const
+{
+    return static_cast<uint32_t>(size_class) | (static_cast<uint32_t>(protection) << 8) |
+           (static_cast<uint32_t>(anonymous) << 11) | (static_cast<uint32_t>(address_class) << 12);
+}
+
+RegionTraits RegionTraits::Unpack(uint32_t packed)
+{
+    RegionTraits traits;
+    traits.size_class = static_cast<uint8_t>(packed & 0xFF);
+    traits.protection = static_cast<uint8_t>((packed >> 8) & 0x7);
+    traits.anonymous = ((packed >> 11) & 1) != 0;
+    traits.address_class = static_cast<uint8_t>((packed >> 12) & 0x1F);
+    return traits;
+}
+
+RegionPriorityModel::RegionPriorityModel(std::filesystem::path path)
+    : path_(std::move(path))
+{
+}
+
+std::filesystem::path RegionPriorityModel::DefaultPath()
+{
+    return ProcessFinder::GetRuntimeDirectory() / "region_priority.bin";
+}
+
+uint64_t RegionPriorityModel::PatternKey(const Pattern& pattern)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < pattern.Size(); ++i)
+    {
+        hash = (hash ^ (pattern.mask[i] ? pattern.bytes[i] : 0x100u)) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+uint32_t RegionPriorityModel::Score(const std::map<uint32_t, uint32_t>& hits, const RegionTraits& traits) const
+{
+    uint32_t score = 0;
+    for (const auto& [packed, count] : hits)
+    {
+        const RegionTraits hit = RegionTraits::Unpack(packed);
+        // Protection and backing must agree, and the size within a factor of ~2
+        if (hit.protection != traits.protection || hit.anonymous != traits.anonymous)
+            continue;
+        const int size_delta = static_cast<int>(hit.size_class) - static_cast<int>(traits.size_class);
+        if (size_delta < -1 || size_delta > 1)
+            continue;
+
+        uint32_t weight = 1;
+        if (size_delta == 0)
+            weight += 2;
+        if (hit.address_class == traits.address_class)
+            weight += 2;
+        score += count * weight;
+    }
+    return score;
+}
+
+size_t RegionPriorityModel::Order(uint64_t pattern_key, std::vector<MemoryRegion>& regions) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = hits_.find(pattern_key);
+    if (it == hits_.end() || regions.empty())
+        return 0;
+
+    std::vector<std::pair<uint32_t, size_t>> ranked; // (score, original index)
+    ranked.reserve(regions.size());
+    for (size_t i = 0; i < regions.size(); ++i)
+        ranked.emplace_back(Score(it->second, RegionTraits::FromRegion(regions[i])), i);
+
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b)
+                     {
+                         return a.first > b.first;
+                     });
+
+    std::vector<MemoryRegion> ordered;
+    ordered.reserve(regions.size());
+    size_t likely = 0;
+    for (const auto& [score, index] : ranked)
+    {
+        if (score > 0)
+            ++likely;
+        ordered.push_back(std::move(regions[index]));
+    }
+    regions.swap(ordered);
+    return likely;
+}
+
+void RegionPriorityModel::Record(uint64_t pattern_key, const MemoryRegion& region)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& hits = hits_[pattern_key];
+    uint32_t& count = hits[RegionTraits::FromRegion(region).Pack()];
+    ++count;
+    if (count >= kMaxHitCount)
+    {
+        // Halve everything so old layouts fade out after a game update
+        for (auto& [packed, c] : hits)
+            c /= 2;
+        std::erase_if(hits,
+                      [](const auto& entry)
+                      {
+                          return entry.second == 0;
+                      });
+    }
+    dirty_ = true;
+}
+
+bool RegionPriorityModel::Load()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    hits_.clear();
+    dirty_ = false;
+
+    if (!std::filesystem::exists(path_))
+        return true;
+
+    std::ifstream file(path_, std::ios::binary);
+    if (!file)
+        return false;
+
+    uint64_t magic = 0;
+    uint16_t version = 0;
+    ReadPod(file, magic);
+    ReadPod(file, version);
+    if (!file || magic != MAGIC || version != VERSION)
+        return false;
+
+    uint32_t pattern_count = 0;
+    ReadPod(file, pattern_count);
+    std::map<uint64_t, std::map<uint32_t, uint32_t>> hits;
+    for (uint32_t i = 0; i < pattern_count && file; ++i)
+    {
+        uint64_t key = 0;
+        uint32_t entry_count = 0;
+        ReadPod(file, key);
+        ReadPod(file, entry_count);
+        auto& entries = hits[key];
+        for (uint32_t j = 0; j < entry_count && file; ++j)
+        {
+            uint32_t packed = 0;
+            uint32_t count = 0;
+            ReadPod(file, packed);
+            ReadPod(file, count);
+            entries[packed] = (std::min)(count, kMaxHitCount);
+        }
+    }
+    if (!file)
+        return false;
+
+    hits_ = std::move(hits);
+    return true;
+}
+
+bool RegionPriorityModel::Save()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto temp_path = path_.parent_path() / (path_.filename().string() + ".tmp");
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        WritePod(file, MAGIC);
+        WritePod(file, VERSION);
+        WritePod(file, static_cast<uint32_t>(hits_.size()));
+        for (const auto& [key, entries] : hits_)
+        {
+            WritePod(file, key);
+            WritePod(file, static_cast<uint32_t>(entries.size()));
+            for (const auto& [packed, count] : entries)
+            {
+                WritePod(file, packed);
+                WritePod(file, count);
+            }
+        }
+
+        file.flush();
+        if (!file)
+            return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
+
+bool RegionPriorityModel::SaveIfDirty()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!dirty_)
+            return true;
+    }
+    return Save();
+}
+
+} // namespace dqxclarity
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../pattern/MemoryRegion.hpp"
+#include "../pattern/Pattern.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Coarse description of a region, stable across game sessions
+ *
+ * Addresses change between launches but the kind of region a data pattern lives
+ * in does not: the same size class, protection, anonymous or file-backed, and
+ * roughly the same place in the 32-bit address space (Wine places its heaps in
+ * the same neighbourhoods every launch).
+ */
+struct RegionTraits
+{
+    uint8_t size_class = 0;    // floor(log2(size))
+    uint8_t protection = 0;    // MemoryProtection bits
+    bool anonymous = false;    // No backing file
+    uint8_t address_class = 0; // Top nibble of a 32-bit address, 16 for anything above 4 GB
+
+    static RegionTraits FromRegion(const MemoryRegion& region);
+
+    uint32_t Pack() const;
+    static RegionTraits Unpack(uint32_t packed);
+};
+
+/**
+ * @brief Learned ordering of regions for slow-path data pattern scans
+ *
+ * Records the traits of the region each pattern was found in and sorts later
+ * candidate regions by how closely they resemble past hits. Regions nobody has
+ * hit before keep their address order behind the likely ones, so an empty model
+ * reproduces the plain address-order scan.
+ *
+ * Shared by all scanners of an Engine; every method is thread-safe. Scanners
+ * only Record() hits; the Engine writes the model once, from stop_hook().
+ *
+ * File Location: Same directory as executable (region_priority.bin)
+ * File Format: Binary with atomic write-rename pattern (same as HookRegistry)
+ */
+class RegionPriorityModel
+{
+public:
+    explicit RegionPriorityModel(std::filesystem::path path = DefaultPath());
+
+    static std::filesystem::path DefaultPath();
+
+    /**
+     * @brief Stable key for a pattern (FNV-1a over bytes and mask)
+     */
+    static uint64_t PatternKey(const Pattern& pattern);
+
+    /**
+     * @brief Reorder regions so the most likely ones come first (stable for ties)
+     * @return Number of leading regions that resemble a past hit
+     */
+    size_t Order(uint64_t pattern_key, std::vector<MemoryRegion>& regions) const;
+
+    /**
+     * @brief Remember that pattern_key was found in region
+     */
+    void Record(uint64_t pattern_key, const MemoryRegion& region);
+
+    bool Load();
+    bool Save();
+
+    /**
+     * @brief Save only if Record() changed the model since the last save
+     */
+    bool SaveIfDirty();
+
+private:
+    static constexpr uint64_t MAGIC = 0x4952505144515831ULL;
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t kMaxHitCount = 1024;
+
+    uint32_t Score(const std::map<uint32_t, uint32_t>& hits, const RegionTraits& traits) const;
+
+    std::filesystem::path path_;
+    mutable std::mutex mutex_;
+    std::map<uint64_t, std::map<uint32_t, uint32_t>> hits_; // pattern key -> packed traits -> hit count
+    bool dirty_ = false;
+};
+
+} // namespace dqxclarity
@@ -1,9 +1,13 @@
 #include "ScannerBase.hpp"
+#include "../pattern/ParallelRegionScan.hpp"
+#include "../pattern/PatternSearch.hpp"
+#include "../memory/RemoteString.hpp"
 #include "../util/Profile.hpp"
 
 #include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -12,20 +16,41 @@
 #endif
 #include <windows.h>
 #include <psapi.h>
-#else
-#include <fstream>
-#include <sstream>
 #endif
 
 namespace dqxclarity
 {
 
+namespace
+{
+
+ScanCost CostSince(const ScanCost& now, const ScanCost& before)
+{
+    ScanCost delta;
+    delta.scans = now.scans - before.scans;
+    delta.regions_visited = now.regions_visited - before.regions_visited;
+    delta.read_calls = now.read_calls - before.read_calls;
+    delta.bytes_read = now.bytes_read - before.bytes_read;
+    delta.matches = now.matches - before.matches;
+    delta.bytes_searched = now.bytes_searched - before.bytes_searched;
+    delta.wall_time = now.wall_time - before.wall_time;
+    return delta;
+}
+
+} // namespace
+
 ScannerBase::ScannerBase(const ScannerCreateInfo& create_info)
     : memory_(create_info.memory)
     , logger_(create_info.logger)
     , verbose_(create_info.verbose)
     , pattern_(create_info.pattern)
     , cached_regions_(create_info.cached_regions)
+    , scan_pool_(create_info.scan_pool)
+    , region_map_(create_info.region_map)
+    , region_priority_(create_info.region_priority)
+    , change_tracker_(create_info.change_tracker)
+    , signature_name_(create_info.signature_name)
+    , scan_stats_(create_info.scan_stats)
 {
 }
 
@@ -38,7 +63,11 @@ bool ScannerBase::Initialize()
         return false;
     }
 
+    const ScanCost before = scan_cost_;
     initialized_ = OnInitialize();
+    startup_cost_ = CostSince(scan_cost_, before);
+    if (scan_stats_ && !signature_name_.empty())
+        scan_stats_->RecordStartup(signature_name_, startup_cost_);
     return initialized_;
 }
 
@@ -47,7 +76,12 @@ bool ScannerBase::Poll()
     if (!IsActive())
         return false;
 
-    return OnPoll();
+    const ScanCost before = scan_cost_;
+    const bool captured = OnPoll();
+    last_tick_cost_ = CostSince(scan_cost_, before);
+    if (scan_stats_ && !signature_name_.empty())
+        scan_stats_->RecordTick(signature_name_, last_tick_cost_);
+    return captured;
 }
 
 void ScannerBase::Shutdown()
@@ -62,50 +96,282 @@ void ScannerBase::Shutdown()
 
 uintptr_t ScannerBase::FindPattern(const Pattern& pattern, bool require_executable)
 {
-    if (last_pattern_addr_ != 0 && last_region_base_ != 0 && last_region_size_ > 0)
+    const uint64_t allocated_before = scratch_.BytesAllocated();
+    ScanCostTimer timer(scan_cost_);
+    ++scan_cost_.scans;
+    uintptr_t addr = 0;
+
+    if (last_pattern_addr_ != 0)
     {
-        PROFILE_SCOPE_CUSTOM("ScannerBase.FastPath");
-        uintptr_t addr = ScanRegionForPattern(last_region_base_, last_region_size_, pattern);
-        if (addr != 0)
+        PROFILE_SCOPE_CUSTOM("ScannerBase.VerifyPath");
+        if (VerifyPatternAt(last_pattern_addr_, pattern))
+            addr = last_pattern_addr_;
+        Count(find_stats_.verify, addr != 0);
+    }
+
+    if (addr == 0 && last_pattern_addr_ != 0 && last_region_base_ != 0 && last_region_size_ > 0)
+    {
+        PROFILE_SCOPE_CUSTOM("ScannerBase.WindowPath");
+        const uintptr_t region_end = last_region_base_ + last_region_size_;
+        if (last_pattern_addr_ >= last_region_base_ && last_pattern_addr_ < region_end)
         {
-            last_pattern_addr_ = addr;
-            return addr;
+            // Clamp to the cached region so the read never crosses into an unmapped neighbour
+            const uintptr_t radius = kNeighbourhoodRadius;
+            const uintptr_t window_start =
+                last_pattern_addr_ - (std::min)(last_pattern_addr_ - last_region_base_, radius);
+            const uintptr_t window_end = (std::min)(region_end, last_pattern_addr_ + pattern.Size() + radius);
+            addr = ScanRegionForPattern(window_start, window_end - window_start, pattern);
         }
+        Count(find_stats_.window, addr != 0);
+    }
+
+    if (addr == 0 && last_pattern_addr_ != 0 && last_region_base_ != 0 && last_region_size_ > 0)
+    {
+        PROFILE_SCOPE_CUSTOM("ScannerBase.FastPath");
+        addr = ScanRegionForPattern(last_region_base_, last_region_size_, pattern);
+        Count(find_stats_.region, addr != 0);
+    }
+
+    if (addr == 0)
+    {
+        PROFILE_SCOPE_CUSTOM("ScannerBase.SlowPath");
+        if (TrackerCovers(require_executable))
+            addr = ScanChangedMemory(pattern, require_executable);
+        else
+            addr = ScanAllMemory(pattern, require_executable);
+        Count(find_stats_.full, addr != 0);
     }
 
-    PROFILE_SCOPE_CUSTOM("ScannerBase.SlowPath");
-    uintptr_t addr = ScanAllMemory(pattern, require_executable);
     if (addr != 0)
     {
         last_pattern_addr_ = addr;
+        ++scan_cost_.matches;
     }
+    last_scan_bytes_allocated_ = scratch_.BytesAllocated() - allocated_before;
     return addr;
 }
 
-uintptr_t ScannerBase::ScanRegionForPattern(uintptr_t base_address, size_t size, const Pattern& pattern)
+bool ScannerBase::VerifyPatternAt(uintptr_t address, const Pattern& pattern)
 {
-    if (size == 0 || size > 100 * 1024 * 1024)
-        return 0;
+    if (!pattern.IsValid())
+        return false;
+
+    uint8_t* data = scratch_.Get(pattern.Size());
+    ++scan_cost_.read_calls;
+    if (!memory_->ReadMemory(address, data, pattern.Size()))
+        return false;
+    scan_cost_.bytes_read += pattern.Size();
+    return FindPatternInBuffer(data, pattern.Size(), pattern) == 0;
+}
 
-    std::vector<uint8_t> buffer(size);
-    if (!memory_->ReadMemory(base_address, buffer.data(), size))
+bool ScannerBase::TrackerCovers(bool require_executable) const
+{
+    if (!change_tracker_)
+        return false;
+    switch (change_tracker_->Filter())
     {
+    case RegionFilter::All:
+    case RegionFilter::Readable:
+        return true;
+    case RegionFilter::Executable:
+        return require_executable;
+    case RegionFilter::NonExecutable:
+        return !require_executable;
+    }
+    return false;
+}
+
+uintptr_t ScannerBase::ScanChangedMemory(const Pattern& pattern, bool require_executable)
+{
+    PROFILE_SCOPE_FUNCTION();
+    if (!pattern.IsValid())
         return 0;
+
+    const uint64_t pattern_key = RegionPriorityModel::PatternKey(pattern);
+    if (pattern_key != tracked_pattern_key_)
+    {
+        tracked_pattern_key_ = pattern_key;
+        tracked_generation_ = 0;
+        tracked_candidates_.clear();
     }
 
-    size_t offset = FindPatternInBuffer(buffer.data(), size, pattern);
-    if (offset != SIZE_MAX)
+    const uint64_t generation = change_tracker_->Sample(kRegionMapMaxAge);
+
+    // Same regions, size cap and priority order as ScanAllMemory; changed pages outside them are ignored
+    std::vector<MemoryRegion> regions = SelectScanRegions(require_executable);
+    const size_t likely = OrderScanRegions(pattern_key, regions);
+    std::vector<const MemoryRegion*> by_address;
+    by_address.reserve(regions.size());
+    for (const auto& region : regions)
+        by_address.push_back(&region);
+    std::sort(by_address.begin(), by_address.end(),
+              [](const MemoryRegion* a, const MemoryRegion* b)
+              {
+                  return a->start < b->start;
+              });
+
+    const size_t overlap = pattern.Size() - 1;
+    uint64_t bytes_scanned = 0;
+
+    ChunkedRegionReader reader(memory_, scratch_, &scan_cost_);
+    auto next_region = by_address.begin();
+    for (const auto& range : change_tracker_->ChangedSince(tracked_generation_))
     {
-        return base_address + offset;
+        // Both lists are in address order and regions do not overlap
+        while (next_region != by_address.end() && (*next_region)->end <= range.start)
+            ++next_region;
+        for (auto it = next_region; it != by_address.end() && (*it)->start < range.end; ++it)
+        {
+            const MemoryRegion& region = **it;
+            const uintptr_t changed_start = (std::max)(range.start, region.start);
+            const uintptr_t changed_end = (std::min)(range.end, region.end);
+            const uintptr_t start = changed_start - (std::min)(changed_start - region.start, uintptr_t{ overlap });
+            const uintptr_t end = (std::min)(region.end, changed_end + overlap);
+
+            // Candidates overlapping a changed byte are stale; rescanning re-adds the ones still there
+            tracked_candidates_.erase(tracked_candidates_.lower_bound(start),
+                                      tracked_candidates_.lower_bound(changed_end));
+            bytes_scanned += end - start;
+            reader.ForEachChunk(start, end - start, overlap,
+                                [&](uintptr_t address, const uint8_t* data, size_t length, size_t owned)
+                                {
+                                    match_offsets_.clear();
+                                    PatternSearch::FindAll(data, length, pattern, match_offsets_);
+                                    for (size_t offset : match_offsets_)
+                                    {
+                                        if (offset < owned)
+                                            tracked_candidates_.insert(address + offset);
+                                    }
+                                    return true;
+                                });
+        }
+    }
+    tracked_generation_ = generation;
+    last_scan_bytes_before_hit_ = bytes_scanned;
+
+    if (verbose_)
+        std::cout << "ScannerBase: " << bytes_scanned << " changed bytes scanned in " << regions.size()
+                  << " regions (" << likely << " prioritized)\n";
+
+    // Likely regions first, lowest candidate first within a region
+    for (const auto& region : regions)
+    {
+        for (auto it = tracked_candidates_.lower_bound(region.start);
+             it != tracked_candidates_.end() && *it < region.end;)
+        {
+            if (!VerifyPatternAt(*it, pattern))
+            {
+                it = tracked_candidates_.erase(it); // Unmapped since it was found
+                continue;
+            }
+
+            const uintptr_t addr = *it;
+            RecordHit(pattern_key, region);
+            if (verbose_)
+                std::cout << "ScannerBase: Pattern found at 0x" << std::hex << addr << " (incremental)" << std::dec
+                          << "\n";
+            return addr;
+        }
     }
 
+    if (verbose_)
+        std::cout << "ScannerBase: Pattern not found\n";
     return 0;
 }
 
+uintptr_t ScannerBase::ScanRegionForPattern(uintptr_t base_address, size_t size, const Pattern& pattern)
+{
+    if (size == 0 || size > kMaxScanRegionSize || !pattern.IsValid() || size < pattern.Size())
+        return 0;
+
+    uintptr_t found = 0;
+    ChunkedRegionReader reader(memory_, scratch_, &scan_cost_);
+    reader.ForEachChunk(base_address, size, pattern.Size() - 1,
+                        [&](uintptr_t address, const uint8_t* data, size_t length, size_t)
+                        {
+                            size_t offset = FindPatternInBuffer(data, length, pattern);
+                            if (offset != SIZE_MAX)
+                                found = address + offset;
+                            return found == 0;
+                        });
+
+    return found;
+}
+
 uintptr_t ScannerBase::ScanAllMemory(const Pattern& pattern, bool require_executable)
 {
     PROFILE_SCOPE_FUNCTION();
 
+    std::vector<MemoryRegion> regions = SelectScanRegions(require_executable);
+    const uint64_t pattern_key = region_priority_ ? RegionPriorityModel::PatternKey(pattern) : 0;
+    const size_t likely = OrderScanRegions(pattern_key, regions);
+
+    if (verbose_)
+        std::cout << "ScannerBase: Scanning " << regions.size() << " regions (" << likely << " prioritized)\n";
+
+    uint64_t bytes_before_hit = 0;
+    auto on_hit = [&](const MemoryRegion& region, uintptr_t addr)
+    {
+        last_scan_bytes_before_hit_ = bytes_before_hit + (addr - region.start);
+        RecordHit(pattern_key, region);
+        if (verbose_)
+        {
+            std::cout << "ScannerBase: Pattern found at 0x" << std::hex << addr << " in region 0x" << region.start
+                      << " - 0x" << region.end << std::dec << "\n";
+        }
+        return addr;
+    };
+
+    if (scan_pool_)
+    {
+        PROFILE_SCOPE_CUSTOM("ScannerBase.ParallelScan");
+        // Likely regions form their own tier so a hit there never waits on the rest of memory
+        const size_t tier_bounds[] = { 0, likely, regions.size() };
+        for (size_t t = 0; t + 1 < std::size(tier_bounds); ++t)
+        {
+            if (tier_bounds[t] == tier_bounds[t + 1])
+                continue;
+            std::vector<MemoryRegion> tier(regions.begin() + tier_bounds[t], regions.begin() + tier_bounds[t + 1]);
+            auto found = ParallelRegionScan::FindFirst(memory_, scan_pool_, tier, pattern, &scan_cost_);
+            if (found)
+            {
+                // Work units are visited in address order within a tier
+                const MemoryRegion* hit_region = nullptr;
+                for (const auto& r : tier)
+                {
+                    if (*found >= r.start && *found < r.end)
+                        hit_region = &r;
+                    else if (r.end <= *found)
+                        bytes_before_hit += r.Size();
+                }
+                if (hit_region)
+                    return on_hit(*hit_region, *found);
+                return *found;
+            }
+            for (const auto& r : tier)
+                bytes_before_hit += r.Size();
+        }
+    }
+    else
+    {
+        for (const auto& region : regions)
+        {
+            uintptr_t addr = ScanRegionForPattern(region.start, region.Size(), pattern);
+            if (addr != 0)
+                return on_hit(region, addr);
+            bytes_before_hit += region.Size();
+        }
+    }
+
+    last_scan_bytes_before_hit_ = bytes_before_hit;
+    if (verbose_)
+        std::cout << "ScannerBase: Pattern not found\n";
+
+    return 0;
+}
+
+std::vector<MemoryRegion> ScannerBase::SelectScanRegions(bool require_executable)
+{
     std::vector<MemoryRegion> regions;
     
     // Use cached regions if available, otherwise parse memory maps
@@ -123,7 +389,8 @@ uintptr_t ScannerBase::ScanAllMemory(const Pattern& pattern, bool require_execut
         }
         
         if (verbose_)
-            std::cout << "ScannerBase: Using " << regions.size() << " cached regions (filtered from " << cached_regions_.size() << " total)\n";
+            std::cout << "ScannerBase: Using " << regions.size() << " cached regions (filtered from "
+                      << cached_regions_.size() << " total)\n";
     }
     else
     {
@@ -134,31 +401,29 @@ uintptr_t ScannerBase::ScanAllMemory(const Pattern& pattern, bool require_execut
             std::cout << "ScannerBase: Parsed " << regions.size() << " regions from memory maps\n";
     }
 
-    if (verbose_)
-        std::cout << "ScannerBase: Scanning " << regions.size() << " regions\n";
-
-    for (const auto& region : regions)
-    {
-        uintptr_t addr = ScanRegionForPattern(region.start, region.Size(), pattern);
-        if (addr != 0)
-        {
-            last_region_base_ = region.start;
-            last_region_size_ = region.Size();
-
-            if (verbose_)
-            {
-                std::cout << "ScannerBase: Pattern found in region 0x" << std::hex << region.start << " - 0x"
-                          << region.end << std::dec << "\n";
-            }
-
-            return addr;
-        }
-    }
+    // Same size cap ScanRegionForPattern applies to single regions
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                 [](const MemoryRegion& r)
+                                 {
+                                     return r.Size() > kMaxScanRegionSize;
+                                 }),
+                  regions.end());
+    return regions;
+}
 
-    if (verbose_)
-        std::cout << "ScannerBase: Pattern not found\n";
+size_t ScannerBase::OrderScanRegions(uint64_t pattern_key, std::vector<MemoryRegion>& regions) const
+{
+    // Regions resembling past hits go first; the rest keep address order
+    return region_priority_ ? region_priority_->Order(pattern_key, regions) : 0;
+}
 
-    return 0;
+void ScannerBase::RecordHit(uint64_t pattern_key, const MemoryRegion& region)
+{
+    last_region_base_ = region.start;
+    last_region_size_ = region.Size();
+    // Persisted by the Engine on stop_hook(), not per hit
+    if (region_priority_)
+        region_priority_->Record(pattern_key, region);
 }
 
 std::vector<MemoryRegion> ScannerBase::GetNonExecutableRegions()
@@ -200,33 +465,10 @@ std::vector<MemoryRegion> ScannerBase::GetNonExecutableRegions()
 
     CloseHandle(process_handle);
 #else
-    pid_t pid = memory_->GetAttachedPid();
-    std::ifstream maps_file("/proc/" + std::to_string(pid) + "/maps");
-    if (!maps_file.is_open())
-        return regions;
-
-    std::string line;
-    while (std::getline(maps_file, line))
-    {
-        std::istringstream iss(line);
-        uintptr_t start, end;
-        char dash, r, w, x, p;
-        if (iss >> std::hex >> start >> dash >> end >> r >> w >> x >> p)
-        {
-            if (r == 'r' && x != 'x')
-            {
-                MemoryRegion region;
-                region.start = start;
-                region.end = end;
-                region.protection = static_cast<int>(MemoryProtection::Read);
-                if (w == 'w')
-                {
-                    region.protection |= static_cast<int>(MemoryProtection::Write);
-                }
-                regions.push_back(region);
-            }
-        }
-    }
+    if (!region_map_)
+        region_map_ = std::make_shared<RegionMap>(memory_->GetAttachedPid());
+    if (region_map_->RefreshIfStale(kRegionMapMaxAge))
+        regions = region_map_->Regions(RegionFilter::NonExecutable);
 #endif
 
     return regions;
@@ -267,29 +509,10 @@ std::vector<MemoryRegion> ScannerBase::GetExecutableRegions()
 
     CloseHandle(process_handle);
 #else
-    pid_t pid = memory_->GetAttachedPid();
-    std::ifstream maps_file("/proc/" + std::to_string(pid) + "/maps");
-    if (!maps_file.is_open())
-        return regions;
-
-    std::string line;
-    while (std::getline(maps_file, line))
-    {
-        std::istringstream iss(line);
-        uintptr_t start, end;
-        char dash, r, w, x, p;
-        if (iss >> std::hex >> start >> dash >> end >> r >> w >> x >> p)
-        {
-            if (r == 'r' && x == 'x')
-            {
-                MemoryRegion region;
-                region.start = start;
-                region.end = end;
-                region.protection = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Execute);
-                regions.push_back(region);
-            }
-        }
-    }
+    if (!region_map_)
+        region_map_ = std::make_shared<RegionMap>(memory_->GetAttachedPid());
+    if (region_map_->RefreshIfStale(kRegionMapMaxAge))
+        regions = region_map_->Regions(RegionFilter::Executable);
 #endif
 
     return regions;
@@ -302,54 +525,13 @@ bool ScannerBase::ReadString(uintptr_t address, std::string& output, size_t max_
     if (address == 0 || max_length == 0)
         return false;
 
-    std::vector<uint8_t> buffer(max_length);
-    if (!memory_->ReadMemory(address, buffer.data(), max_length))
-        return false;
-
-    size_t length = 0;
-    while (length < max_length && buffer[length] != '\0')
-    {
-        length++;
-    }
-
-    if (length > 0)
-    {
-        output.assign(reinterpret_cast<const char*>(buffer.data()), length);
-        return true;
-    }
-
-    return false;
+    return ReadRemoteString(*memory_, address, output, max_length) && !output.empty();
 }
 
 size_t ScannerBase::FindPatternInBuffer(const uint8_t* buffer, size_t buffer_size, const Pattern& pattern)
 {
-    if (!buffer || buffer_size == 0 || pattern.bytes.empty())
-        return SIZE_MAX;
-
-    const size_t pattern_size = pattern.bytes.size();
-    if (buffer_size < pattern_size)
-        return SIZE_MAX;
-
-    for (size_t i = 0; i <= buffer_size - pattern_size; ++i)
-    {
-        bool match = true;
-        for (size_t j = 0; j < pattern_size; ++j)
-        {
-            if (!pattern.mask[j])
-                continue;
-
-            if (buffer[i + j] != pattern.bytes[j])
-            {
-                match = false;
-                break;
-            }
-        }
-
-        if (match)
-            return i;
-    }
-
-    return SIZE_MAX;
+    // PatternSearch::kNotFound is SIZE_MAX, matching this function's contract
+    return PatternSearch::FindFirst(buffer, buffer_size, pattern);
 }
 
 } // namespace dqxclarity
@@ -4,9 +4,17 @@
 #include "ScannerCreateInfo.hpp"
 #include "../memory/IProcessMemory.hpp"
 #include "../pattern/MemoryRegion.hpp"
+#include "../pattern/PageChangeTracker.hpp"
+#include "../pattern/RegionMap.hpp"
+#include "../pattern/ScanStats.hpp"
+#include "RegionPriority.hpp"
 #include "../pattern/Pattern.hpp"
+#include "../pattern/ChunkedRegionReader.hpp"
 #include "../api/dqxclarity.hpp"
 
+#include <chrono>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -14,6 +22,23 @@
 namespace dqxclarity
 {
 
+/**
+ * @brief Hit/miss counters for each FindPattern lookup tier, cheapest first
+ */
+struct FindPatternStats
+{
+    struct Tier
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    Tier verify; // Pattern still at the cached address (reads pattern.Size() bytes)
+    Tier window; // Pattern moved within kNeighbourhoodRadius of the cached address
+    Tier region; // Pattern moved elsewhere in the cached region
+    Tier full;   // Full-memory scan, or the changed-pages scan when a PageChangeTracker is set
+};
+
 /**
  * @brief Abstract base class for scanners with shared pattern matching logic
  * 
@@ -34,8 +59,48 @@ public:
     bool IsActive() const override { return initialized_ && !shutdown_; }
     void Shutdown() override;
 
+    /**
+     * @brief Bytes allocated for region reads during the most recent FindPattern call
+     *
+     * Zero in steady state: region reads stream through a reused scratch window.
+     */
+    uint64_t LastScanBytesAllocated() const { return last_scan_bytes_allocated_; }
+
+    /**
+     * @brief Region bytes the most recent full-memory scan went through before its hit
+     *
+     * Counted in visiting order, so it drops as the region priority model learns.
+     * Equals the total bytes scanned when the pattern was not found.
+     */
+    uint64_t LastScanBytesBeforeHit() const { return last_scan_bytes_before_hit_; }
+
+    /**
+     * @brief Per-tier FindPattern counters since construction
+     */
+    const FindPatternStats& FindStats() const { return find_stats_; }
+
+    /**
+     * @brief Cost of every FindPattern call since construction
+     */
+    const ScanCost& TotalCost() const { return scan_cost_; }
+
+    /**
+     * @brief FindPattern cost of Initialize()
+     */
+    const ScanCost& StartupCost() const { return startup_cost_; }
+
+    /**
+     * @brief FindPattern cost of the most recent Poll()
+     */
+    const ScanCost& LastTickCost() const { return last_tick_cost_; }
+
 protected:
     static constexpr size_t kMaxStringLength = 4096;
+    static constexpr size_t kMaxScanRegionSize = 100 * 1024 * 1024;
+    // Scanners polling in the same tick reuse one /proc/pid/maps read
+    static constexpr std::chrono::milliseconds kRegionMapMaxAge{ 100 };
+    // Bytes searched on each side of the cached address before falling back to the whole region
+    static constexpr size_t kNeighbourhoodRadius = 4096;
 
     /**
      * @brief Override to perform initialization-specific logic
@@ -56,6 +121,10 @@ protected:
 
     /**
      * @brief Find pattern in memory with caching for performance
+     *
+     * Tries, in order: the cached address (one pattern.Size() read), a
+     * kNeighbourhoodRadius window around it, the cached region, then a
+     * full-memory scan. Each tier is counted in FindStats().
      * @param pattern Pattern to search for
      * @param require_executable If true, search executable regions; if false, search non-executable
      * @return Pattern address if found, 0 otherwise
@@ -79,8 +148,33 @@ protected:
      */
     uintptr_t ScanAllMemory(const Pattern& pattern, bool require_executable = false);
 
+    /**
+     * @brief Incremental replacement for ScanAllMemory driven by the change tracker
+     *
+     * Rescans only the pages changed since this scanner's last call (widened by
+     * pattern.Size() - 1 so matches straddling a page edge are seen) and keeps the
+     * set of match candidates in unchanged pages from earlier calls. Only pages
+     * inside the regions ScanAllMemory would scan are considered, and candidates
+     * are verified in the same priority order.
+     * @return First candidate that still matches, 0 if none
+     */
+    uintptr_t ScanChangedMemory(const Pattern& pattern, bool require_executable = false);
+
+    /**
+     * @brief Regions a full scan covers: cached or parsed, filtered by executable bit and kMaxScanRegionSize
+     */
+    std::vector<MemoryRegion> SelectScanRegions(bool require_executable);
+
+    /**
+     * @brief Apply the region priority model's order
+     * @return Number of leading regions that resemble a past hit
+     */
+    size_t OrderScanRegions(uint64_t pattern_key, std::vector<MemoryRegion>& regions) const;
+
     /**
      * @brief Get non-executable memory regions for scanning
+     *
+     * On Linux this is served from the shared RegionMap, refreshed at most once per kRegionMapMaxAge.
      * @return Vector of memory regions
      */
     std::vector<MemoryRegion> GetNonExecutableRegions();
@@ -114,6 +208,10 @@ protected:
     bool verbose_;
     Pattern pattern_;
     std::vector<MemoryRegion> cached_regions_;
+    ScanThreadPool* scan_pool_ = nullptr;
+    std::shared_ptr<RegionMap> region_map_;
+    std::shared_ptr<RegionPriorityModel> region_priority_;
+    std::shared_ptr<PageChangeTracker> change_tracker_;
 
     bool initialized_ = false;
     bool shutdown_ = false;
@@ -121,6 +219,28 @@ protected:
     uintptr_t last_pattern_addr_ = 0;
     uintptr_t last_region_base_ = 0;
     size_t last_region_size_ = 0;
+
+    ScratchBuffer scratch_;
+    uint64_t last_scan_bytes_allocated_ = 0;
+    uint64_t last_scan_bytes_before_hit_ = 0;
+    FindPatternStats find_stats_;
+
+    std::string signature_name_;
+    std::shared_ptr<ScanStatsRegistry> scan_stats_;
+    ScanCost scan_cost_;
+    ScanCost startup_cost_;
+    ScanCost last_tick_cost_;
+
+    uint64_t tracked_pattern_key_ = 0;
+    uint64_t tracked_generation_ = 0;
+    std::set<uintptr_t> tracked_candidates_;
+    std::vector<size_t> match_offsets_;
+
+private:
+    bool VerifyPatternAt(uintptr_t address, const Pattern& pattern);
+    bool TrackerCovers(bool require_executable) const;
+    void RecordHit(uint64_t pattern_key, const MemoryRegion& region);
+    static void Count(FindPatternStats::Tier& tier, bool hit) { ++(hit ? tier.hits : tier.misses); }
 };
 
 } // namespace dqxclarity
@@ -3,10 +3,17 @@
 #include "../memory/IProcessMemory.hpp"
 #include "../pattern/Pattern.hpp"
 #include "../pattern/MemoryRegion.hpp"
+#include "../pattern/PageChangeTracker.hpp"
+#include "../pattern/RegionMap.hpp"
+#include "../pattern/ScanStats.hpp"
+#include "RegionPriority.hpp"
 #include "../api/dqxclarity.hpp"
+#include "../util/ThreadPoolFwd.hpp"
 
 #include <chrono>
 #include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace dqxclarity
@@ -22,8 +29,26 @@ struct ScannerCreateInfo
     Pattern pattern = {};
     std::chrono::milliseconds poll_interval{ 250 };
 
+    // Name the scan costs are reported under (see ScanStatsRegistry)
+    std::string signature_name;
+
+    // Engine-wide scan cost collection (nullptr = costs only kept on the scanner)
+    std::shared_ptr<ScanStatsRegistry> scan_stats;
+
     std::vector<MemoryRegion> cached_regions = {};
 
+    // Optional worker pool for full-memory scans (nullptr = scan on the polling thread)
+    ScanThreadPool* scan_pool = nullptr;
+
+    // Live region index shared between scanners (nullptr = scanner creates its own)
+    std::shared_ptr<RegionMap> region_map;
+
+    // Learned region ordering for full-memory scans (nullptr = address order)
+    std::shared_ptr<RegionPriorityModel> region_priority;
+
+    // Page change tracking for continuous scanners: misses rescan only changed pages (nullptr = full rescans)
+    std::shared_ptr<PageChangeTracker> change_tracker;
+
     std::function<void(bool)> state_change_callback;
 };
 
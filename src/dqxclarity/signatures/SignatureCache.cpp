@@ -0,0 +1,229 @@
+#include "SignatureCache.hpp"
+#include "../hooking/HookRegistry.hpp"
+#include "../pattern/PatternSearch.hpp"
+#include "../process/ProcessFinder.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace dqxclarity
+{
+
+namespace
+{
+
+constexpr size_t kHeaderPageSize = 4096;
+
+std::string ToLowerCase(const std::string& str)
+{
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c)
+                   {
+                       return static_cast<char>(std::tolower(c));
+                   });
+    return result;
+}
+
+template <typename T>
+void WritePod(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void ReadPod(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+void WriteString(std::ofstream& file, const std::string& value)
+{
+    uint16_t length = static_cast<uint16_t>((std::min)(value.size(), size_t{ 0xFFFF }));
+    WritePod(file, length);
+    file.write(value.data(), length);
+}
+
+void ReadString(std::ifstream& file, std::string& value)
+{
+    uint16_t length = 0;
+    ReadPod(file, length);
+    value.resize(length);
+    file.read(value.data(), length);
+}
+
+} // namespace
+
+SignatureCache::SignatureCache(std::filesystem::path path)
+    : path_(std::move(path))
+{
+}
+
+std::filesystem::path SignatureCache::DefaultPath()
+{
+    return ProcessFinder::GetRuntimeDirectory() / "signature_cache.bin";
+}
+
+std::optional<ModuleIdentity> SignatureCache::IdentifyModule(IProcessMemory& memory, const std::string& module_name,
+                                                             const std::vector<MemoryRegion>& regions,
+                                                             uintptr_t& base_out)
+{
+    const std::string module_lower = ToLowerCase(module_name);
+    ModuleIdentity identity;
+    uintptr_t base = UINTPTR_MAX;
+    uintptr_t end = 0;
+    for (const auto& region : regions)
+    {
+        if (ToLowerCase(region.pathname).find(module_lower) == std::string::npos)
+            continue;
+        if (region.start < base)
+        {
+            base = region.start;
+            identity.path = region.pathname;
+        }
+        end = (std::max)(end, region.end);
+    }
+    if (base == UINTPTR_MAX || end - base < kHeaderPageSize)
+        return std::nullopt;
+
+    std::vector<uint8_t> header(kHeaderPageSize);
+    if (!memory.ReadMemory(base, header.data(), header.size()))
+        return std::nullopt;
+
+    // IMAGE_DOS_HEADER.e_magic / e_lfanew, then "PE\0\0" + IMAGE_FILE_HEADER
+    if (header[0] != 'M' || header[1] != 'Z')
+        return std::nullopt;
+    uint32_t nt_offset = 0;
+    std::memcpy(&nt_offset, &header[0x3C], sizeof(nt_offset));
+    if (header.size() < 24 || nt_offset > header.size() - 24 || std::memcmp(&header[nt_offset], "PE\0\0", 4) != 0)
+        return std::nullopt;
+    std::memcpy(&identity.pe_timestamp, &header[nt_offset + 8], sizeof(identity.pe_timestamp));
+
+    identity.image_size = end - base;
+    identity.header_crc = persistence::HookRegistry::ComputeCRC32(header.data(), header.size());
+    base_out = base;
+    return identity;
+}
+
+bool SignatureCache::Validate(IProcessMemory& memory, uintptr_t address, const Pattern& pattern)
+{
+    if (address == 0 || !pattern.IsValid())
+        return false;
+    std::vector<uint8_t> bytes(pattern.Size());
+    if (!memory.ReadMemory(address, bytes.data(), bytes.size()))
+        return false;
+    return PatternSearch::FindFirst(bytes.data(), bytes.size(), pattern) == 0;
+}
+
+bool SignatureCache::Load()
+{
+    offsets_.clear();
+    identity_ = ModuleIdentity{};
+    dirty_ = false;
+
+    if (!std::filesystem::exists(path_))
+        return true;
+
+    std::ifstream file(path_, std::ios::binary);
+    if (!file)
+        return false;
+
+    uint64_t magic = 0;
+    uint16_t version = 0;
+    ReadPod(file, magic);
+    ReadPod(file, version);
+    if (!file || magic != MAGIC || version != VERSION)
+        return false;
+
+    ModuleIdentity identity;
+    ReadString(file, identity.path);
+    ReadPod(file, identity.image_size);
+    ReadPod(file, identity.pe_timestamp);
+    ReadPod(file, identity.header_crc);
+
+    uint16_t count = 0;
+    ReadPod(file, count);
+    std::map<std::string, uint32_t> offsets;
+    for (uint16_t i = 0; i < count && file; ++i)
+    {
+        std::string name;
+        uint32_t offset = 0;
+        ReadString(file, name);
+        ReadPod(file, offset);
+        offsets[name] = offset;
+    }
+    if (!file)
+        return false;
+
+    identity_ = std::move(identity);
+    offsets_ = std::move(offsets);
+    return true;
+}
+
+bool SignatureCache::Save()
+{
+    auto temp_path = path_.parent_path() / (path_.filename().string() + ".tmp");
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        WritePod(file, MAGIC);
+        WritePod(file, VERSION);
+        WriteString(file, identity_.path);
+        WritePod(file, identity_.image_size);
+        WritePod(file, identity_.pe_timestamp);
+        WritePod(file, identity_.header_crc);
+
+        WritePod(file, static_cast<uint16_t>(offsets_.size()));
+        for (const auto& [name, offset] : offsets_)
+        {
+            WriteString(file, name);
+            WritePod(file, offset);
+        }
+
+        file.flush();
+        if (!file)
+            return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
+
+std::optional<uint32_t> SignatureCache::Get(const ModuleIdentity& identity, const std::string& name) const
+{
+    if (identity != identity_)
+        return std::nullopt;
+    auto it = offsets_.find(name);
+    if (it == offsets_.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void SignatureCache::Put(const ModuleIdentity& identity, const std::string& name, uint32_t offset)
+{
+    if (identity != identity_)
+    {
+        identity_ = identity;
+        offsets_.clear();
+        dirty_ = true;
+    }
+    auto [it, inserted] = offsets_.try_emplace(name, offset);
+    if (inserted || it->second != offset)
+    {
+        it->second = offset;
+        dirty_ = true;
+    }
+}
+
+} // namespace dqxclarity
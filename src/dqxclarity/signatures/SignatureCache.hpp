@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../pattern/Pattern.hpp"
+#include "../pattern/MemoryRegion.hpp"
+#include "../memory/IProcessMemory.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief Identity of a loaded module image
+ *
+ * Two launches of the same DQXGame.exe build produce the same identity; any
+ * game patch changes at least the PE timestamp or the header checksum.
+ */
+struct ModuleIdentity
+{
+    std::string path;          // Mapped pathname of the module
+    uint64_t image_size = 0;   // Bytes spanned by the module's mappings
+    uint32_t pe_timestamp = 0; // IMAGE_FILE_HEADER::TimeDateStamp
+    uint32_t header_crc = 0;   // CRC32 of the first header page (covers the section table)
+
+    bool operator==(const ModuleIdentity& other) const = default;
+};
+
+/**
+ * @brief Persistent cache of signature name → module-relative offset
+ *
+ * Entries are only trusted for the exact module identity they were recorded
+ * against, and callers still validate each offset by reading pattern.Size()
+ * bytes before using it, so a stale cache can only cost a rescan.
+ *
+ * File Location: Same directory as executable (signature_cache.bin)
+ * File Format: Binary with atomic write-rename pattern (same as HookRegistry)
+ */
+class SignatureCache
+{
+public:
+    explicit SignatureCache(std::filesystem::path path = DefaultPath());
+
+    static std::filesystem::path DefaultPath();
+
+    /**
+     * @brief Compute the identity of a module in the attached process
+     * @param base_out Receives the module base address on success
+     * @return Identity, or nullopt if the module or its PE header can't be read
+     */
+    static std::optional<ModuleIdentity> IdentifyModule(IProcessMemory& memory, const std::string& module_name,
+                                                        const std::vector<MemoryRegion>& regions,
+                                                        uintptr_t& base_out);
+
+    /**
+     * @brief Check that pattern matches at address by reading only pattern.Size() bytes
+     */
+    static bool Validate(IProcessMemory& memory, uintptr_t address, const Pattern& pattern);
+
+    /**
+     * @brief Load entries from disk (missing file is not an error)
+     */
+    bool Load();
+
+    /**
+     * @brief Write entries to disk atomically and clear the dirty flag on success
+     */
+    bool Save();
+
+    /**
+     * @brief Cached offset for a signature, only if recorded for this identity
+     */
+    std::optional<uint32_t> Get(const ModuleIdentity& identity, const std::string& name) const;
+
+    /**
+     * @brief Record an offset; a different identity discards all older entries
+     */
+    void Put(const ModuleIdentity& identity, const std::string& name, uint32_t offset);
+
+    bool IsDirty() const { return dirty_; }
+    size_t Size() const { return offsets_.size(); }
+
+private:
+    static constexpr uint64_t MAGIC = 0x5349474344515831ULL;
+    static constexpr uint16_t VERSION = 1;
+
+    std::filesystem::path path_;
+    ModuleIdentity identity_;
+    std::map<std::string, uint32_t> offsets_;
+    bool dirty_ = false;
+};
+
+} // namespace dqxclarity
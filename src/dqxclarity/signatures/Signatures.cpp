@@ -1,4 +1,5 @@
 #include "Signatures.hpp"
+#include "StaticSignature.hpp"
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -66,6 +67,41 @@ static bool LoadSignaturesFromToml(const std::string& path, std::unordered_map<s
     return !out.empty();
 }
 
+namespace
+{
+
+struct BuiltinSignature
+{
+    const char* name;
+    Pattern (*make)();
+};
+
+// Parsed and validated at compile time; each entry carries its own matcher (see StaticSignature)
+constexpr BuiltinSignature kBuiltinSignatures[] = {
+    { "dialog_trigger", &StaticSignature<"FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8">::ToPattern },
+    { "dialog_pattern", &StaticSignature<"FF FF FF 7F FF FF FF 7F 00 00 00 00 00 00 00 00 FD ?? A8 99">::ToPattern },
+    { "integrity_check",
+      &StaticSignature<"89 54 24 FC 8D 64 24 FC 89 4C 24 FC 8D 64 24 FC 8D 64 24 FC 89 04 24 E9 ?? ?? ?? ?? 89">::
+          ToPattern },
+    { "network_text", &StaticSignature<"51 51 8B C4 89 10 8B CF">::ToPattern },
+    { "network_text_trigger", &StaticSignature<"8B CA 8D 71 ?? 8A 01 41 84 C0 75 F9 EB 20">::ToPattern },
+    { "quest_text", &StaticSignature<"8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F">::ToPattern },
+    { "corner_text", &StaticSignature<"8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F">::ToPattern },
+    { "corner_text_trigger", &StaticSignature<"8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F">::ToPattern },
+    { "notice_string", &StaticSignature<"E5 8B 95 E7 94 BB E9 85 8D E4 BF A1 E3 81 AE E9 9A 9B E3 81 AF E3 82 B5 "
+                                        "E3 83 BC E3 83 90 E3 83 BC">::ToPattern },
+    { "walkthrough", &StaticSignature<"04 02 ?? ?? 10 00 00 00 80 ?? ?? ?? 00 00 00 00 ??">::ToPattern },
+    { "player_name_trigger", &StaticSignature<"55 8B EC 56 8B F1 57 8B 46 58 85 C0">::ToPattern },
+    { "player_name_pattern",
+      &StaticSignature<"A8 15 ?? ?? 00 00 00 00 00 00 00 00 00 00 00 00 00 00 ?? ?? ?? ?? 00 ?? ?? ?? 00 00 "
+                       "00 00 00 00 00 00 00 00 00 70 87 ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ??">::ToPattern },
+    { "sibling_name_pattern",
+      &StaticSignature<"?? ?? 00 ?? 00 00 00 ?? ?? 00 02 ?? 00 ?? 00 ?? 00 00 00 00 00 ?? 00 ?? ?? 00 00 ?? "
+                       "?? ?? 00 ?? 00 ?? ?? ?? 00 ?? 00 ?? ?? 00 00 00 00 ?? ?? 00 00 00 00 ??">::ToPattern },
+};
+
+} // namespace
+
 std::unordered_map<std::string, Pattern> Signatures::s_signatures;
 bool Signatures::s_initialized = false;
 
@@ -76,29 +112,19 @@ void Signatures::InitializeSignatures()
         return;
     }
 
-    // Preferred: load from assets/signatures.toml (relative to working directory)
-    if (!LoadSignaturesFromToml("assets/signatures.toml", s_signatures))
+    for (const auto& builtin : kBuiltinSignatures)
+        s_signatures[builtin.name] = builtin.make();
+
+    // assets/signatures.toml (relative to working directory) overrides individual keys; an
+    // entry identical to the built-in keeps the built-in and its specialized matcher
+    std::unordered_map<std::string, Pattern> overrides;
+    LoadSignaturesFromToml("assets/signatures.toml", overrides);
+    for (auto& [key, pattern] : overrides)
     {
-        // Fallback: initialize built-in defaults if file missing
-        s_signatures["dialog_trigger"] = Pattern::FromString("FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8");
-        s_signatures["dialog_pattern"] = Pattern::FromString("FF FF FF 7F FF FF FF 7F 00 00 00 00 00 00 00 00 FD ?? A8 99");
-        s_signatures["integrity_check"] = Pattern::FromString(
-            "89 54 24 FC 8D 64 24 FC 89 4C 24 FC 8D 64 24 FC 8D 64 24 FC 89 04 24 E9 ?? ?? ?? ?? 89");
-        s_signatures["network_text"] = Pattern::FromString("51 51 8B C4 89 10 8B CF");
-        s_signatures["network_text_trigger"] = Pattern::FromString("8B CA 8D 71 ?? 8A 01 41 84 C0 75 F9 EB 20");
-        s_signatures["quest_text"] = Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F");
-        s_signatures["corner_text"] = Pattern::FromString("8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F");
-        s_signatures["corner_text_trigger"] = Pattern::FromString("8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F");
-        s_signatures["notice_string"] = Pattern::FromString(
-            "E5 8B 95 E7 94 BB E9 85 8D E4 BF A1 E3 81 AE E9 9A 9B E3 81 AF E3 82 B5 E3 83 BC E3 83 90 E3 83 BC");
-        s_signatures["walkthrough"] = Pattern::FromString("04 02 ?? ?? 10 00 00 00 80 ?? ?? ?? 00 00 00 00 ??");
-        s_signatures["player_name_trigger"] = Pattern::FromString("55 8B EC 56 8B F1 57 8B 46 58 85 C0");
-        s_signatures["player_name_pattern"] =
-            Pattern::FromString("A8 15 ?? ?? 00 00 00 00 00 00 00 00 00 00 00 00 00 00 ?? ?? ?? ?? 00 ?? ?? ?? 00 00 "
-                                "00 00 00 00 00 00 00 00 00 70 87 ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ??");
-        s_signatures["sibling_name_pattern"] =
-            Pattern::FromString("?? ?? 00 ?? 00 00 00 ?? ?? 00 02 ?? 00 ?? 00 ?? 00 00 00 00 00 ?? 00 ?? ?? 00 00 ?? "
-                                "?? ?? 00 ?? 00 ?? ?? ?? 00 ?? 00 ?? ?? 00 00 00 00 ?? ?? 00 00 00 00 ??");
+        auto it = s_signatures.find(key);
+        if (it != s_signatures.end() && it->second.bytes == pattern.bytes && it->second.mask == pattern.mask)
+            continue;
+        s_signatures[key] = std::move(pattern);
     }
 
     s_initialized = true;
@@ -191,4 +217,26 @@ const Pattern* Signatures::GetSignature(const std::string& name)
     return nullptr;
 }
 
+std::vector<std::pair<std::string, Pattern>> Signatures::GetHookSignatures()
+{
+    InitializeSignatures();
+    std::vector<std::pair<std::string, Pattern>> result;
+    auto add = [&result](const char* preferred, const char* fallback)
+    {
+        auto it = s_signatures.find(preferred);
+        if (it == s_signatures.end() && fallback)
+            it = s_signatures.find(fallback);
+        if (it != s_signatures.end() && it->second.IsValid())
+            result.emplace_back(it->first, it->second);
+    };
+
+    add("dialog_trigger", nullptr);
+    add("quest_text", nullptr);
+    add("player_name_trigger", nullptr);
+    add("corner_text_trigger", "corner_text");
+    add("network_text_trigger", "network_text");
+    add("integrity_check", nullptr);
+    return result;
+}
+
 } // namespace dqxclarity
@@ -3,6 +3,8 @@
 #include "../pattern/Pattern.hpp"
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace dqxclarity
 {
@@ -24,6 +26,13 @@ public:
 
     static const Pattern* GetSignature(const std::string& name);
 
+    /**
+     * @brief Name/pattern pairs for every hook site, as returned by the hooks' GetSignature()
+     *
+     * Used to resolve all hook addresses in one pass before the hooks are installed.
+     */
+    static std::vector<std::pair<std::string, Pattern>> GetHookSignatures();
+
 private:
     static void InitializeSignatures();
     static std::unordered_map<std::string, Pattern> s_signatures;
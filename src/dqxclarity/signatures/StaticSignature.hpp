@@ -0,0 +1,288 @@
+#pragma once
+
+#include "../pattern/CompiledPattern.hpp"
+#include "../pattern/Pattern.hpp"
+#include "../pattern/PatternSearch.hpp"
+#include "../pattern/SimdSupport.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace dqxclarity
+{
+
+/**
+ * @brief String literal usable as a template argument
+ */
+template <size_t N>
+struct FixedString
+{
+    char text[N]{};
+
+    consteval FixedString(const char (&literal)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            text[i] = literal[i];
+    }
+
+    constexpr std::string_view View() const { return std::string_view(text, N - 1); }
+};
+
+namespace static_signature
+{
+
+constexpr int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+constexpr bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+/**
+ * @brief Byte/mask arrays with room for Capacity tokens, filled by Parse
+ */
+template <size_t Capacity>
+struct Parsed
+{
+    std::array<uint8_t, Capacity> bytes{};
+    std::array<uint8_t, Capacity> mask{};
+    size_t size = 0;
+};
+
+/**
+ * @brief Compile-time counterpart of Pattern::FromString
+ *
+ * Accepts the same tokens ("??", ".", ".." as wildcards, one or two hex digits
+ * otherwise). A malformed token throws, which makes the constant evaluation and
+ * therefore the build fail.
+ */
+template <size_t Capacity>
+consteval Parsed<Capacity> Parse(std::string_view text)
+{
+    Parsed<Capacity> out;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        while (i < text.size() && IsSpace(text[i]))
+            ++i;
+        const size_t begin = i;
+        while (i < text.size() && !IsSpace(text[i]))
+            ++i;
+        const std::string_view token = text.substr(begin, i - begin);
+        if (token.empty())
+            break;
+
+        if (token == "??" || token == "." || token == "..")
+        {
+            out.bytes[out.size] = 0;
+            out.mask[out.size] = 0;
+        }
+        else
+        {
+            int value = 0;
+            if (token.size() > 2)
+                throw "signature token longer than one byte";
+            for (char c : token)
+            {
+                const int digit = HexDigit(c);
+                if (digit < 0)
+                    throw "signature token is not hex";
+                value = value * 16 + digit;
+            }
+            out.bytes[out.size] = static_cast<uint8_t>(value);
+            out.mask[out.size] = 0xFF;
+        }
+        ++out.size;
+    }
+    if (out.size == 0)
+        throw "empty signature";
+    return out;
+}
+
+} // namespace static_signature
+
+/**
+ * @brief Built-in signature parsed at compile time, with a matcher generated for its bytes
+ *
+ * The byte/mask tables are constexpr arrays and MatchesAt() is a fold over the
+ * pattern positions, so wildcards cost nothing and the fixed bytes become
+ * immediate compares the compiler can unroll and merge. FindFirst() runs the
+ * same anchor candidate scan as PatternSearch (same anchor choice, SSE2/AVX2 on
+ * x86) with the anchor broadcast as a constant.
+ *
+ * ToPattern() produces an ordinary Pattern whose CompiledPattern carries
+ * FindFirst() as its specialized matcher; everything else in the library keeps
+ * working with it unchanged.
+ */
+template <FixedString Text>
+class StaticSignature
+{
+    static constexpr auto kParsed = static_signature::Parse<Text.View().size() / 2 + 1>(Text.View());
+
+    template <size_t... I>
+    static constexpr std::array<uint8_t, sizeof...(I)> Trim(const auto& source, std::index_sequence<I...>)
+    {
+        return { source[I]... };
+    }
+
+public:
+    static constexpr size_t kSize = kParsed.size;
+    static constexpr std::array<uint8_t, kSize> kBytes = Trim(kParsed.bytes, std::make_index_sequence<kSize>{});
+    static constexpr std::array<uint8_t, kSize> kMask = Trim(kParsed.mask, std::make_index_sequence<kSize>{});
+    static constexpr PatternAnchor kAnchor = SelectPatternAnchor(kBytes, kMask, kSize);
+
+    static constexpr std::string_view Source() { return Text.View(); }
+
+    /**
+     * @brief Whether data[0, kSize) matches; only fixed positions are compared
+     */
+    static bool MatchesAt(const uint8_t* data)
+    {
+        return [data]<size_t... I>(std::index_sequence<I...>)
+        {
+            return ((kMask[I] == 0 || data[I] == kBytes[I]) && ...);
+        }(std::make_index_sequence<kSize>{});
+    }
+
+    /**
+     * @brief Offset of the first match in buffer, or PatternSearch::kNotFound
+     */
+    static size_t FindFirst(const uint8_t* buffer, size_t buffer_size)
+    {
+        if (!buffer || buffer_size < kSize)
+            return PatternSearch::kNotFound;
+        if constexpr (!kAnchor.valid)
+            return 0; // All wildcards
+
+        size_t next = 0;
+#ifdef DQX_SEARCH_X86_SIMD
+        size_t found = PatternSearch::kNotFound;
+        next = PatternSearch::HasAvx2() ? ScanAvx2(buffer, buffer_size, found) : ScanSse2(buffer, buffer_size, found);
+        if (found != PatternSearch::kNotFound)
+            return found;
+#endif
+        return ScanScalar(buffer, buffer_size, next);
+    }
+
+    /**
+     * @brief Runtime Pattern for the rest of the library, carrying FindFirst as its matcher
+     */
+    static Pattern ToPattern()
+    {
+        Pattern pattern;
+        pattern.bytes.assign(kBytes.begin(), kBytes.end());
+        pattern.mask.resize(kSize);
+        for (size_t i = 0; i < kSize; ++i)
+            pattern.mask[i] = kMask[i] != 0;
+
+        auto compiled = std::make_shared<CompiledPattern>(CompiledPattern::FromPattern(pattern));
+        compiled->specialized_find_first = &FindFirst;
+        pattern.compiled = std::move(compiled);
+        return pattern;
+    }
+
+private:
+    static bool AnchorAt(const uint8_t* data)
+    {
+        if constexpr (kAnchor.pair)
+            return data[kAnchor.offset] == kAnchor.first && data[kAnchor.offset + 1] == kAnchor.second;
+        else
+            return data[kAnchor.offset] == kAnchor.first;
+    }
+
+    static size_t ScanScalar(const uint8_t* buffer, size_t buffer_size, size_t begin)
+    {
+        const size_t last = buffer_size - kSize;
+        for (size_t i = begin; i <= last; ++i)
+        {
+            const void* hit = std::memchr(buffer + i + kAnchor.offset, kAnchor.first, last - i + 1);
+            if (!hit)
+                break;
+            i = static_cast<size_t>(static_cast<const uint8_t*>(hit) - buffer) - kAnchor.offset;
+            if (AnchorAt(buffer + i) && MatchesAt(buffer + i))
+                return i;
+        }
+        return PatternSearch::kNotFound;
+    }
+
+#ifdef DQX_SEARCH_X86_SIMD
+    // Both return the first offset left for the scalar tail; a match is written to found.
+    static size_t ScanSse2(const uint8_t* buffer, size_t buffer_size, size_t& found)
+    {
+        constexpr size_t kWidth = 16;
+        const uint8_t* anchor_ptr = buffer + kAnchor.offset;
+        const __m128i first = _mm_set1_epi8(static_cast<char>(kAnchor.first));
+        const __m128i second = _mm_set1_epi8(static_cast<char>(kAnchor.second));
+
+        size_t i = 0;
+        for (; i + kWidth + kSize - 1 <= buffer_size; i += kWidth)
+        {
+            __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(anchor_ptr + i)), first);
+            if constexpr (kAnchor.pair)
+            {
+                eq = _mm_and_si128(
+                    eq, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(anchor_ptr + i + 1)), second));
+            }
+            auto bits = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+            while (bits)
+            {
+                const size_t candidate = i + static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                if (MatchesAt(buffer + candidate))
+                {
+                    found = candidate;
+                    return i;
+                }
+            }
+        }
+        return i;
+    }
+
+    DQX_TARGET_AVX2 static size_t ScanAvx2(const uint8_t* buffer, size_t buffer_size, size_t& found)
+    {
+        constexpr size_t kWidth = 32;
+        const uint8_t* anchor_ptr = buffer + kAnchor.offset;
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(kAnchor.first));
+        const __m256i second = _mm256_set1_epi8(static_cast<char>(kAnchor.second));
+
+        size_t i = 0;
+        for (; i + kWidth + kSize - 1 <= buffer_size; i += kWidth)
+        {
+            __m256i eq =
+                _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(anchor_ptr + i)), first);
+            if constexpr (kAnchor.pair)
+            {
+                eq = _mm256_and_si256(
+                    eq, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(anchor_ptr + i + 1)),
+                                          second));
+            }
+            auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+            while (bits)
+            {
+                const size_t candidate = i + static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                if (MatchesAt(buffer + candidate))
+                {
+                    found = candidate;
+                    return i;
+                }
+            }
+        }
+        return i;
+    }
+#endif
+};
+
+} // namespace dqxclarity
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Forward declaration of BS::thread_pool so headers can take a pool pointer without
+// pulling BS_thread_pool.hpp (and its min/max clashes with <windows.h>) into every TU.
+namespace BS
+{
+template <std::uint8_t>
+class thread_pool;
+} // namespace BS
+
+namespace dqxclarity
+{
+
+/// Same type as BS::light_thread_pool (thread_pool<tp::none>), owned by Engine
+using ScanThreadPool = BS::thread_pool<0>;
+
+} // namespace dqxclarity
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "dqxclarity/memory/IProcessMemory.hpp"
+#include "dqxclarity/pattern/MemoryRegion.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace dqxclarity::test
+{
+
+/**
+ * @brief In-process IProcessMemory backed by a set of byte regions
+ *
+ * Reads succeed only when the whole range lies inside one mapped region,
+ * mirroring how process_vm_readv/ReadProcessMemory fail on unmapped pages.
+ */
+class FakeProcessMemory : public IProcessMemory
+{
+public:
+    std::vector<uint8_t>& Map(uintptr_t start, size_t size, int protection, const std::string& pathname = "")
+    {
+        auto& bytes = regions_[start];
+        bytes.assign(size, 0);
+        infos_[start] = MemoryRegion{ start, start + size, protection, pathname };
+        return bytes;
+    }
+
+    std::vector<MemoryRegion> Regions() const
+    {
+        std::vector<MemoryRegion> out;
+        for (const auto& [start, info] : infos_)
+            out.push_back(info);
+        return out;
+    }
+
+    std::atomic<size_t> read_calls{ 0 };
+    std::atomic<size_t> bytes_read{ 0 };
+
+    bool AttachProcess(pid_t) override { return true; }
+    void DetachProcess() override {}
+    bool IsProcessAttached() const override { return true; }
+    pid_t GetAttachedPid() const override { return 1; }
+
+    bool ReadMemory(uintptr_t address, void* buffer, size_t size) override
+    {
+        ++read_calls;
+        auto* bytes = Locate(address, size);
+        if (!bytes)
+            return false;
+        std::memcpy(buffer, bytes, size);
+        bytes_read += size;
+        return true;
+    }
+
+    bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override
+    {
+        auto* bytes = Locate(address, size);
+        if (!bytes)
+            return false;
+        std::memcpy(bytes, buffer, size);
+        return true;
+    }
+
+    // Allocations are mapped read/write from kAllocationBase upwards
+    static constexpr uintptr_t kAllocationBase = 0x70000000;
+
+    uintptr_t AllocateMemory(size_t size, bool) override
+    {
+        const uintptr_t address = next_allocation_;
+        next_allocation_ += (size + 0xFFF) & ~uintptr_t{ 0xFFF };
+        Map(address, size, static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write));
+        return address;
+    }
+
+    bool FreeMemory(uintptr_t address, size_t) override
+    {
+        if (address < kAllocationBase)
+            return false;
+        infos_.erase(address);
+        return regions_.erase(address) == 1;
+    }
+    bool SetMemoryProtection(uintptr_t, size_t, MemoryProtectionFlags) override { return true; }
+
+    bool ReadString(uintptr_t address, std::string& output, size_t max_length) override
+    {
+        output.clear();
+        for (size_t i = 0; i < max_length; ++i)
+        {
+            char c = 0;
+            if (!ReadMemory(address + i, &c, 1) || c == '\0')
+                break;
+            output.push_back(c);
+        }
+        return !output.empty();
+    }
+
+    bool WriteString(uintptr_t address, const std::string& text) override
+    {
+        return WriteMemory(address, text.c_str(), text.size() + 1);
+    }
+
+    uintptr_t GetModuleBaseAddress(const std::string&) override
+    {
+        return infos_.empty() ? 0 : infos_.begin()->first;
+    }
+
+    int ReadInt32(uintptr_t address) override
+    {
+        int value = 0;
+        ReadMemory(address, &value, sizeof(value));
+        return value;
+    }
+
+    uint64_t ReadInt64(uintptr_t address) override
+    {
+        uint64_t value = 0;
+        ReadMemory(address, &value, sizeof(value));
+        return value;
+    }
+
+    uintptr_t GetPointerAddress(uintptr_t base, const std::vector<uintptr_t>& offsets) override
+    {
+        uintptr_t address = base;
+        for (uintptr_t offset : offsets)
+        {
+            uint32_t next = 0;
+            if (!ReadMemory(address, &next, sizeof(next)))
+                return 0;
+            address = next + offset;
+        }
+        return address;
+    }
+
+    void FlushInstructionCache(uintptr_t, size_t) override {}
+
+private:
+    uintptr_t next_allocation_ = kAllocationBase;
+
+    uint8_t* Locate(uintptr_t address, size_t size)
+    {
+        auto it = regions_.upper_bound(address);
+        if (it == regions_.begin())
+            return nullptr;
+        --it;
+        const uintptr_t offset = address - it->first;
+        if (offset + size > it->second.size())
+            return nullptr;
+        return it->second.data() + offset;
+    }
+
+    std::map<uintptr_t, std::vector<uint8_t>> regions_;
+    std::map<uintptr_t, MemoryRegion> infos_;
+};
+
+} // namespace dqxclarity::test
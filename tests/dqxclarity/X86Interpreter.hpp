@@ -0,0 +1,261 @@
+#pragma once
+
+#include "dqxclarity/memory/IProcessMemory.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace dqxclarity::test
+{
+
+/**
+ * @brief Executes the 32-bit instruction subset emitted by X86CodeBuilder against an IProcessMemory
+ *
+ * Lets detour fragments be checked on any host. Registers are indexed by
+ * hardware number (EAX=0, ECX=1, EDX=2, EBX=3, ESP=4, EBP=5, ESI=6, EDI=7);
+ * of EFLAGS only ZF is modelled (for jz/jnz), and pushfd/popfd round-trip it.
+ * 8-bit operands are limited to AL/CL/DL/BL.
+ */
+class X86Interpreter
+{
+public:
+    enum Reg
+    {
+        EAX,
+        ECX,
+        EDX,
+        EBX,
+        ESP,
+        EBP,
+        ESI,
+        EDI
+    };
+
+    explicit X86Interpreter(IProcessMemory& memory)
+        : memory_(memory)
+    {
+    }
+
+    std::array<uint32_t, 8> regs{};
+    uint32_t eflags = 0x202;
+
+    /**
+     * @brief Run code until its end; false on an unsupported opcode or a failed memory access
+     */
+    bool Run(const std::vector<uint8_t>& code)
+    {
+        code_ = &code;
+        pc_ = 0;
+        while (pc_ < code.size())
+        {
+            if (!Step())
+                return false;
+        }
+        return true;
+    }
+
+private:
+    uint8_t Fetch8() { return (*code_)[pc_++]; }
+
+    uint32_t Fetch32()
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, code_->data() + pc_, sizeof(value));
+        pc_ += sizeof(value);
+        return value;
+    }
+
+    bool Load(uint32_t address, uint32_t& value) { return memory_.ReadMemory(address, &value, sizeof(value)); }
+
+    bool Store(uint32_t address, uint32_t value) { return memory_.WriteMemory(address, &value, sizeof(value)); }
+
+    static constexpr uint32_t kZeroFlag = 0x40;
+
+    void SetZero(uint32_t result) { eflags = result == 0 ? (eflags | kZeroFlag) : (eflags & ~kZeroFlag); }
+
+    void Jump(bool taken)
+    {
+        const auto disp = static_cast<int8_t>(Fetch8());
+        if (taken)
+            pc_ = static_cast<size_t>(static_cast<int64_t>(pc_) + disp);
+    }
+
+    // ModR/M operand: register (mod=3) or memory address
+    struct Operand
+    {
+        bool is_register = false;
+        uint8_t reg_field = 0;
+        uint8_t rm = 0;
+        uint32_t address = 0;
+    };
+
+    Operand DecodeModRM()
+    {
+        const uint8_t modrm = Fetch8();
+        Operand op;
+        const uint8_t mod = modrm >> 6;
+        op.reg_field = (modrm >> 3) & 7;
+        op.rm = modrm & 7;
+        if (mod == 3)
+            op.is_register = true;
+        else if (mod == 0 && op.rm == 5)
+            op.address = Fetch32();
+        else if (mod == 0)
+            op.address = regs[op.rm];
+        else if (mod == 1)
+            op.address = regs[op.rm] + static_cast<uint32_t>(static_cast<int8_t>(Fetch8()));
+        else
+            op.address = regs[op.rm] + Fetch32();
+        return op;
+    }
+
+    bool Step()
+    {
+        const uint8_t opcode = Fetch8();
+        if (opcode >= 0x40 && opcode <= 0x47)
+        {
+            SetZero(++regs[opcode - 0x40]);
+            return true;
+        }
+        if (opcode >= 0x48 && opcode <= 0x4F)
+        {
+            SetZero(--regs[opcode - 0x48]);
+            return true;
+        }
+        if (opcode >= 0xB8 && opcode <= 0xBF)
+        {
+            regs[opcode - 0xB8] = Fetch32();
+            return true;
+        }
+        switch (opcode)
+        {
+        case 0x90:
+            return true;
+        case 0xF0: // lock: one interpreter thread, so the prefixed instruction is atomic anyway
+            return pc_ < code_->size() && Step();
+        case 0xFF:
+        {
+            const Operand op = DecodeModRM();
+            uint32_t value = 0;
+            if (op.is_register || op.reg_field != 0 || !Load(op.address, value))
+                return false;
+            SetZero(++value);
+            return Store(op.address, value);
+        }
+        case 0x9C:
+            regs[ESP] -= 4;
+            return Store(regs[ESP], eflags);
+        case 0x9D:
+            if (!Load(regs[ESP], eflags))
+                return false;
+            regs[ESP] += 4;
+            return true;
+        case 0xA1:
+            return Load(Fetch32(), regs[EAX]);
+        case 0xA3:
+            return Store(Fetch32(), regs[EAX]);
+        case 0x89:
+        {
+            const Operand op = DecodeModRM();
+            if (op.is_register)
+            {
+                regs[op.rm] = regs[op.reg_field];
+                return true;
+            }
+            return Store(op.address, regs[op.reg_field]);
+        }
+        case 0x8B:
+        {
+            const Operand op = DecodeModRM();
+            if (op.is_register)
+            {
+                regs[op.reg_field] = regs[op.rm];
+                return true;
+            }
+            return Load(op.address, regs[op.reg_field]);
+        }
+        case 0x81:
+        {
+            const Operand op = DecodeModRM();
+            const uint32_t imm = Fetch32();
+            if (!op.is_register)
+                return false;
+            if (op.reg_field == 0)
+                regs[op.rm] += imm;
+            else if (op.reg_field == 4)
+                regs[op.rm] &= imm;
+            else
+                return false;
+            SetZero(regs[op.rm]);
+            return true;
+        }
+        case 0x6B:
+        {
+            const Operand op = DecodeModRM();
+            const auto imm = static_cast<int8_t>(Fetch8());
+            if (!op.is_register)
+                return false;
+            regs[op.reg_field] = regs[op.rm] * static_cast<uint32_t>(imm);
+            return true;
+        }
+        case 0x69:
+        {
+            const Operand op = DecodeModRM();
+            const uint32_t imm = Fetch32();
+            if (!op.is_register)
+                return false;
+            regs[op.reg_field] = regs[op.rm] * imm;
+            return true;
+        }
+        case 0x84:
+        case 0x85:
+        {
+            const Operand op = DecodeModRM();
+            if (!op.is_register || (opcode == 0x84 && (op.rm > 3 || op.reg_field > 3)))
+                return false;
+            const uint32_t mask = opcode == 0x84 ? 0xFFu : 0xFFFFFFFFu;
+            SetZero(regs[op.rm] & regs[op.reg_field] & mask);
+            return true;
+        }
+        case 0x88:
+        {
+            const Operand op = DecodeModRM();
+            if (op.is_register || op.reg_field > 3)
+                return false;
+            const auto value = static_cast<uint8_t>(regs[op.reg_field]);
+            return memory_.WriteMemory(op.address, &value, 1);
+        }
+        case 0x8A:
+        {
+            const Operand op = DecodeModRM();
+            uint8_t value = 0;
+            if (op.is_register || op.reg_field > 3 || !memory_.ReadMemory(op.address, &value, 1))
+                return false;
+            regs[op.reg_field] = (regs[op.reg_field] & ~0xFFu) | value;
+            return true;
+        }
+        case 0x74:
+            Jump((eflags & kZeroFlag) != 0);
+            return true;
+        case 0x75:
+            Jump((eflags & kZeroFlag) == 0);
+            return true;
+        case 0xC6:
+        {
+            const Operand op = DecodeModRM();
+            const uint8_t imm = Fetch8();
+            return !op.is_register && memory_.WriteMemory(op.address, &imm, 1);
+        }
+        default:
+            return false;
+        }
+    }
+
+    IProcessMemory& memory_;
+    const std::vector<uint8_t>* code_ = nullptr;
+    size_t pc_ = 0;
+};
+
+} // namespace dqxclarity::test
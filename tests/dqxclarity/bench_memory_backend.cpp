@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "dqxclarity/memory/MemoryFactory.hpp"
+
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace dqxclarity;
+
+#ifdef __linux__
+// Hidden by default; run with: dqxu_tests "[benchmark][memory]" --benchmark-samples 20
+// Reads this test process through both backends: small reads model hook polling, large reads model scanning.
+TEST_CASE("libmem vs native Linux backend read throughput", "[.][benchmark][memory]")
+{
+    constexpr size_t kLargeSize = 16u * 1024u * 1024u;
+    std::vector<uint8_t> source(kLargeSize);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = static_cast<uint8_t>(i * 131u);
+    std::vector<uint8_t> target(kLargeSize);
+    const auto base = reinterpret_cast<uintptr_t>(source.data());
+
+    auto libmem = MemoryFactory::CreatePlatformMemory(MemoryBackend::Libmem);
+    auto native = MemoryFactory::CreatePlatformMemory(MemoryBackend::NativeLinux);
+    REQUIRE(libmem->AttachProcess(getpid()));
+    REQUIRE(native->AttachProcess(getpid()));
+
+    REQUIRE(native->ReadMemory(base, target.data(), kLargeSize));
+    REQUIRE(std::memcmp(source.data(), target.data(), kLargeSize) == 0);
+
+    // 1000 flag-sized reads spread over the buffer
+    auto small_reads = [&](IProcessMemory& memory)
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            uint8_t block[33];
+            memory.ReadMemory(base + (i * 4099) % (kLargeSize - sizeof(block)), block, sizeof(block));
+            sum += block[32];
+        }
+        return sum;
+    };
+
+    BENCHMARK("libmem: 1000 x 33-byte reads")
+    {
+        return small_reads(*libmem);
+    };
+    BENCHMARK("native: 1000 x 33-byte reads")
+    {
+        return small_reads(*native);
+    };
+    BENCHMARK("libmem: 16 MB read")
+    {
+        return libmem->ReadMemory(base, target.data(), kLargeSize);
+    };
+    BENCHMARK("native: 16 MB read")
+    {
+        return native->ReadMemory(base, target.data(), kLargeSize);
+    };
+}
+#endif
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "dqxclarity/pattern/PatternSearch.hpp"
+#include "dqxclarity/signatures/StaticSignature.hpp"
+
+#include <random>
+#include <vector>
+
+using dqxclarity::Pattern;
+using dqxclarity::PatternSearch;
+
+// Hidden by default; run with: dqxu_tests "[benchmark]" --benchmark-samples 10
+TEST_CASE("PatternSearch vs naive loop on 256 MB", "[.][benchmark][pattern]")
+{
+    constexpr size_t kBufferSize = 256u * 1024u * 1024u;
+
+    // Mix of random bytes and x86-ish filler so common opcode bytes produce false anchor hits
+    std::vector<uint8_t> buffer(kBufferSize);
+    std::mt19937 rng(1234);
+    const uint8_t filler[] = { 0x8B, 0x89, 0x00, 0xFF, 0xCC, 0x90, 0xE8, 0x55 };
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        uint32_t r = rng();
+        buffer[i] = (r & 1) ? filler[(r >> 1) & 7] : static_cast<uint8_t>(r >> 8);
+    }
+
+    // dialog_trigger and integrity_check from assets/signatures.toml
+    auto dialog = Pattern::FromString("FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8");
+    auto integrity = Pattern::FromString(
+        "89 54 24 FC 8D 64 24 FC 89 4C 24 FC 8D 64 24 FC 8D 64 24 FC 89 04 24 E9 ?? ?? ?? ?? 89");
+
+    // Plant matches near the end so the whole buffer is walked
+    for (const Pattern* pattern : { &dialog, &integrity })
+    {
+        size_t offset = buffer.size() - 4096 - (pattern == &dialog ? 0 : 1024);
+        for (size_t i = 0; i < pattern->Size(); ++i)
+            buffer[offset + i] = pattern->mask[i] ? pattern->bytes[i] : 0x11;
+    }
+
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), dialog) ==
+            PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), dialog));
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), integrity) ==
+            PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), integrity));
+
+    BENCHMARK("naive loop: dialog_trigger")
+    {
+        return PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), dialog);
+    };
+    BENCHMARK("anchor kernel: dialog_trigger")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), dialog);
+    };
+    BENCHMARK("naive loop: integrity_check")
+    {
+        return PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), integrity);
+    };
+    BENCHMARK("anchor kernel: integrity_check")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), integrity);
+    };
+}
+
+// Long literal stretches: Horspool touches a fraction of the bytes, but its shifts form a serial
+// load chain, so the SIMD anchor kernel remains the default on x86
+TEST_CASE("Horspool skip search vs anchor kernel on 256 MB", "[.][benchmark][pattern]")
+{
+    constexpr size_t kBufferSize = 256u * 1024u * 1024u;
+
+    std::vector<uint8_t> buffer(kBufferSize);
+    std::mt19937 rng(99);
+    const uint8_t filler[] = { 0x8B, 0x89, 0x00, 0xFF, 0xCC, 0x90, 0xE8, 0x55 };
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        uint32_t r = rng();
+        buffer[i] = (r & 1) ? filler[(r >> 1) & 7] : static_cast<uint8_t>(r >> 8);
+    }
+
+    // quest_text and corner_text from assets/signatures.toml
+    auto quest = Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F");
+    auto corner = Pattern::FromString("8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F");
+    for (const Pattern* pattern : { &quest, &corner })
+    {
+        size_t offset = buffer.size() - 4096 - (pattern == &quest ? 0 : 1024);
+        for (size_t i = 0; i < pattern->Size(); ++i)
+            buffer[offset + i] = pattern->mask[i] ? pattern->bytes[i] : 0x11;
+    }
+
+    using Strategy = PatternSearch::Strategy;
+    for (const Pattern* pattern : { &quest, &corner })
+    {
+        const size_t expected = PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), *pattern);
+        REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), *pattern->compiled, Strategy::Skip) ==
+                expected);
+        REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), *pattern->compiled, Strategy::Anchor) ==
+                expected);
+    }
+
+    BENCHMARK("anchor kernel: quest_text")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *quest.compiled, Strategy::Anchor);
+    };
+    BENCHMARK("horspool: quest_text")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *quest.compiled, Strategy::Skip);
+    };
+    BENCHMARK("anchor kernel: corner_text")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *corner.compiled, Strategy::Anchor);
+    };
+    BENCHMARK("horspool: corner_text")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *corner.compiled, Strategy::Skip);
+    };
+}
+
+TEST_CASE("Specialized vs generic matcher on built-in signatures", "[.][benchmark][pattern]")
+{
+    using DialogTrigger = dqxclarity::StaticSignature<"FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8">;
+    using IntegrityCheck = dqxclarity::StaticSignature<
+        "89 54 24 FC 8D 64 24 FC 89 4C 24 FC 8D 64 24 FC 8D 64 24 FC 89 04 24 E9 ?? ?? ?? ?? 89">;
+
+    constexpr size_t kBufferSize = 256u * 1024u * 1024u;
+    std::vector<uint8_t> buffer(kBufferSize);
+    std::mt19937 rng(1234);
+    const uint8_t filler[] = { 0x8B, 0x89, 0x00, 0xFF, 0xCC, 0x90, 0xE8, 0x55 };
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        uint32_t r = rng();
+        buffer[i] = (r & 1) ? filler[(r >> 1) & 7] : static_cast<uint8_t>(r >> 8);
+    }
+
+    // Generic engine: what a TOML override gets
+    auto dialog = Pattern::FromString(std::string(DialogTrigger::Source()));
+    auto integrity = Pattern::FromString(std::string(IntegrityCheck::Source()));
+    for (const Pattern* pattern : { &dialog, &integrity })
+    {
+        size_t offset = buffer.size() - 4096 - (pattern == &dialog ? 0 : 1024);
+        for (size_t i = 0; i < pattern->Size(); ++i)
+            buffer[offset + i] = pattern->mask[i] ? pattern->bytes[i] : 0x11;
+    }
+
+    REQUIRE(DialogTrigger::FindFirst(buffer.data(), buffer.size()) ==
+            PatternSearch::FindFirst(buffer.data(), buffer.size(), *dialog.compiled));
+    REQUIRE(IntegrityCheck::FindFirst(buffer.data(), buffer.size()) ==
+            PatternSearch::FindFirst(buffer.data(), buffer.size(), *integrity.compiled));
+
+    BENCHMARK("generic: dialog_trigger")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *dialog.compiled);
+    };
+    BENCHMARK("specialized: dialog_trigger")
+    {
+        return DialogTrigger::FindFirst(buffer.data(), buffer.size());
+    };
+    BENCHMARK("generic: integrity_check")
+    {
+        return PatternSearch::FindFirst(buffer.data(), buffer.size(), *integrity.compiled);
+    };
+    BENCHMARK("specialized: integrity_check")
+    {
+        return IntegrityCheck::FindFirst(buffer.data(), buffer.size());
+    };
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/memory/CachingProcessMemory.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <array>
+#include <cstring>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+struct CacheFixture
+{
+    CacheFixture()
+    {
+        auto fake = std::make_unique<test::FakeProcessMemory>();
+        backend = fake.get();
+        heap = &backend->Map(0x100000, 0x10000, kReadWrite);
+        cache = std::make_unique<CachingProcessMemory>(std::move(fake));
+    }
+
+    uint32_t ReadU32(uintptr_t address)
+    {
+        uint32_t value = 0;
+        REQUIRE(cache->ReadMemory(address, &value, sizeof(value)));
+        return value;
+    }
+
+    test::FakeProcessMemory* backend = nullptr;
+    std::vector<uint8_t>* heap = nullptr;
+    std::unique_ptr<CachingProcessMemory> cache;
+};
+
+} // namespace
+
+TEST_CASE("Page cache serves repeated reads within a tick", "[memory][cache]")
+{
+    CacheFixture f;
+    std::memcpy(f.heap->data() + 0x0FFE, "\x11\x22\x33\x44", 4);
+
+    // Outside a tick everything is forwarded
+    f.ReadU32(0x100FFE);
+    f.ReadU32(0x100FFE);
+    REQUIRE(f.backend->read_calls == 2);
+
+    f.cache->BeginTick();
+    f.backend->read_calls = 0;
+    // Straddles two pages: both are fetched with one batch
+    REQUIRE(f.ReadU32(0x100FFE) == 0x44332211);
+    REQUIRE(f.ReadU32(0x100FFE) == 0x44332211);
+    REQUIRE(f.ReadU32(0x101800) == 0);
+    REQUIRE(f.backend->read_calls == 2);
+
+    // Changes made by the process after the page was fetched show up next tick
+    std::memcpy(f.heap->data() + 0x1900, "npc", 4);
+    std::string text;
+    REQUIRE(f.cache->ReadString(0x101900, text, 16));
+    REQUIRE(text.empty());
+
+    auto stats = f.cache->Stats();
+    REQUIRE(stats.hits == 3);
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.pages_fetched == 2);
+
+    f.cache->EndTick();
+    f.cache->BeginTick();
+    REQUIRE(f.cache->ReadString(0x101900, text, 16));
+    REQUIRE(text == "npc");
+}
+
+TEST_CASE("Page cache is invalidated by writes", "[memory][cache]")
+{
+    CacheFixture f;
+    f.cache->BeginTick();
+    REQUIRE(f.ReadU32(0x100040) == 0);
+
+    const uint32_t value = 0xCAFEBABE;
+    REQUIRE(f.cache->WriteMemory(0x100040, &value, sizeof(value)));
+    REQUIRE(f.ReadU32(0x100040) == value);
+    REQUIRE(f.cache->Stats().misses == 2);
+}
+
+TEST_CASE("Page cache forwards uncacheable reads in the same batch", "[memory][cache]")
+{
+    CacheFixture f;
+    // A mapping smaller than a page cannot be fetched whole
+    auto& tiny = f.backend->Map(0x200000, 0x100, kReadWrite);
+    tiny[0x10] = 0x7F;
+    f.heap->at(0x20) = 0x5A;
+
+    f.cache->BeginTick();
+    std::vector<uint8_t> large(2 * CachingProcessMemory::kMaxCachedReadSize);
+    uint8_t flag = 0;
+    uint8_t small = 0;
+    uint8_t unmapped = 0;
+    std::array<ReadRequest, 4> requests{ { { 0x100000, large.data(), large.size() },
+                                           { 0x100020, &flag, 1 },
+                                           { 0x200010, &small, 1 },
+                                           { 0x300000, &unmapped, 1 } } };
+    requests[1].bypass_cache = true;
+
+    REQUIRE(f.cache->ReadBatch(requests) == 3);
+    REQUIRE(requests[0].ok);
+    REQUIRE(large[0x20] == 0x5A);
+    REQUIRE(requests[1].ok);
+    REQUIRE(flag == 0x5A);
+    REQUIRE(requests[2].ok);
+    REQUIRE(small == 0x7F);
+    REQUIRE_FALSE(requests[3].ok);
+
+    auto stats = f.cache->Stats();
+    REQUIRE(stats.bypassed == 2);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.pages_fetched == 0);
+}
@@ -0,0 +1,280 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/hooking/Codegen.hpp"
+#include "dqxclarity/hooking/HookEventRing.hpp"
+#include "FakeProcessMemory.hpp"
+#include "X86Interpreter.hpp"
+
+#include <cstring>
+#include <string>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+constexpr uintptr_t kArea = 0x10000;
+constexpr uintptr_t kStackTop = 0x80000;
+constexpr uintptr_t kStrings = 0x90000;
+
+struct RingTarget
+{
+    test::FakeProcessMemory memory;
+    test::X86Interpreter cpu{ memory };
+    HookEventRing ring;
+    std::vector<uint8_t> append;
+
+    explicit RingTarget(size_t payload_size = 0, const std::vector<uint8_t>& payload_code = {})
+        : ring(payload_size)
+        , append(ring.GenerateAppendCode(kArea, payload_code))
+    {
+        memory.Map(kArea, 0x40000, kReadWrite);
+        memory.Map(kStackTop - 0x1000, 0x1000, kReadWrite);
+        memory.Map(kStrings, 0x1000, kReadWrite);
+    }
+
+    // What a detour does on a hit: save the registers at area+0..31, then append them
+    bool Hit(uint32_t esi)
+    {
+        cpu.regs = { 0xA0, 0xC0, 0xD0, 0xB0, static_cast<uint32_t>(kStackTop), 0xBB, esi, 0xEE };
+        const uint32_t saved[8] = { cpu.regs[0], cpu.regs[3], cpu.regs[1], cpu.regs[2],
+                                    cpu.regs[6], cpu.regs[7], cpu.regs[5], cpu.regs[4] };
+        memory.WriteMemory(kArea, saved, sizeof(saved));
+        const uint32_t flags = cpu.eflags;
+        return cpu.Run(append) && cpu.eflags == flags && cpu.regs[test::X86Interpreter::ESP] == kStackTop;
+    }
+};
+
+std::string PayloadString(const HookEventRing::Event& event, size_t offset)
+{
+    return std::string(reinterpret_cast<const char*>(event.payload.data() + offset));
+}
+
+uint32_t Esi(const HookEventRing::Event& event)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, event.registers.data() + 16, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("X86CodeBuilder encodes the event ring instructions", "[hooking][codegen]")
+{
+    using Register = X86CodeBuilder::Register;
+    X86CodeBuilder builder;
+    builder.pushfd();
+    builder.movRegToReg(Register::ECX, Register::EAX);
+    builder.andImm32(Register::ECX, 0x3F);
+    builder.imulImm8(Register::ECX, Register::ECX, 0x30);
+    builder.addImm32(Register::ECX, 0x1000);
+    builder.movToRegDisp8(Register::ECX, 0x20, Register::EAX);
+    builder.movFromRegDisp8(Register::EDX, Register::ECX, 0x04);
+    builder.incReg(Register::EAX);
+    builder.popfd();
+
+    const std::vector<uint8_t> expected{ 0x9C,                               // pushfd
+                                         0x89, 0xC1,                         // mov ecx, eax
+                                         0x81, 0xE1, 0x3F, 0x00, 0x00, 0x00, // and ecx, 0x3F
+                                         0x6B, 0xC9, 0x30,                   // imul ecx, ecx, 0x30
+                                         0x81, 0xC1, 0x00, 0x10, 0x00, 0x00, // add ecx, 0x1000
+                                         0x89, 0x41, 0x20,                   // mov [ecx+0x20], eax
+                                         0x8B, 0x51, 0x04,                   // mov edx, [ecx+4]
+                                         0x40,                               // inc eax
+                                         0x9D };                             // popfd
+    REQUIRE(builder.code() == expected);
+}
+
+TEST_CASE("Event ring keeps every hit between two polls", "[hooking][ring]")
+{
+    RingTarget target;
+    HookEventRing& ring = target.ring;
+
+    for (uint32_t i = 1; i <= 5; ++i)
+        REQUIRE(target.Hit(0x5000 + i));
+
+    REQUIRE(ring.Drain(target.memory, kArea) == 5);
+    HookEventRing::Event event;
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        REQUIRE(ring.Pop(event));
+        REQUIRE(event.sequence == i);
+        REQUIRE(Esi(event) == 0x5000 + i);
+    }
+    REQUIRE_FALSE(ring.Pop(event));
+
+    // Drained events are not reported again
+    REQUIRE(ring.Drain(target.memory, kArea) == 0);
+    REQUIRE(target.Hit(0x6000));
+    REQUIRE(ring.Drain(target.memory, kArea) == 1);
+    REQUIRE(ring.Pop(event));
+    REQUIRE(Esi(event) == 0x6000);
+    REQUIRE(ring.Overflows() == 0);
+}
+
+TEST_CASE("Event ring counts events overwritten before a drain", "[hooking][ring]")
+{
+    RingTarget target;
+    HookEventRing& ring = target.ring;
+
+    constexpr uint32_t kHits = HookEventRing::kSlots + 20;
+    for (uint32_t i = 1; i <= kHits; ++i)
+        REQUIRE(target.Hit(i));
+
+    // The oldest surviving slot is held back: the detour could be rewriting it during the read
+    REQUIRE(ring.Drain(target.memory, kArea) == HookEventRing::kSlots - 1);
+    REQUIRE(ring.Overflows() == kHits - (HookEventRing::kSlots - 1));
+    HookEventRing::Event event;
+    REQUIRE(ring.Pop(event));
+    REQUIRE(Esi(event) == kHits - HookEventRing::kSlots + 2);
+
+    SECTION("a slot holding a later event is counted as an overflow")
+    {
+        REQUIRE(target.Hit(0x7001));
+        REQUIRE(target.Hit(0x7002));
+        const uintptr_t slot = kArea + HookEventRing::kSlotsOffset + (kHits % HookEventRing::kSlots) * ring.SlotSize();
+        const uint32_t lapped = kHits + 1 + HookEventRing::kSlots;
+        target.memory.WriteMemory(slot + HookEventRing::kSlotSequenceOffset, &lapped, sizeof(lapped));
+
+        const uint64_t before = ring.Overflows();
+        REQUIRE(ring.Drain(target.memory, kArea) == 1);
+        REQUIRE(ring.Overflows() == before + 1);
+    }
+
+    SECTION("a slot still holding an older event is retried, not dropped")
+    {
+        REQUIRE(target.Hit(0x7001));
+        REQUIRE(target.Hit(0x7002));
+        const uintptr_t slot = kArea + HookEventRing::kSlotsOffset + (kHits % HookEventRing::kSlots) * ring.SlotSize();
+        uint32_t sequence = 0;
+        target.memory.ReadMemory(slot + HookEventRing::kSlotSequenceOffset, &sequence, sizeof(sequence));
+        const uint32_t stale = 1;
+        target.memory.WriteMemory(slot + HookEventRing::kSlotSequenceOffset, &stale, sizeof(stale));
+
+        const uint64_t before = ring.Overflows();
+        REQUIRE(ring.Drain(target.memory, kArea) == 0);
+        target.memory.WriteMemory(slot + HookEventRing::kSlotSequenceOffset, &sequence, sizeof(sequence));
+        REQUIRE(ring.Drain(target.memory, kArea) == 2);
+        REQUIRE(ring.Overflows() == before);
+    }
+}
+
+TEST_CASE("Event ring keeps an event appended while the host read is in flight", "[hooking][ring]")
+{
+    RingTarget target;
+    HookEventRing& ring = target.ring;
+    REQUIRE(target.Hit(0x5001));
+
+    // Slots are copied first; the detour appends the next event before the write sequence is read
+    const ReadRequest request = ring.QueueRead(kArea);
+    const size_t slots_size = request.size - sizeof(uint32_t);
+    REQUIRE(target.memory.ReadMemory(request.address, request.buffer, slots_size));
+    REQUIRE(target.Hit(0x5002));
+    REQUIRE(target.memory.ReadMemory(request.address + slots_size, static_cast<uint8_t*>(request.buffer) + slots_size,
+                                     sizeof(uint32_t)));
+
+    REQUIRE(ring.Consume() == 1);
+    REQUIRE(ring.Drain(target.memory, kArea) == 1);
+    HookEventRing::Event event;
+    REQUIRE(ring.Pop(event));
+    REQUIRE(Esi(event) == 0x5001);
+    REQUIRE(ring.Pop(event));
+    REQUIRE(event.sequence == 2);
+    REQUIRE(Esi(event) == 0x5002);
+    REQUIRE(ring.Overflows() == 0);
+}
+
+TEST_CASE("X86CodeBuilder copies strings with a bounded loop", "[hooking][codegen]")
+{
+    using Register = X86CodeBuilder::Register;
+    test::FakeProcessMemory memory;
+    memory.Map(kStrings, 0x1000, kReadWrite);
+    test::X86Interpreter cpu{ memory };
+
+    X86CodeBuilder builder;
+    builder.copyStringBounded(8);
+    const std::vector<uint8_t> copy = builder.finalize();
+
+    auto run = [&](uint32_t source)
+    {
+        const std::vector<uint8_t> fill(16, 0xCC);
+        memory.WriteMemory(kStrings + 0x100, fill.data(), fill.size());
+        cpu.regs[test::X86Interpreter::ESI] = source;
+        cpu.regs[test::X86Interpreter::EDI] = static_cast<uint32_t>(kStrings + 0x100);
+        REQUIRE(cpu.Run(copy));
+        std::vector<uint8_t> out(16);
+        memory.ReadMemory(kStrings + 0x100, out.data(), out.size());
+        return out;
+    };
+
+    const char text[] = "Hello";
+    memory.WriteMemory(kStrings, text, sizeof(text));
+    auto out = run(static_cast<uint32_t>(kStrings));
+    REQUIRE(std::string(reinterpret_cast<const char*>(out.data())) == "Hello");
+    REQUIRE(out[6] == 0xCC); // Stops after the terminator
+
+    const char long_text[] = "0123456789";
+    memory.WriteMemory(kStrings, long_text, sizeof(long_text));
+    out = run(static_cast<uint32_t>(kStrings));
+    REQUIRE(std::string(reinterpret_cast<const char*>(out.data())) == "0123456");
+    REQUIRE(out[8] == 0xCC);
+
+    out = run(0);
+    REQUIRE(out[0] == 0);
+    REQUIRE(out[1] == 0xCC);
+
+    builder.movImm32(Register::EDX, 0x12345678);
+    builder.imulImm32(Register::ECX, Register::ECX, 0x870);
+    builder.testReg(Register::ESI);
+    builder.testByteReg(Register::EBX);
+    builder.movByteFromPtr(Register::EBX, Register::ESI);
+    builder.movByteToPtr(Register::EDI, Register::EBX);
+    builder.setByteAtPtr(Register::EDI, 0);
+    builder.decReg(Register::EDX);
+    const std::vector<uint8_t> expected{ 0xBA, 0x78, 0x56, 0x34, 0x12, // mov edx, 0x12345678
+                                         0x69, 0xC9, 0x70, 0x08, 0x00, 0x00, // imul ecx, ecx, 0x870
+                                         0x85, 0xF6,                         // test esi, esi
+                                         0x84, 0xDB,                         // test bl, bl
+                                         0x8A, 0x1E,                         // mov bl, [esi]
+                                         0x88, 0x1F,                         // mov [edi], bl
+                                         0xC6, 0x07, 0x00,                   // mov byte ptr [edi], 0
+                                         0x4A };                             // dec edx
+    REQUIRE(builder.code() == expected);
+}
+
+TEST_CASE("Event ring slots carry a payload copied at hook time", "[hooking][ring]")
+{
+    using Register = X86CodeBuilder::Register;
+    constexpr size_t kTextSize = 32;
+
+    // Copy the string at the saved ESI into the payload, as the dialog detour does
+    X86CodeBuilder payload;
+    payload.movRegToReg(Register::EDI, Register::ECX);
+    payload.movFromMem(Register::ESI, static_cast<uint32_t>(kArea + 16));
+    payload.copyStringBounded(kTextSize);
+
+    RingTarget target(kTextSize, payload.finalize());
+    HookEventRing& ring = target.ring;
+    REQUIRE(ring.SlotSize() == 80);
+
+    const char first[] = "first line";
+    const char second[] = "second line";
+    target.memory.WriteMemory(kStrings, first, sizeof(first));
+    REQUIRE(target.Hit(static_cast<uint32_t>(kStrings)));
+    // The game reuses its buffer before the host polls
+    target.memory.WriteMemory(kStrings, second, sizeof(second));
+    REQUIRE(target.Hit(static_cast<uint32_t>(kStrings)));
+    REQUIRE(target.Hit(0));
+
+    REQUIRE(ring.Drain(target.memory, kArea) == 3);
+    HookEventRing::Event event;
+    REQUIRE(ring.Pop(event));
+    REQUIRE(event.payload.size() == kTextSize);
+    REQUIRE(PayloadString(event, 0) == "first line");
+    REQUIRE(ring.Pop(event));
+    REQUIRE(PayloadString(event, 0) == "second line");
+    REQUIRE(Esi(event) == kStrings);
+    REQUIRE(ring.Pop(event));
+    REQUIRE(PayloadString(event, 0).empty());
+    REQUIRE(event.sequence == 3);
+}
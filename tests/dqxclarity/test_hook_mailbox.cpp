@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/hooking/HookMailbox.hpp"
+#include "FakeProcessMemory.hpp"
+#include "X86Interpreter.hpp"
+
+using namespace dqxclarity;
+
+TEST_CASE("Hook mailbox signal code bumps one counter and keeps EFLAGS", "[hooking][mailbox]")
+{
+    test::FakeProcessMemory memory;
+    HookMailbox mailbox;
+    REQUIRE(mailbox.Allocate(memory));
+    REQUIRE(mailbox.CounterAddress(2) == mailbox.Address() + 8);
+    REQUIRE(mailbox.CounterAddress(HookMailbox::kMaxCounters) == 0);
+
+    const auto code = HookMailbox::GenerateSignalCode(mailbox.CounterAddress(2));
+    const uint32_t counter = static_cast<uint32_t>(mailbox.CounterAddress(2));
+    const std::vector<uint8_t> expected{ 0x9C,             // pushfd
+                                         0xF0, 0xFF, 0x05, // lock inc dword ptr [counter]
+                                         static_cast<uint8_t>(counter),
+                                         static_cast<uint8_t>(counter >> 8),
+                                         static_cast<uint8_t>(counter >> 16),
+                                         static_cast<uint8_t>(counter >> 24),
+                                         0x9D };           // popfd
+    REQUIRE(code == expected);
+
+    const uintptr_t stack = memory.AllocateMemory(0x1000, false);
+    test::X86Interpreter cpu{ memory };
+    cpu.regs[test::X86Interpreter::ESP] = static_cast<uint32_t>(stack + 0x1000);
+    const uint32_t flags = cpu.eflags;
+    REQUIRE(cpu.Run(code));
+    REQUIRE(cpu.Run(code));
+    REQUIRE(cpu.eflags == flags);
+
+    uint32_t value = 0;
+    REQUIRE(memory.ReadMemory(counter, &value, sizeof(value)));
+    REQUIRE(value == 2);
+}
+
+TEST_CASE("Hook mailbox reports fired hooks with one read per poll", "[hooking][mailbox]")
+{
+    test::FakeProcessMemory memory;
+    HookMailbox mailbox;
+    REQUIRE(mailbox.Allocate(memory));
+
+    // Idle tick: nothing fired
+    memory.read_calls = 0;
+    REQUIRE(mailbox.Poll());
+    REQUIRE(memory.read_calls == 1);
+    for (size_t slot = 0; slot < HookMailbox::kMaxCounters; ++slot)
+        REQUIRE_FALSE(mailbox.Fired(slot));
+
+    const uint32_t hits = 3;
+    memory.WriteMemory(mailbox.CounterAddress(4), &hits, sizeof(hits));
+    REQUIRE(mailbox.Poll());
+    REQUIRE(mailbox.Fired(4));
+    REQUIRE_FALSE(mailbox.Fired(0));
+
+    // Unacknowledged counters keep reporting (the hook's read failed), acknowledged ones stop
+    REQUIRE(mailbox.Poll());
+    REQUIRE(mailbox.Fired(4));
+    mailbox.Acknowledge(4);
+    REQUIRE_FALSE(mailbox.Fired(4));
+    REQUIRE(mailbox.Poll());
+    REQUIRE_FALSE(mailbox.Fired(4));
+
+    SECTION("an unreadable mailbox reports every hook so they are polled directly")
+    {
+        mailbox.Free();
+        REQUIRE_FALSE(mailbox.IsAllocated());
+        REQUIRE_FALSE(mailbox.Poll());
+        REQUIRE(mailbox.Fired(0));
+        REQUIRE(mailbox.Fired(4));
+    }
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/hooking/InstructionDecoder.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+template <size_t N>
+constexpr size_t Length(const std::array<uint8_t, N>& bytes)
+{
+    return DecodeInstruction(bytes).length;
+}
+
+// Decoded at compile time
+constexpr std::array<uint8_t, 10> kDialogPrologue{ 0xFF, 0x73, 0x08, 0xC7, 0x45, 0xF4, 0x00, 0x00, 0x00, 0x00 };
+static_assert(ComputeStealLength(kDialogPrologue).length == 10);
+static_assert(ComputeStealLength(kDialogPrologue).instructions == 2);
+static_assert(Length(std::array<uint8_t, 1>{ 0x55 }) == 1);                               // push ebp
+static_assert(Length(std::array<uint8_t, 3>{ 0x83, 0xEC, 0x10 }) == 3);                   // sub esp, 0x10
+static_assert(Length(std::array<uint8_t, 3>{ 0x8B, 0x04, 0x24 }) == 3);                   // mov eax, [esp]
+static_assert(Length(std::array<uint8_t, 7>{ 0x8B, 0x04, 0x25, 1, 2, 3, 4 }) == 7);       // mov eax, [disp32] via SIB
+static_assert(Length(std::array<uint8_t, 4>{ 0x66, 0xB8, 0x34, 0x12 }) == 4);             // mov ax, imm16
+static_assert(Length(std::array<uint8_t, 5>{ 0x64, 0xA1, 0x30, 0x00, 0x00 }) == 0);       // truncated moffs32
+static_assert(Length(std::array<uint8_t, 3>{ 0xF6, 0xC1, 0x01 }) == 3);                   // test cl, 1
+static_assert(Length(std::array<uint8_t, 2>{ 0xF7, 0xD8 }) == 2);                         // neg eax (no imm)
+static_assert(Length(std::array<uint8_t, 4>{ 0x0F, 0xB6, 0x46, 0x08 }) == 4);             // movzx eax, byte [esi+8]
+static_assert(Length(std::array<uint8_t, 6>{ 0x0F, 0x84, 0x10, 0x00, 0x00, 0x00 }) == 6); // je rel32
+static_assert(DecodeInstruction(std::array<uint8_t, 2>{ 0x74, 0x05 }).relative);
+
+} // namespace
+
+TEST_CASE("Instruction decoder computes minimal steal lengths", "[hooking][decoder]")
+{
+    // push ebp; mov ebp, esp; sub esp, 0x10 -> 6 bytes, not a blanket 10
+    const std::vector<uint8_t> frame{ 0x55, 0x8B, 0xEC, 0x83, 0xEC, 0x10, 0x53, 0x56 };
+    const StealLength frame_steal = ComputeStealLength(frame);
+    REQUIRE(frame_steal.length == 6);
+    REQUIRE(frame_steal.instructions == 3);
+    REQUIRE_FALSE(frame_steal.has_relative_branch);
+
+    // mov eax, [ebp+8]; call rel32
+    const std::vector<uint8_t> with_call{ 0x8B, 0x45, 0x08, 0xE8, 0x10, 0x20, 0x00, 0x00, 0x90 };
+    const StealLength call_steal = ComputeStealLength(with_call);
+    REQUIRE(call_steal.length == 8);
+    REQUIRE(call_steal.has_relative_branch);
+
+    const DecodedInstruction call = DecodeInstruction(std::span<const uint8_t>(with_call).subspan(3));
+    REQUIRE(call.relative);
+    REQUIRE(call.displacement_offset == 1);
+    REQUIRE(call.displacement_size == 4);
+
+    // An undecodable byte before 5 bytes are covered fails rather than guessing
+    const std::vector<uint8_t> unknown{ 0x90, 0x0F, 0x04, 0x00, 0x00, 0x00 };
+    REQUIRE(ComputeStealLength(unknown).length == 0);
+    REQUIRE(ComputeStealLength(std::vector<uint8_t>{ 0x55, 0x8B }).length == 0);
+}
+
+TEST_CASE("Stolen relative branches are relocated into the detour", "[hooking][decoder]")
+{
+    constexpr uintptr_t kSite = 0x401000;
+    constexpr uintptr_t kDetour = 0x10000000;
+
+    auto rel32_at = [](const std::vector<uint8_t>& code, size_t offset)
+    {
+        int32_t value = 0;
+        std::memcpy(&value, code.data() + offset, sizeof(value));
+        return value;
+    };
+
+    // push ebp; call 0x402000; jz +0x20 (to 0x401028)
+    const std::vector<uint8_t> stolen{ 0x55, 0xE8, 0xFA, 0x0F, 0x00, 0x00, 0x74, 0x20 };
+    std::vector<uint8_t> relocated;
+    REQUIRE(RelocateInstructions(stolen, kSite, kDetour, relocated));
+    REQUIRE(relocated.size() == 1 + 5 + 6);
+    REQUIRE(relocated[0] == 0x55);
+    REQUIRE(relocated[1] == 0xE8);
+    REQUIRE(kDetour + 6 + rel32_at(relocated, 2) == 0x402000);
+    REQUIRE(relocated[6] == 0x0F);
+    REQUIRE(relocated[7] == 0x84);
+    REQUIRE(kDetour + 12 + rel32_at(relocated, 8) == 0x401028);
+
+    // Code without branches is copied unchanged
+    const std::vector<uint8_t> plain{ 0x8B, 0xFF, 0x55, 0x8B, 0xEC };
+    REQUIRE(RelocateInstructions(plain, kSite, kDetour, relocated));
+    REQUIRE(relocated == plain);
+
+    // A branch into the middle of the stolen bytes cannot be relocated
+    const std::vector<uint8_t> inner{ 0x74, 0x01, 0x90, 0x55, 0x8B, 0xEC };
+    REQUIRE_FALSE(RelocateInstructions(inner, kSite, kDetour, relocated));
+
+    // loop has no rel32 form
+    const std::vector<uint8_t> loop{ 0xE2, 0x10, 0x90, 0x90, 0x90 };
+    REQUIRE_FALSE(RelocateInstructions(loop, kSite, kDetour, relocated));
+}
@@ -1,8 +1,144 @@
 #include <catch2/catch_test_macros.hpp>
 #include "dqxclarity/memory/MemoryFactory.hpp"
+#include "dqxclarity/memory/ProcessMemory.hpp"
+#include "dqxclarity/memory/LinuxProcessMemory.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace dqxclarity;
 
 TEST_CASE("Memory Factory can be instantiated", "[memory]")
 {
     // Basic placeholder test
     REQUIRE(true);
 }
+
+TEST_CASE("Default ReadBatch reports success per request", "[memory]")
+{
+    test::FakeProcessMemory memory;
+    auto& region = memory.Map(0x10000, 0x1000, static_cast<int>(MemoryProtection::Read));
+    std::memcpy(region.data() + 0x10, "dialog", 7);
+    region[0x800] = 0x2A;
+
+    char text[7] = {};
+    uint32_t unmapped = 0xFFFFFFFF;
+    uint8_t value = 0;
+    std::array<ReadRequest, 3> requests{ { { 0x10010, text, sizeof(text) },
+                                           { 0x20000, &unmapped, sizeof(unmapped) },
+                                           { 0x10800, &value, sizeof(value) } } };
+
+    REQUIRE(memory.ReadBatch(requests) == 2);
+    REQUIRE(requests[0].ok);
+    REQUIRE(std::strcmp(text, "dialog") == 0);
+    REQUIRE_FALSE(requests[1].ok);
+    REQUIRE(requests[2].ok);
+    REQUIRE(value == 0x2A);
+}
+
+#ifdef __linux__
+TEST_CASE("ProcessMemory ReadBatch reads many ranges and isolates unreadable ones", "[memory]")
+{
+    ProcessMemory memory;
+    REQUIRE(memory.AttachProcess(getpid()));
+
+    // An inaccessible page in the middle of the batch stops process_vm_readv there
+    const long page_size = sysconf(_SC_PAGESIZE);
+    void* guard = mmap(nullptr, page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(guard != MAP_FAILED);
+
+    // More ranges than one vectored read carries
+    constexpr size_t kCount = 150;
+    constexpr size_t kGuardIndex = 70;
+    std::vector<uint32_t> source(kCount);
+    std::vector<uint32_t> target(kCount, 0);
+    std::vector<ReadRequest> requests(kCount);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        source[i] = static_cast<uint32_t>(i * 2654435761u);
+        requests[i] = { reinterpret_cast<uintptr_t>(&source[i]), &target[i], sizeof(uint32_t) };
+    }
+    requests[kGuardIndex].address = reinterpret_cast<uintptr_t>(guard);
+    requests[kGuardIndex + 1].address = 0;
+
+    REQUIRE(memory.ReadBatch(requests) == kCount - 2);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        const bool readable = i != kGuardIndex && i != kGuardIndex + 1;
+        REQUIRE(requests[i].ok == readable);
+        if (readable)
+            REQUIRE(target[i] == source[i]);
+    }
+
+    munmap(guard, page_size);
+}
+
+TEST_CASE("ProcessMemory follows pointer chains through the resolver", "[memory][pointer]")
+{
+    ProcessMemory memory;
+    REQUIRE(memory.AttachProcess(getpid()));
+
+    struct Node
+    {
+        uint64_t padding;
+        void* next;
+    };
+    uint32_t target[4] = {};
+    Node inner{ 0, target };
+    Node outer{ 0, &inner };
+    void* root = &outer;
+
+    const auto base = reinterpret_cast<uintptr_t>(&root);
+    const std::vector<uintptr_t> offsets{ offsetof(Node, next), offsetof(Node, next), 8 };
+    REQUIRE(memory.GetPointerAddress(base, offsets) == reinterpret_cast<uintptr_t>(&target[2]));
+    REQUIRE(memory.GetPointerAddress(base, offsets) == reinterpret_cast<uintptr_t>(&target[2]));
+    REQUIRE(memory.GetPointerAddress(0, offsets) == 0);
+}
+
+TEST_CASE("LinuxProcessMemory reads, batches and patches read-only pages", "[memory]")
+{
+    auto memory = MemoryFactory::CreatePlatformMemory(MemoryBackend::NativeLinux);
+    REQUIRE(dynamic_cast<LinuxProcessMemory*>(memory.get()) != nullptr);
+    REQUIRE(memory->AttachProcess(getpid()));
+    REQUIRE(memory->GetAttachedPid() == getpid());
+
+    const long page_size = sysconf(_SC_PAGESIZE);
+    void* mapping = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(mapping != MAP_FAILED);
+    auto* page = static_cast<char*>(mapping);
+    std::strcpy(page + 100, "native backend");
+    const auto base = reinterpret_cast<uintptr_t>(page);
+
+    std::string text;
+    REQUIRE(memory->ReadString(base + 100, text, 64));
+    REQUIRE(text == "native backend");
+    REQUIRE(memory->ReadInt32(base + 100) == *reinterpret_cast<int32_t*>(page + 100));
+    REQUIRE(memory->ReadInt32(0) == 0);
+
+    char first[7] = {};
+    char second[8] = {};
+    std::array<ReadRequest, 2> requests{ { { base + 100, first, 6 }, { base + 107, second, 7 } } };
+    REQUIRE(memory->ReadBatch(requests) == 2);
+    REQUIRE(std::string(first) == "native");
+    REQUIRE(std::string(second) == "backend");
+
+    // Hook patches target code pages, which are not writable
+    REQUIRE(mprotect(page, page_size, PROT_READ) == 0);
+    const uint8_t jmp = 0xE9;
+    REQUIRE(memory->WriteMemory(base + 100, &jmp, 1));
+    REQUIRE(static_cast<uint8_t>(page[100]) == 0xE9);
+
+    memory->DetachProcess();
+    REQUIRE_FALSE(memory->IsProcessAttached());
+    REQUIRE_FALSE(memory->ReadMemory(base + 100, first, 1));
+    munmap(page, page_size);
+}
+#endif
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/memory/MemoryPatch.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <utility>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadExecute = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Execute);
+constexpr uintptr_t kText = 0x401000;
+
+struct ProtectCall
+{
+    uintptr_t address;
+    size_t size;
+    MemoryProtectionFlags protection;
+};
+
+// Records protection changes and which writes happened inside a ReadWriteExecute window
+class RecordingMemory : public test::FakeProcessMemory
+{
+public:
+    std::vector<ProtectCall> protect_calls;
+    size_t writes_outside_window = 0;
+
+    bool SetMemoryProtection(uintptr_t address, size_t size, MemoryProtectionFlags protection) override
+    {
+        protect_calls.push_back({ address, size, protection });
+        writable_ = protection == MemoryProtectionFlags::ReadWriteExecute ? std::pair{ address, address + size }
+                                                                          : std::pair{ uintptr_t{ 0 }, uintptr_t{ 0 } };
+        return true;
+    }
+
+    bool WriteMemory(uintptr_t address, const void* buffer, size_t size) override
+    {
+        if (address < writable_.first || address + size > writable_.second)
+            ++writes_outside_window;
+        return FakeProcessMemory::WriteMemory(address, buffer, size);
+    }
+
+private:
+    std::pair<uintptr_t, uintptr_t> writable_{};
+};
+
+} // namespace
+
+TEST_CASE("Batched patch flips protection once per run of adjacent pages", "[memory][patch]")
+{
+    RecordingMemory memory;
+    memory.Map(kText, 0x10000, kReadExecute);
+
+    std::vector<PatchSite> sites{
+        { kText + 0x5100, { 0xE9, 1, 2, 3, 4 } },
+        { kText + 0x0010, { 0xE9, 5, 6, 7, 8, 0x90 } },
+        { kText + 0x0FFE, { 0xE9, 9, 10, 11, 12 } }, // Straddles into the second page
+        { kText + 0x1800, { 0xE9, 13, 14, 15, 16 } },
+    };
+    REQUIRE(MemoryPatch::WriteManyWithProtect(memory, sites) == 4);
+    REQUIRE(memory.writes_outside_window == 0);
+
+    // Pages 0-1 form one run; page 5 is separate and pages 2-4 are left alone
+    REQUIRE(memory.protect_calls.size() == 4);
+    REQUIRE(memory.protect_calls[0].address == kText);
+    REQUIRE(memory.protect_calls[0].size == 0x2000);
+    REQUIRE(memory.protect_calls[1].protection == MemoryProtectionFlags::ReadExecute);
+    REQUIRE(memory.protect_calls[2].address == kText + 0x5000);
+    REQUIRE(memory.protect_calls[2].size == 0x1000);
+
+    for (const auto& site : sites)
+    {
+        REQUIRE(site.written);
+        REQUIRE(MemoryPatch::ReadBack(memory, site.address, site.bytes.size()) == site.bytes);
+    }
+}
+
+TEST_CASE("Batched patch reports sites it could not write", "[memory][patch]")
+{
+    RecordingMemory memory;
+    memory.Map(kText, 0x1000, kReadExecute);
+
+    std::vector<PatchSite> sites{
+        { kText + 0x100, { 0xE9, 1, 2, 3, 4 } },
+        { kText + 0xFFE, { 0xE9, 5, 6, 7, 8 } }, // Runs off the mapping
+    };
+    REQUIRE(MemoryPatch::WriteManyWithProtect(memory, sites) == 1);
+    REQUIRE(sites[0].written);
+    REQUIRE_FALSE(sites[1].written);
+    REQUIRE(memory.protect_calls.size() == 2);
+    REQUIRE(memory.protect_calls.back().protection == MemoryProtectionFlags::ReadExecute);
+}
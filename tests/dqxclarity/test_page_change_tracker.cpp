@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/pattern/PageChangeTracker.hpp"
+#include "dqxclarity/scanning/RegionPriority.hpp"
+#include "dqxclarity/scanning/ScannerBase.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace dqxclarity;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+// No such process: RegionMap::Refresh() fails and keeps the layout given to Update()
+constexpr pid_t kNoProcess = 0x3FFFFFF0;
+
+constexpr const char* kMaps = "01000000-01010000 rw-p 00000000 00:00 0 \n"
+                              "02000000-02010000 rw-p 00000000 00:00 0 \n";
+
+class ProbeScanner : public ScannerBase
+{
+public:
+    using ScannerBase::ScannerBase;
+    using ScannerBase::FindPattern;
+
+protected:
+    bool OnInitialize() override { return true; }
+    bool OnPoll() override { return false; }
+};
+
+} // namespace
+
+TEST_CASE("PageChangeTracker hash backend reports changed pages only", "[pattern][pagetracker]")
+{
+    test::FakeProcessMemory memory;
+    auto& low = memory.Map(0x01000000, 0x10000, kReadWrite);
+    auto& high = memory.Map(0x02000000, 0x10000, kReadWrite);
+    auto map = std::make_shared<RegionMap>(kNoProcess);
+    map->Update(kMaps);
+
+    PageChangeTracker tracker(&memory, map, RegionFilter::NonExecutable, PageTrackingBackend::PageHash);
+    REQUIRE(tracker.Backend() == PageTrackingBackend::PageHash);
+
+    const uint64_t first = tracker.Sample();
+    auto everything = tracker.ChangedSince(0);
+    REQUIRE(everything.size() == 2);
+    REQUIRE(everything[0].start == 0x01000000);
+    REQUIRE(everything[0].end == 0x01010000);
+    REQUIRE(tracker.LastChangedPages() == 32);
+
+    const uint64_t second = tracker.Sample();
+    REQUIRE(second > first);
+    REQUIRE(tracker.ChangedSince(first).empty());
+    REQUIRE(tracker.LastChangedPages() == 0);
+
+    high[0x3010] = 0x55;
+    low[0x0ffc] = 0x11;
+    low[0x1000] = 0x22; // Adjacent pages coalesce into one range
+    tracker.Sample();
+    auto changed = tracker.ChangedSince(second);
+    REQUIRE(changed.size() == 2);
+    REQUIRE(changed[0].start == 0x01000000);
+    REQUIRE(changed[0].end == 0x01002000);
+    REQUIRE(changed[1].start == 0x02003000);
+    REQUIRE(changed[1].end == 0x02004000);
+    REQUIRE(changed[1].region_start == 0x02000000);
+    REQUIRE(changed[1].region_end == 0x02010000);
+    REQUIRE(tracker.LastChangedPages() == 3);
+
+    // Sampling within max_age reuses the previous sample
+    REQUIRE(tracker.Sample(1h) == tracker.Generation());
+}
+
+TEST_CASE("Continuous scanners rescan only changed pages on a miss", "[scanner][pagetracker]")
+{
+    test::FakeProcessMemory memory;
+    memory.Map(0x01000000, 0x10000, kReadWrite);
+    auto& high = memory.Map(0x02000000, 0x10000, kReadWrite);
+    auto map = std::make_shared<RegionMap>(kNoProcess);
+    map->Update(kMaps);
+
+    auto pattern = Pattern::FromString("4E 4F 54 49 43 45 ?? 21");
+
+    ScannerCreateInfo info;
+    info.memory = &memory;
+    info.pattern = pattern;
+    info.region_map = map;
+    info.change_tracker =
+        std::make_shared<PageChangeTracker>(&memory, map, RegionFilter::NonExecutable, PageTrackingBackend::PageHash);
+    ProbeScanner scanner(info);
+
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+    REQUIRE(scanner.LastScanBytesBeforeHit() == 0x20000);
+
+    std::this_thread::sleep_for(110ms);
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+    REQUIRE(scanner.LastScanBytesBeforeHit() == 0);
+
+    // First half lands in a page that is then left alone
+    std::copy(pattern.bytes.begin(), pattern.bytes.begin() + 4, high.begin() + 0x3FFC);
+    std::this_thread::sleep_for(110ms);
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+
+    // Second half in the next page: the widened rescan still sees the straddling match
+    std::copy(pattern.bytes.begin() + 4, pattern.bytes.end(), high.begin() + 0x4000);
+    std::this_thread::sleep_for(110ms);
+    REQUIRE(scanner.FindPattern(pattern) == 0x02003FFC);
+    REQUIRE(scanner.LastScanBytesBeforeHit() < 0x2000);
+    REQUIRE(scanner.FindStats().full.hits == 1);
+
+    // Found: later lookups are verify-only
+    REQUIRE(scanner.FindPattern(pattern) == 0x02003FFC);
+    REQUIRE(scanner.FindStats().verify.hits == 1);
+
+    // Gone again: the stale candidate is dropped
+    high[0x4000] = 0;
+    std::this_thread::sleep_for(110ms);
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+    REQUIRE(scanner.FindStats().full.misses == 4);
+}
+
+TEST_CASE("Changed-page scans use the full scan's regions and priority order", "[scanner][pagetracker]")
+{
+    test::FakeProcessMemory memory;
+    auto& low = memory.Map(0x01000000, 0x10000, kReadWrite);
+    auto& high = memory.Map(0x02000000, 0x40000, kReadWrite);
+    auto& extra = memory.Map(0x03000000, 0x10000, kReadWrite);
+    auto map = std::make_shared<RegionMap>(kNoProcess);
+    map->Update("01000000-01010000 rw-p 00000000 00:00 0 \n"
+                "02000000-02040000 rw-p 00000000 00:00 0 \n"
+                "03000000-03010000 rw-p 00000000 00:00 0 \n");
+
+    auto pattern = Pattern::FromString("4E 4F 54 49 43 45 ?? 21");
+    const auto priority_path = std::filesystem::temp_directory_path() / "dqxu_test_changed_priority.bin";
+    auto priority = std::make_shared<RegionPriorityModel>(priority_path);
+    priority->Record(RegionPriorityModel::PatternKey(pattern), MemoryRegion{ 0x05000000, 0x05040000, kReadWrite, "" });
+
+    ScannerCreateInfo info;
+    info.memory = &memory;
+    info.pattern = pattern;
+    info.region_map = map;
+    info.region_priority = priority;
+    // The extra mapping is not one of the regions a full scan would visit
+    info.cached_regions = { { 0x01000000, 0x01010000, kReadWrite, "" }, { 0x02000000, 0x02040000, kReadWrite, "" } };
+    info.change_tracker =
+        std::make_shared<PageChangeTracker>(&memory, map, RegionFilter::NonExecutable, PageTrackingBackend::PageHash);
+    ProbeScanner scanner(info);
+
+    std::copy(pattern.bytes.begin(), pattern.bytes.end(), extra.begin() + 0x100);
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+    REQUIRE(scanner.LastScanBytesBeforeHit() == 0x50000);
+
+    // Both cached regions match: the one resembling the past hit wins over the lower address
+    std::copy(pattern.bytes.begin(), pattern.bytes.end(), low.begin() + 0x200);
+    std::copy(pattern.bytes.begin(), pattern.bytes.end(), high.begin() + 0x300);
+    std::this_thread::sleep_for(110ms);
+    REQUIRE(scanner.FindPattern(pattern) == 0x02000300);
+
+    std::filesystem::remove(priority_path);
+}
+
+#ifndef _WIN32
+TEST_CASE("PageChangeTracker soft-dirty backend sees writes to this process", "[pattern][pagetracker]")
+{
+    if (!PageChangeTracker::SoftDirtySupported())
+    {
+        WARN("Kernel without soft-dirty support; skipped");
+        return;
+    }
+
+    class SelfMemory : public test::FakeProcessMemory
+    {
+    public:
+        pid_t GetAttachedPid() const override { return getpid(); }
+    };
+
+    constexpr size_t kPages = 4;
+    auto* buffer = static_cast<uint8_t*>(::mmap(nullptr, kPages * PageChangeTracker::kPageSize,
+                                                PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    REQUIRE(buffer != MAP_FAILED);
+    std::fill_n(buffer, kPages * PageChangeTracker::kPageSize, uint8_t{ 1 });
+
+    SelfMemory memory;
+    auto map = std::make_shared<RegionMap>(getpid());
+    REQUIRE(map->Refresh());
+    // Soft-dirty is opt-in: clear_refs is never touched unless asked for
+    PageChangeTracker defaulted(&memory, map, RegionFilter::Readable);
+    REQUIRE(defaulted.Backend() == PageTrackingBackend::PageHash);
+
+    PageChangeTracker tracker(&memory, map, RegionFilter::Readable, PageTrackingBackend::SoftDirty);
+    REQUIRE(tracker.Backend() == PageTrackingBackend::SoftDirty);
+
+    const uint64_t before = tracker.Sample();
+    buffer[2 * PageChangeTracker::kPageSize + 7] = 2;
+    tracker.Sample();
+
+    const auto page = [&](size_t index)
+    {
+        return reinterpret_cast<uintptr_t>(buffer) + index * PageChangeTracker::kPageSize;
+    };
+    const auto covered = [&](uintptr_t address)
+    {
+        auto ranges = tracker.ChangedSince(before);
+        return std::any_of(ranges.begin(), ranges.end(),
+                           [&](const ChangedRange& r)
+                           {
+                               return address >= r.start && address < r.end;
+                           });
+    };
+    REQUIRE(covered(page(2)));
+    REQUIRE_FALSE(covered(page(0)));
+    REQUIRE_FALSE(covered(page(3)));
+
+    ::munmap(buffer, kPages * PageChangeTracker::kPageSize);
+}
+#endif
@@ -1,8 +1,459 @@
 #include <catch2/catch_test_macros.hpp>
 #include "dqxclarity/pattern/PatternScanner.hpp"
+#include "dqxclarity/pattern/PatternSearch.hpp"
+#include "dqxclarity/pattern/MultiPatternSearch.hpp"
+#include "dqxclarity/pattern/ParallelRegionScan.hpp"
+#include "dqxclarity/util/BS_thread_pool.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using dqxclarity::MultiPatternSearch;
+using dqxclarity::Pattern;
+using dqxclarity::PatternSearch;
 
 TEST_CASE("Pattern Scanner basic test", "[pattern][scanner]")
 {
     // Basic placeholder test
     REQUIRE(true);
 }
+
+namespace
+{
+
+std::vector<uint8_t> RandomBuffer(size_t size, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> buffer(size);
+    for (auto& b : buffer)
+        b = static_cast<uint8_t>(dist(rng));
+    return buffer;
+}
+
+void Plant(std::vector<uint8_t>& buffer, size_t offset, const Pattern& pattern)
+{
+    for (size_t i = 0; i < pattern.Size(); ++i)
+    {
+        if (pattern.mask[i])
+            buffer[offset + i] = pattern.bytes[i];
+    }
+}
+
+} // namespace
+
+TEST_CASE("PatternSearch anchor prefers rare fixed pairs", "[pattern][search]")
+{
+    auto pattern = Pattern::FromString("FF ?? ?? ?? ?? C7 45 ?? 3A 5B 00 00 ?? 8B");
+    auto anchor = PatternSearch::SelectAnchor(pattern);
+    REQUIRE(anchor.valid);
+    REQUIRE(anchor.pair);
+    REQUIRE(anchor.offset == 8);
+    REQUIRE(anchor.first == 0x3A);
+    REQUIRE(anchor.second == 0x5B);
+
+    auto single = PatternSearch::SelectAnchor(Pattern::FromString("00 ?? 7A ?? FF"));
+    REQUIRE(single.valid);
+    REQUIRE_FALSE(single.pair);
+    REQUIRE(single.offset == 2);
+
+    REQUIRE_FALSE(PatternSearch::SelectAnchor(Pattern::FromString("?? ??")).valid);
+}
+
+TEST_CASE("PatternSearch agrees with the scalar reference", "[pattern][search]")
+{
+    const char* patterns[] = {
+        "FF ?? ?? ?? ?? C7 45 ?? ?? ?? ?? 00",
+        "8B 4D ?? E8 ?? ?? ?? ?? 85 C0 74",
+        "7A",
+        "?? 3C",
+        "01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14",
+        "55 8B EC ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? 5D C3",
+    };
+
+    for (const char* text : patterns)
+    {
+        auto pattern = Pattern::FromString(text);
+        REQUIRE(pattern.IsValid());
+
+        for (size_t size : { size_t{ 0 }, pattern.Size() - 1, pattern.Size(), size_t{ 47 }, size_t{ 4099 } })
+        {
+            auto buffer = RandomBuffer(size, static_cast<uint32_t>(size * 31 + pattern.Size()));
+            if (size >= pattern.Size() * 3)
+            {
+                Plant(buffer, size - pattern.Size(), pattern);
+                Plant(buffer, size / 2, pattern);
+            }
+
+            size_t expected = PatternSearch::FindFirstScalar(buffer.data(), buffer.size(), pattern);
+            REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), pattern) == expected);
+
+            std::vector<size_t> all;
+            PatternSearch::FindAll(buffer.data(), buffer.size(), pattern, all);
+            std::vector<size_t> reference;
+            for (size_t i = 0; i + pattern.Size() <= buffer.size(); ++i)
+            {
+                if (PatternSearch::FindFirstScalar(buffer.data() + i, pattern.Size(), pattern) == 0)
+                    reference.push_back(i);
+            }
+            REQUIRE(all == reference);
+        }
+    }
+}
+
+TEST_CASE("CompiledPattern caps Horspool shifts at the last wildcard", "[pattern][search]")
+{
+    using dqxclarity::CompiledPattern;
+
+    // quest_text: longest fixed run is the 7-byte prefix
+    auto quest = Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F");
+    REQUIRE(quest.compiled);
+    REQUIRE(quest.compiled->fixed_run_offset == 0);
+    REQUIRE(quest.compiled->fixed_run_length == 7);
+    REQUIRE(quest.compiled->skip_offset == 0);
+    REQUIRE(quest.compiled->skip_length == 7);
+    REQUIRE(quest.compiled->shift_table[0x8E] == 5);
+    REQUIRE(quest.compiled->shift_table[0x00] == 1);
+    REQUIRE(quest.compiled->shift_table[0x42] == 7);
+
+    // No wildcards: the whole pattern is the window
+    auto corner = Pattern::FromString("8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F");
+    REQUIRE(corner.compiled->skip_length == corner.Size());
+    REQUIRE(corner.compiled->max_shift == corner.Size());
+    REQUIRE(corner.compiled->PrefersSkipSearch());
+
+    // A wildcard window never shifts past its last wildcard
+    auto wild = Pattern::FromString("11 22 ?? 33 44 55");
+    std::array<uint32_t, 256> table{};
+    const size_t cap = CompiledPattern::BuildShiftTable(wild.compiled->bytes, wild.compiled->mask, 0, wild.Size(), table);
+    REQUIRE(cap == 3);
+    REQUIRE(table[0x99] == 3);
+    REQUIRE(table[0x44] == 1);
+    REQUIRE(table[0x11] == 3);
+
+    // Hand-built patterns have no compiled form and are compiled on demand
+    Pattern manual;
+    manual.bytes = { 0x5A, 0x00, 0x7B };
+    manual.mask = { true, false, true };
+    std::vector<uint8_t> buffer = { 0x00, 0x5A, 0x01, 0x7B };
+    REQUIRE_FALSE(manual.compiled);
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), manual) == 1);
+}
+
+TEST_CASE("PatternSearch strategies agree on low-entropy memory", "[pattern][search]")
+{
+    using Strategy = PatternSearch::Strategy;
+    const char* patterns[] = {
+        "8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F",
+        "8B D0 8D 5A 01 66 90 8A 0A 42 84 C9 75 F9 2B D3 0F",
+        "00 00 00 ?? 00 00 00 00 00 00 00 00 01",
+        "FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8",
+        "01 01 ?? 01",
+    };
+
+    // Few distinct bytes so shift tables hit their short entries and matches overlap
+    std::mt19937 rng(7);
+    std::vector<uint8_t> buffer(16384);
+    const uint8_t alphabet[] = { 0x00, 0x01, 0xFF, 0x8B, 0xD0 };
+    for (auto& b : buffer)
+        b = alphabet[rng() % 5];
+
+    for (const char* text : patterns)
+    {
+        auto pattern = Pattern::FromString(text);
+        Plant(buffer, 1000, pattern);
+        Plant(buffer, buffer.size() - pattern.Size(), pattern);
+
+        std::vector<size_t> reference;
+        for (size_t i = 0; i + pattern.Size() <= buffer.size(); ++i)
+        {
+            if (PatternSearch::FindFirstScalar(buffer.data() + i, pattern.Size(), pattern) == 0)
+                reference.push_back(i);
+        }
+
+        for (Strategy strategy : { Strategy::Auto, Strategy::Anchor, Strategy::Skip })
+        {
+            std::vector<size_t> all;
+            PatternSearch::FindAll(buffer.data(), buffer.size(), *pattern.compiled, all, strategy);
+            REQUIRE(all == reference);
+            REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), *pattern.compiled, strategy) ==
+                    reference.front());
+        }
+    }
+}
+
+TEST_CASE("PatternSearch finds matches at buffer edges", "[pattern][search]")
+{
+    auto pattern = Pattern::FromString("E8 ?? ?? ?? ?? 8B 4D 08");
+    std::vector<uint8_t> buffer(200, 0xCC);
+
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), pattern) == PatternSearch::kNotFound);
+
+    Plant(buffer, buffer.size() - pattern.Size(), pattern);
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), pattern) == buffer.size() - pattern.Size());
+
+    Plant(buffer, 0, pattern);
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), pattern) == 0);
+
+    REQUIRE(PatternSearch::FindFirst(nullptr, 0, pattern) == PatternSearch::kNotFound);
+}
+
+TEST_CASE("MultiPatternSearch agrees with per-pattern FindFirst", "[pattern][search][multi]")
+{
+    // More anchors than groups, shared anchors at different offsets, single-byte and all-wildcard patterns
+    const std::vector<Pattern> table = {
+        Pattern::FromString("FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8"),
+        Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F"),
+        Pattern::FromString("55 8B EC 56 8B F1 57 8B 46 58 85 C0"),
+        Pattern::FromString("?? 3A 5B 01"),
+        Pattern::FromString("3A 5B ?? ?? 02"),
+        Pattern::FromString("7A"),
+        Pattern::FromString("?? 3C"),
+        Pattern::FromString("E8 ?? ?? ?? ?? 8B 4D 08"),
+        Pattern::FromString("01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14"),
+        Pattern::FromString("DE AD BE EF ?? 13 37"),
+        Pattern::FromString("A1 B2"),
+        Pattern::FromString("?? ?? ??"),
+    };
+    std::vector<const Pattern*> patterns;
+    for (const auto& pattern : table)
+        patterns.push_back(&pattern);
+    patterns.push_back(nullptr);
+
+    auto check = [&](const std::vector<uint8_t>& buffer)
+    {
+        std::vector<size_t> found(patterns.size(), PatternSearch::kNotFound);
+        MultiPatternSearch search(patterns);
+        REQUIRE(search.Pending() == table.size());
+
+        const size_t pending = search.FindFirstEach(buffer.data(), buffer.size(),
+                                                    [&](size_t index, size_t offset)
+                                                    {
+                                                        REQUIRE(found[index] == PatternSearch::kNotFound);
+                                                        found[index] = offset;
+                                                    });
+        // The whole table is matched in one pass over the buffer
+        REQUIRE(search.BytesScanned() == buffer.size());
+
+        size_t expected_pending = 0;
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            const size_t expected = PatternSearch::FindFirst(buffer.data(), buffer.size(), table[i]);
+            expected_pending += expected == PatternSearch::kNotFound ? 1 : 0;
+            REQUIRE(found[i] == expected);
+        }
+        REQUIRE(found.back() == PatternSearch::kNotFound);
+        REQUIRE(pending == expected_pending);
+        REQUIRE(search.Pending() == expected_pending);
+    };
+
+    for (size_t size : { size_t{ 1 }, size_t{ 2 }, size_t{ 33 }, size_t{ 100 }, size_t{ 4099 }, size_t{ 65536 } })
+    {
+        auto buffer = RandomBuffer(size, static_cast<uint32_t>(size * 17));
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            const auto& pattern = table[i];
+            if (size < pattern.Size() * 4)
+                continue;
+            // Edges and a late duplicate that must not win
+            if (i % 3 == 0)
+                Plant(buffer, 0, pattern);
+            if (i % 3 == 1)
+                Plant(buffer, size - pattern.Size(), pattern);
+            Plant(buffer, (size / table.size()) * i + i % 7, pattern);
+            Plant(buffer, size - pattern.Size() - i, pattern);
+        }
+        check(buffer);
+    }
+
+    // Low-entropy memory produces a candidate at nearly every position
+    std::vector<uint8_t> dense(8192);
+    std::mt19937 rng(11);
+    const uint8_t alphabet[] = { 0x3A, 0x5B, 0x7A, 0x3C, 0x00, 0xE8 };
+    for (auto& b : dense)
+        b = alphabet[rng() % std::size(alphabet)];
+    Plant(dense, 5000, table[4]);
+    check(dense);
+}
+
+TEST_CASE("MultiPatternSearch keeps first matches across consecutive windows", "[pattern][search][multi]")
+{
+    auto early = Pattern::FromString("3A 5B ?? 01");
+    auto late = Pattern::FromString("?? 3A 5B 02");
+    std::vector<uint8_t> buffer(300, 0xCC);
+    Plant(buffer, 250, late);
+    Plant(buffer, 40, early);
+    Plant(buffer, 120, early);
+
+    MultiPatternSearch search({ &early, &late });
+    std::vector<size_t> found(2, PatternSearch::kNotFound);
+    auto record = [&](size_t base)
+    {
+        return [&found, base](size_t index, size_t offset)
+        {
+            found[index] = base + offset;
+        };
+    };
+    REQUIRE(search.FindFirstEach(buffer.data(), 150, record(0)) == 1);
+    REQUIRE(found[0] == 40);
+
+    // Later windows only look for what is still pending
+    REQUIRE(search.FindFirstEach(buffer.data() + 100, 200, record(100)) == 0);
+    REQUIRE(found[0] == 40);
+    REQUIRE(found[1] == 250);
+    REQUIRE(search.FindFirstEach(buffer.data(), buffer.size(), record(0)) == 0);
+    REQUIRE(search.BytesScanned() == 350);
+}
+
+TEST_CASE("PatternScanner streams regions through a bounded window", "[pattern][scanner]")
+{
+    constexpr size_t kChunk = dqxclarity::ChunkedRegionReader::kDefaultChunkSize;
+    constexpr int kRead = static_cast<int>(dqxclarity::MemoryProtection::Read);
+
+    dqxclarity::test::FakeProcessMemory memory;
+    auto& bytes = memory.Map(0x20000000, 3 * kChunk + 123, kRead);
+    auto region = memory.Regions().front();
+
+    auto pattern = Pattern::FromString("FD ?? A8 99 00 ?? 7F");
+    const size_t offsets[] = { 5, kChunk - 3, 2 * kChunk - 1, 3 * kChunk + 123 - pattern.Size() };
+    for (size_t offset : offsets)
+        Plant(bytes, offset, pattern);
+
+    dqxclarity::PatternScanner scanner(&memory);
+
+    auto all = scanner.ScanRegionAll(region, pattern);
+    REQUIRE(all.size() == std::size(offsets));
+    for (size_t i = 0; i < all.size(); ++i)
+        REQUIRE(all[i] == region.start + offsets[i]);
+
+    // Exact (wildcard-free) patterns go through the same window
+    const uint8_t marker[] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+    std::copy(std::begin(marker), std::end(marker), bytes.begin() + 3 * kChunk - 2);
+    auto exact = Pattern::FromBytes(marker, sizeof(marker));
+    REQUIRE(scanner.ScanRegion(region, exact) == region.start + 3 * kChunk - 2);
+
+    REQUIRE(scanner.ScanRegion(region, pattern) == region.start + offsets[0]);
+
+    // A 3 MB region never needs more than one chunk plus overlap of scratch space
+    REQUIRE(scanner.ScratchBytesAllocated() <= kChunk + pattern.Size());
+    const uint64_t allocated = scanner.ScratchBytesAllocated();
+    scanner.ScanRegionAll(region, pattern);
+    REQUIRE(scanner.ScratchBytesAllocated() == allocated);
+}
+
+TEST_CASE("ParallelRegionScan matches a sequential scan", "[pattern][parallel]")
+{
+    using dqxclarity::ParallelRegionScan;
+    constexpr size_t kUnit = ParallelRegionScan::kUnitSize;
+    constexpr int kReadWrite =
+        static_cast<int>(dqxclarity::MemoryProtection::Read) | static_cast<int>(dqxclarity::MemoryProtection::Write);
+
+    dqxclarity::test::FakeProcessMemory memory;
+    auto& heap = memory.Map(0x30000000, 3 * kUnit + 4096, kReadWrite);
+    auto& small = memory.Map(0x50000000, 64 * 1024, kReadWrite);
+    memory.Map(0x60000000, 2 * kUnit, kReadWrite);
+
+    auto pattern = Pattern::FromString("04 02 ?? ?? 10 00 00 00 80 ?? ?? ?? 00 00 00 00 ??");
+    Plant(heap, 2 * kUnit + 77, pattern);
+    Plant(heap, kUnit - 5, pattern); // straddles the first unit boundary
+    Plant(heap, 3 * kUnit + 4096 - pattern.Size(), pattern);
+    Plant(small, 100, pattern);
+    const auto regions = memory.Regions();
+
+    std::vector<uintptr_t> expected = { 0x30000000 + kUnit - 5, 0x30000000 + 2 * kUnit + 77,
+                                        0x30000000 + 3 * kUnit + 4096 - pattern.Size(), 0x50000000 + 100 };
+
+    BS::light_thread_pool pool(4);
+    for (dqxclarity::ScanThreadPool* p : { static_cast<dqxclarity::ScanThreadPool*>(nullptr), &pool })
+    {
+        REQUIRE(ParallelRegionScan::FindFirst(&memory, p, regions, pattern) == expected.front());
+        REQUIRE(ParallelRegionScan::FindAll(&memory, p, regions, pattern) == expected);
+    }
+
+    REQUIRE_FALSE(ParallelRegionScan::FindFirst(&memory, &pool, regions, Pattern::FromString("DE AD ?? EF"))
+                      .has_value());
+
+    // Calling from inside a task of the same (single-worker) pool must not deadlock
+    BS::light_thread_pool single(1);
+    auto nested = single.submit_task(
+        [&]
+        {
+            return ParallelRegionScan::FindFirst(&memory, &single, regions, pattern);
+        });
+    REQUIRE(nested.get() == expected.front());
+}
+
+TEST_CASE("Streaming scans stop as soon as the consumer is satisfied", "[pattern][scanner]")
+{
+    using dqxclarity::ChunkedRegionReader;
+    using dqxclarity::PatternScanner;
+    using dqxclarity::ScanVisitOptions;
+    constexpr int kReadWrite =
+        static_cast<int>(dqxclarity::MemoryProtection::Read) | static_cast<int>(dqxclarity::MemoryProtection::Write);
+
+    // A match every 64 bytes: 128K hits in 8 MB
+    dqxclarity::test::FakeProcessMemory memory;
+    auto& heap = memory.Map(0x30000000, 8 * 1024 * 1024, kReadWrite);
+    auto pattern = Pattern::FromString("4E 50 43 ?? 00 01");
+    for (size_t offset = 16; offset + pattern.Size() <= heap.size(); offset += 64)
+        Plant(heap, offset, pattern);
+    Plant(heap, ChunkedRegionReader::kDefaultChunkSize - 2, pattern); // straddles the first window edge
+    const auto region = memory.Regions().front();
+
+    PatternScanner scanner(&memory);
+    std::vector<uintptr_t> seen;
+    auto collect = [&](uintptr_t address)
+    {
+        seen.push_back(address);
+        return true;
+    };
+
+    ScanVisitOptions limited;
+    limited.max_matches = 3;
+    auto result = scanner.VisitRegion(region, pattern, collect, limited);
+    REQUIRE(result.matches == 3);
+    REQUIRE(result.stopped);
+    REQUIRE(seen == std::vector<uintptr_t>{ 0x30000010, 0x30000050, 0x30000090 });
+    REQUIRE(memory.read_calls == 1);
+
+    // Visitor predicate ends the scan in the second window
+    seen.clear();
+    memory.read_calls = 0;
+    result = scanner.VisitRegions(memory.Regions(), pattern,
+                                  [&](uintptr_t address)
+                                  {
+                                      seen.push_back(address);
+                                      return address < 0x30000000 + ChunkedRegionReader::kDefaultChunkSize;
+                                  });
+    REQUIRE(result.stopped);
+    REQUIRE(seen[seen.size() - 2] == 0x30000000 + ChunkedRegionReader::kDefaultChunkSize - 2);
+    REQUIRE(seen.back() == 0x30000000 + ChunkedRegionReader::kDefaultChunkSize + 16);
+    REQUIRE(memory.read_calls == 2);
+
+    // Cancellation is honoured before any read
+    std::atomic<bool> cancel{ true };
+    ScanVisitOptions cancelable;
+    cancelable.cancel = &cancel;
+    memory.read_calls = 0;
+    result = scanner.VisitRegions(memory.Regions(), pattern, collect, cancelable);
+    REQUIRE(result.canceled);
+    REQUIRE(result.matches == 0);
+    REQUIRE(memory.read_calls == 0);
+
+    // Full walk agrees with ScanRegionAll and allocates no more than one window
+    size_t count = 0;
+    result = scanner.VisitRegion(region, pattern,
+                                 [&](uintptr_t)
+                                 {
+                                     ++count;
+                                     return true;
+                                 });
+    REQUIRE_FALSE(result.stopped);
+    REQUIRE(count == heap.size() / 64 + 1);
+    REQUIRE(scanner.ScanRegionAll(region, pattern).size() == count);
+    REQUIRE(scanner.ScratchBytesAllocated() <= ChunkedRegionReader::kDefaultChunkSize + pattern.Size());
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/memory/PointerChainResolver.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <array>
+#include <cstring>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+void PutPointer(std::vector<uint8_t>& bytes, size_t offset, uint32_t value)
+{
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+} // namespace
+
+TEST_CASE("Pointer chains dereference before adding each offset", "[memory][pointer]")
+{
+    test::FakeProcessMemory memory;
+    auto& statics = memory.Map(0x10000, 0x1000, kReadWrite);
+    auto& heap = memory.Map(0x20000, 0x40000, kReadWrite);
+    PutPointer(statics, 0x0, 0x20000);
+    PutPointer(heap, 0x10, 0x30000);
+    // Decoys an add-then-dereference walk would follow: *(0x10000 + 0x10) + 0x8
+    PutPointer(statics, 0x10, 0x50000);
+    PutPointer(heap, 0x30008, 0x12345678);
+
+    // *(*0x10000 + 0x10) + 0x8; the final address itself is not read
+    const std::vector<uintptr_t> offsets{ 0x10, 0x8 };
+    PointerChainResolver resolver;
+    REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x30008);
+    REQUIRE(memory.read_calls == 2);
+
+    // Cached path, batched path and the reference IProcessMemory walk agree
+    REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x30008);
+    const std::array<PointerChain, 2> chains{ { { 0x10000, offsets }, { 0x10000, { 0x0 } } } };
+    std::array<uintptr_t, 2> results{};
+    PointerChainResolver batched;
+    batched.ResolveMany(memory, chains, results);
+    REQUIRE(results == std::array<uintptr_t, 2>{ 0x30008, 0x20000 });
+    REQUIRE(memory.GetPointerAddress(0x10000, offsets) == 0x30008);
+    REQUIRE(memory.GetPointerAddress(0x10000, { 0x0 }) == 0x20000);
+}
+
+TEST_CASE("Cached pointer chains are validated with one batched read", "[memory][pointer]")
+{
+    // 0x10000 (static) -> manager at 0x20000; +0x10 -> player at 0x30000; +0x8 -> stats at 0x40000; +0x24
+    test::FakeProcessMemory memory;
+    auto& statics = memory.Map(0x10000, 0x1000, kReadWrite);
+    auto& heap = memory.Map(0x20000, 0x30000, kReadWrite);
+    PutPointer(statics, 0x0, 0x20000);
+    PutPointer(heap, 0x10, 0x30000);
+    PutPointer(heap, 0x10008, 0x40000);
+
+    PointerChainResolver resolver;
+    const std::vector<uintptr_t> offsets{ 0x10, 0x8, 0x24 };
+    REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x40024);
+    REQUIRE(memory.read_calls == 3);
+    REQUIRE(resolver.Stats().walks == 1);
+
+    memory.read_calls = 0;
+    REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x40024);
+    REQUIRE(memory.read_calls == 3);
+    REQUIRE(resolver.Stats().batches == 4); // Three walk levels, then one validation batch
+    REQUIRE(resolver.Stats().cache_hits == 1);
+
+    SECTION("a moved final object is picked up from the final link")
+    {
+        PutPointer(heap, 0x10008, 0x48000);
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x48024);
+        REQUIRE(resolver.Stats().walks == 1);
+    }
+
+    SECTION("a changed root walks the chain again")
+    {
+        PutPointer(statics, 0x0, 0x28000);
+        PutPointer(heap, 0x8010, 0x30000);
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x40024);
+        REQUIRE(resolver.Stats().walks == 2);
+    }
+
+    SECTION("a moved intermediate object walks again even though the root is unchanged")
+    {
+        // The player object is reallocated; its old memory still holds a stale non-null pointer
+        PutPointer(heap, 0x10, 0x34000);
+        PutPointer(heap, 0x14008, 0x44000);
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x44024);
+        REQUIRE(resolver.Stats().walks == 2);
+    }
+
+    SECTION("a nulled final link walks again and reports failure")
+    {
+        PutPointer(heap, 0x10008, 0);
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x24);
+        PutPointer(heap, 0x10008, 0x40000);
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x40024);
+        REQUIRE(resolver.Stats().walks == 3);
+    }
+
+    SECTION("Invalidate forgets cached links")
+    {
+        resolver.Invalidate();
+        memory.read_calls = 0;
+        REQUIRE(resolver.Resolve(memory, 0x10000, offsets) == 0x40024);
+        REQUIRE(memory.read_calls == 3);
+    }
+
+    SECTION("unreadable links resolve to 0")
+    {
+        REQUIRE(resolver.Resolve(memory, 0x90000, offsets) == 0);
+        REQUIRE(resolver.Resolve(memory, 0, offsets) == 0);
+        REQUIRE(resolver.Resolve(memory, 0x10000, {}) == 0x10000);
+    }
+}
+
+TEST_CASE("Chains sharing a prefix are resolved with shared reads", "[memory][pointer]")
+{
+    test::FakeProcessMemory memory;
+    auto& statics = memory.Map(0x10000, 0x1000, kReadWrite);
+    auto& heap = memory.Map(0x20000, 0x30000, kReadWrite);
+    PutPointer(statics, 0x0, 0x20000);
+    PutPointer(heap, 0x10, 0x30000);
+    PutPointer(heap, 0x10004, 0x40000); // player name
+    PutPointer(heap, 0x10008, 0x44000); // player stats
+    PutPointer(heap, 0x20, 0x38000);    // quest log
+
+    const std::array<PointerChain, 3> chains{ { { 0x10000, { 0x10, 0x4, 0x0 } },
+                                                { 0x10000, { 0x10, 0x8, 0x24 } },
+                                                { 0x10000, { 0x20, 0x100 } } } };
+    std::array<uintptr_t, 3> results{};
+
+    PointerChainResolver resolver;
+    resolver.ResolveMany(memory, chains, results);
+    REQUIRE(results == std::array<uintptr_t, 3>{ 0x40000, 0x44024, 0x38100 });
+    // One batch per level: {root}, {player, quest log}, {name, stats}
+    REQUIRE(resolver.Stats().batches == 3);
+    REQUIRE(memory.read_calls == 5);
+
+    memory.read_calls = 0;
+    results = {};
+    resolver.ResolveMany(memory, chains, results);
+    REQUIRE(results == std::array<uintptr_t, 3>{ 0x40000, 0x44024, 0x38100 });
+    REQUIRE(resolver.Stats().batches == 4);
+    REQUIRE(memory.read_calls == 5); // Every distinct link once: root, player, quest log, name, stats
+    REQUIRE(resolver.Stats().cache_hits == 3);
+}
@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/pattern/PatternScanner.hpp"
+#include "dqxclarity/pattern/polling/PatternPollingTask.hpp"
+#include "dqxclarity/pattern/polling/PollingRunner.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <map>
+#include <thread>
+
+using namespace dqxclarity;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+/**
+ * @brief Scanner that counts calls and finds patterns from a fixed table
+ */
+class CountingScanner : public IMemoryScanner
+{
+public:
+    std::map<const Pattern*, uintptr_t> hits;
+    size_t scan_calls = 0;
+    size_t many_calls = 0;
+    size_t many_patterns = 0;
+
+    std::optional<uintptr_t> ScanProcess(const Pattern& pattern, bool) override
+    {
+        ++scan_calls;
+        return Lookup(&pattern);
+    }
+
+    std::vector<uintptr_t> ScanProcessAll(const Pattern&, bool) override { return {}; }
+
+    std::vector<std::optional<uintptr_t>> ScanProcessMany(const std::vector<const Pattern*>& patterns, bool) override
+    {
+        ++many_calls;
+        many_patterns += patterns.size();
+        std::vector<std::optional<uintptr_t>> results;
+        for (const Pattern* pattern : patterns)
+            results.push_back(Lookup(pattern));
+        return results;
+    }
+
+private:
+    std::optional<uintptr_t> Lookup(const Pattern* pattern) const
+    {
+        auto it = hits.find(pattern);
+        if (it == hits.end())
+            return std::nullopt;
+        return it->second;
+    }
+};
+
+/**
+ * @brief CountingScanner whose first pass overruns several poll intervals
+ */
+class SlowFirstPassScanner : public CountingScanner
+{
+public:
+    std::chrono::milliseconds first_pass_delay{ 0 };
+
+    std::vector<std::optional<uintptr_t>> ScanProcessMany(const std::vector<const Pattern*>& patterns,
+                                                          bool executable) override
+    {
+        if (many_calls == 0)
+            std::this_thread::sleep_for(first_pass_delay);
+        return CountingScanner::ScanProcessMany(patterns, executable);
+    }
+};
+
+} // namespace
+
+TEST_CASE("RunAll folds tasks due in the same tick into one pass", "[pattern][polling]")
+{
+    const auto a = Pattern::FromString("11 22 33 44");
+    const auto b = Pattern::FromString("55 66 ?? 88");
+    const auto c = Pattern::FromString("99 AA BB CC");
+
+    CountingScanner scanner;
+    scanner.hits[&a] = 0x1000;
+    scanner.hits[&b] = 0x2000;
+    scanner.hits[&c] = 0x3000;
+
+    std::vector<uintptr_t> found;
+    auto record = [&](uintptr_t address)
+    {
+        found.push_back(address);
+    };
+    PatternPollingTask task_a("a", a, false, 10ms, 1s, TerminationMode::FirstMatch, record);
+    PatternPollingTask task_b("b", b, false, 10ms, 1s, TerminationMode::FirstMatch, record);
+    PatternPollingTask task_c("c", c, false, 10ms, 1s, TerminationMode::FirstMatch, record);
+
+    PollingRunner runner(&scanner);
+    std::atomic<bool> cancel{ false };
+    auto results = runner.RunAll({ &task_a, &task_b, &task_c }, cancel);
+
+    REQUIRE(results.size() == 3);
+    for (const auto& result : results)
+    {
+        REQUIRE(result.status == PollingResult::Status::Matched);
+        REQUIRE(result.ticks == 1);
+    }
+    REQUIRE(found == std::vector<uintptr_t>{ 0x1000, 0x2000, 0x3000 });
+    REQUIRE(scanner.many_calls == 1);
+    REQUIRE(scanner.many_patterns == 3);
+    REQUIRE(scanner.scan_calls == 0);
+}
+
+TEST_CASE("RunAll honours per-task interval, timeout and mode", "[pattern][polling]")
+{
+    const auto present = Pattern::FromString("11 22 33 44");
+    const auto absent = Pattern::FromString("DE AD BE EF");
+
+    CountingScanner scanner;
+    scanner.hits[&present] = 0x1000;
+
+    size_t continuous_hits = 0;
+    PatternPollingTask continuous("continuous", present, false, 20ms, 90ms, TerminationMode::Continuous,
+                                  [&](uintptr_t)
+                                  {
+                                      ++continuous_hits;
+                                  });
+    PatternPollingTask missing("missing", absent, true, 40ms, 90ms, TerminationMode::FirstMatch);
+
+    PollingRunner runner(&scanner);
+    std::atomic<bool> cancel{ false };
+    auto results = runner.RunAll({ &continuous, &missing }, cancel);
+
+    REQUIRE(results[0].status == PollingResult::Status::Timeout);
+    REQUIRE(results[1].status == PollingResult::Status::Timeout);
+    // Ticks at 0,20,40,60,80 ms vs 0,40,80 ms
+    REQUIRE(results[0].ticks == 5);
+    REQUIRE(results[1].ticks == 3);
+    REQUIRE(continuous_hits == 5);
+    // Executable and non-executable scans never share a pass
+    REQUIRE(scanner.many_calls == 8);
+    REQUIRE(scanner.scan_calls == 0);
+}
+
+TEST_CASE("RunAll skips ticks missed during an overrun instead of replaying them", "[pattern][polling]")
+{
+    const auto present = Pattern::FromString("11 22 33 44");
+    SlowFirstPassScanner scanner;
+    scanner.hits[&present] = 0x1000;
+    scanner.first_pass_delay = 60ms;
+
+    std::vector<std::chrono::steady_clock::time_point> hits;
+    PatternPollingTask task("overrun", present, false, 10ms, 120ms, TerminationMode::Continuous,
+                            [&](uintptr_t)
+                            {
+                                hits.push_back(std::chrono::steady_clock::now());
+                            });
+
+    PollingRunner runner(&scanner);
+    std::atomic<bool> cancel{ false };
+    auto results = runner.RunAll({ &task }, cancel);
+
+    REQUIRE(results[0].status == PollingResult::Status::Timeout);
+    // Replaying would fire the five ticks missed during the 60 ms pass back to back
+    REQUIRE(hits.size() >= 2);
+    for (size_t i = 1; i < hits.size(); ++i)
+        REQUIRE(hits[i] - hits[i - 1] >= 5ms);
+    REQUIRE(results[0].ticks <= 8);
+}
+
+TEST_CASE("RunAll stops every task on cancellation", "[pattern][polling]")
+{
+    const auto absent = Pattern::FromString("DE AD BE EF");
+    CountingScanner scanner;
+    PatternPollingTask first("first", absent, true, 5ms, std::nullopt, TerminationMode::FirstMatch);
+    PatternPollingTask second("second", absent, true, 5ms, std::nullopt, TerminationMode::FirstMatch);
+
+    PollingRunner runner(&scanner);
+    std::atomic<bool> cancel{ true };
+    auto results = runner.RunAll({ &first, &second }, cancel);
+    REQUIRE(results[0].status == PollingResult::Status::Canceled);
+    REQUIRE(results[1].status == PollingResult::Status::Canceled);
+
+    PollingRunner unavailable(nullptr);
+    cancel = false;
+    results = unavailable.RunAll({ &first }, cancel);
+    REQUIRE(results[0].status == PollingResult::Status::Error);
+}
+
+TEST_CASE("ScanRegionsMany reads each region once for any number of patterns", "[pattern][scanner]")
+{
+    test::FakeProcessMemory memory;
+    auto& low = memory.Map(0x10000, 256 * 1024, kReadWrite);
+    auto& high = memory.Map(0x80000, 256 * 1024, kReadWrite);
+
+    const auto a = Pattern::FromString("11 22 33 44 55");
+    const auto b = Pattern::FromString("66 ?? 88 99");
+    const auto c = Pattern::FromString("AA BB CC DD EE FF");
+    const auto missing = Pattern::FromString("DE AD BE EF");
+    std::copy(a.bytes.begin(), a.bytes.end(), low.begin() + 0x2000);
+    std::copy(b.bytes.begin(), b.bytes.end(), high.begin() + 0x30000);
+    high[0x30001] = 0x77;
+    std::copy(c.bytes.begin(), c.bytes.end(), high.begin() + 0x3FFFA);
+
+    PatternScanner single(&memory);
+    auto alone = single.ScanRegionsMany(memory.Regions(), { &missing });
+    REQUIRE_FALSE(alone[0]);
+    const size_t reads_for_one = memory.read_calls.exchange(0);
+
+    PatternScanner scanner(&memory);
+    auto results = scanner.ScanRegionsMany(memory.Regions(), { &a, &b, &c, &missing });
+    REQUIRE(results.size() == 4);
+    REQUIRE(results[0] == 0x12000);
+    REQUIRE(results[1] == 0xB0000);
+    REQUIRE(results[2] == 0xBFFFA);
+    REQUIRE_FALSE(results[3]);
+    REQUIRE(memory.read_calls.load() == reads_for_one);
+}
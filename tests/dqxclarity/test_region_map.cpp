@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/pattern/RegionMap.hpp"
+
+#include <string>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using dqxclarity::RegionFilter;
+using dqxclarity::RegionMap;
+
+namespace
+{
+
+// Trimmed from a Wine process: PE sections of DQXGame.exe, an anonymous .bss gap, heap and a shared lib
+constexpr const char* kMaps =
+    "00400000-00401000 r--p 00000000 08:02 1234        /games/dqx/DQXGame.exe\n"
+    "00401000-00a00000 r-xp 00001000 08:02 1234        /games/dqx/DQXGame.exe\n"
+    "00a00000-00b00000 rw-p 00000000 00:00 0 \n"
+    "00b00000-00b10000 r--p 00700000 08:02 1234        /games/dqx/DQXGame.exe\n"
+    "01000000-03000000 rw-p 00000000 00:00 0           [heap]\n"
+    "7f000000-7f100000 r-xp 00000000 08:02 99          /usr/lib/wine/ntdll.so\n"
+    "7f200000-7f300000 rw-p 00000000 00:00 0 \n";
+
+} // namespace
+
+TEST_CASE("RegionMap parses maps and attributes module gaps", "[pattern][regionmap]")
+{
+    RegionMap map(1);
+    map.Update(kMaps);
+
+    REQUIRE(map.Size() == 7);
+    REQUIRE(map.Generation() == 1);
+
+    auto text = map.Find(0x00500000);
+    REQUIRE(text);
+    REQUIRE(text->start == 0x00401000);
+    REQUIRE(text->end == 0x00a00000);
+    REQUIRE(text->IsExecutable());
+    REQUIRE(text->pathname == "/games/dqx/DQXGame.exe");
+
+    // Anonymous mapping inside the module extent belongs to the module
+    auto bss = map.Find(0x00a00010);
+    REQUIRE(bss);
+    REQUIRE(bss->IsWritable());
+    REQUIRE(bss->pathname == "/games/dqx/DQXGame.exe");
+
+    // Anonymous mapping outside any module stays anonymous
+    auto anon = map.Find(0x7f200000);
+    REQUIRE(anon);
+    REQUIRE(anon->pathname.empty());
+
+    REQUIRE(map.Find(0x00b10000) == std::nullopt);
+    REQUIRE(map.Find(0x10) == std::nullopt);
+    REQUIRE(map.Find(0x02ffffff)->pathname == "[heap]");
+
+    auto range = map.ModuleRange("dqxgame.exe");
+    REQUIRE(range);
+    REQUIRE(range->first == 0x00400000);
+    REQUIRE(range->second == 0x00b10000);
+
+    REQUIRE(map.Regions(RegionFilter::Executable).size() == 2);
+    REQUIRE(map.Regions(RegionFilter::NonExecutable).size() == 5);
+    REQUIRE(map.Regions().size() == 7);
+}
+
+TEST_CASE("RegionMap refresh reports only what changed", "[pattern][regionmap]")
+{
+    RegionMap map(1);
+    map.Update(kMaps);
+
+    map.Update(kMaps);
+    REQUIRE(map.LastDiff().Empty());
+    REQUIRE(map.Generation() == 1);
+
+    // Heap grew, one mapping unmapped, one new mapping
+    map.Update("00400000-00401000 r--p 00000000 08:02 1234        /games/dqx/DQXGame.exe\n"
+               "00401000-00a00000 r-xp 00001000 08:02 1234        /games/dqx/DQXGame.exe\n"
+               "00a00000-00b00000 rw-p 00000000 00:00 0 \n"
+               "00b00000-00b10000 r--p 00700000 08:02 1234        /games/dqx/DQXGame.exe\n"
+               "01000000-04000000 rw-p 00000000 00:00 0           [heap]\n"
+               "7f000000-7f100000 r-xp 00000000 08:02 99          /usr/lib/wine/ntdll.so\n"
+               "7f400000-7f500000 rw-p 00000000 00:00 0 \n");
+
+    auto diff = map.LastDiff();
+    REQUIRE(diff.changed == 1);
+    REQUIRE(diff.removed == 1);
+    REQUIRE(diff.added == 1);
+    REQUIRE(map.Generation() == 2);
+    REQUIRE(map.Find(0x03500000));
+    REQUIRE(map.Find(0x7f200000) == std::nullopt);
+}
+
+TEST_CASE("RegionMap drops pathnames of mappings that are gone", "[pattern][regionmap]")
+{
+    RegionMap map(1);
+    for (int i = 0; i < 2000; ++i)
+    {
+        // A transient file mapping with a new name on every refresh
+        map.Update(std::string(kMaps) + "7f400000-7f401000 rw-s 00000000 00:05 7 /dev/shm/wine-" + std::to_string(i) +
+                   "\n");
+    }
+    REQUIRE(map.InternedPaths() <= 256 + 1);
+    REQUIRE(map.Find(0x7f400000)->pathname == "/dev/shm/wine-1999");
+
+    // Ids stay consistent across compactions
+    auto text = map.Find(0x00500000);
+    REQUIRE(text->pathname == "/games/dqx/DQXGame.exe");
+    REQUIRE(map.Find(0x00a00000)->pathname == "/games/dqx/DQXGame.exe");
+    REQUIRE(map.Find(0x7f000000)->pathname == "/usr/lib/wine/ntdll.so");
+    REQUIRE(map.ModuleRange("dqxgame.exe") == std::pair<uintptr_t, uintptr_t>{ 0x00400000, 0x00b10000 });
+    map.Update(kMaps);
+    REQUIRE(map.LastDiff().removed == 1);
+    REQUIRE(map.LastDiff().changed == 0);
+}
+
+TEST_CASE("RegionMap skips malformed lines", "[pattern][regionmap]")
+{
+    RegionMap map(1);
+    map.Update("garbage\n"
+               "00400000-00401000 r--p 00000000 08:02 1234 /path with spaces/a.exe\n"
+               "00500000\n"
+               "\n");
+    REQUIRE(map.Size() == 1);
+    REQUIRE(map.Find(0x00400000)->pathname == "/path with spaces/a.exe");
+}
+
+#ifndef _WIN32
+TEST_CASE("RegionMap reads the live maps of this process", "[pattern][regionmap]")
+{
+    RegionMap map(getpid());
+    REQUIRE(map.Refresh());
+    REQUIRE(map.Size() > 0);
+
+    static const int kProbe = 42;
+    auto region = map.Find(reinterpret_cast<uintptr_t>(&kProbe));
+    REQUIRE(region);
+    REQUIRE(region->IsReadable());
+
+    REQUIRE(map.RefreshIfStale(std::chrono::hours(1)));
+    REQUIRE(map.Generation() == 1);
+}
+#endif
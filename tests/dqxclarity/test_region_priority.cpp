@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/scanning/RegionPriority.hpp"
+#include "dqxclarity/scanning/ScannerBase.hpp"
+#include "dqxclarity/util/BS_thread_pool.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <filesystem>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+constexpr int kReadOnly = static_cast<int>(MemoryProtection::Read);
+
+class ProbeScanner : public ScannerBase
+{
+public:
+    using ScannerBase::ScannerBase;
+    using ScannerBase::ScanAllMemory;
+
+protected:
+    bool OnInitialize() override { return true; }
+    bool OnPoll() override { return false; }
+};
+
+} // namespace
+
+TEST_CASE("RegionPriorityModel orders regions like past hits first", "[scanner][priority]")
+{
+    RegionPriorityModel model(std::filesystem::temp_directory_path() / "dqxu_test_region_priority_order.bin");
+    const uint64_t key = RegionPriorityModel::PatternKey(Pattern::FromString("FD ?? A8 99"));
+
+    std::vector<MemoryRegion> regions = {
+        { 0x01000000, 0x01001000, kReadWrite, "" },
+        { 0x02000000, 0x02800000, kReadOnly, "/games/dqx/data.bin" },
+        { 0x03000000, 0x03800000, kReadWrite, "" },
+        { 0x04000000, 0x04001000, kReadWrite, "" },
+    };
+
+    // Unknown pattern: address order is kept
+    auto unchanged = regions;
+    REQUIRE(model.Order(key, unchanged) == 0);
+    REQUIRE(unchanged[0].start == 0x01000000);
+
+    model.Record(key, MemoryRegion{ 0x13000000, 0x13800000, kReadWrite, "" });
+
+    auto ordered = regions;
+    REQUIRE(model.Order(key, ordered) == 1);
+    REQUIRE(ordered[0].start == 0x03000000);
+    // Ties keep address order behind the likely region
+    REQUIRE(ordered[1].start == 0x01000000);
+    REQUIRE(ordered[2].start == 0x02000000);
+    REQUIRE(ordered[3].start == 0x04000000);
+
+    // Other patterns are unaffected
+    auto other = regions;
+    REQUIRE(model.Order(key + 1, other) == 0);
+}
+
+TEST_CASE("RegionPriorityModel persists across sessions", "[scanner][priority]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "dqxu_test_region_priority_persist.bin";
+    std::filesystem::remove(path);
+
+    const uint64_t key = 0x1234;
+    {
+        RegionPriorityModel model(path);
+        REQUIRE(model.Load());
+        model.Record(key, MemoryRegion{ 0x03000000, 0x03800000, kReadWrite, "" });
+        REQUIRE(model.SaveIfDirty());
+    }
+
+    RegionPriorityModel reloaded(path);
+    REQUIRE(reloaded.Load());
+    std::vector<MemoryRegion> regions = {
+        { 0x01000000, 0x01001000, kReadWrite, "" },
+        { 0x03100000, 0x03900000, kReadWrite, "" },
+    };
+    REQUIRE(reloaded.Order(key, regions) == 1);
+    REQUIRE(regions[0].start == 0x03100000);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Learned ordering cuts bytes scanned before a hit", "[scanner][priority]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "dqxu_test_region_priority_scan.bin";
+    std::filesystem::remove(path);
+
+    // Many small heap regions in front of the large one the pattern lives in
+    test::FakeProcessMemory memory;
+    for (uintptr_t i = 0; i < 32; ++i)
+        memory.Map(0x01000000 + i * 0x100000, 64 * 1024, kReadWrite);
+    auto& target = memory.Map(0x30000000, 2 * 1024 * 1024, kReadWrite);
+
+    auto pattern = Pattern::FromString("FF FF FF 7F FF FF FF 7F 00 00 00 00 00 00 00 00 FD ?? A8 99");
+    for (size_t i = 0; i < pattern.Size(); ++i)
+        target[0x1000 + i] = pattern.mask[i] ? pattern.bytes[i] : 0x42;
+
+    ScannerCreateInfo info;
+    info.memory = &memory;
+    info.pattern = pattern;
+    info.cached_regions = memory.Regions();
+    info.region_priority = std::make_shared<RegionPriorityModel>(path);
+
+    ProbeScanner first(info);
+    REQUIRE(first.ScanAllMemory(pattern) == 0x30001000);
+    const uint64_t cold = first.LastScanBytesBeforeHit();
+    REQUIRE(cold == 32 * 64 * 1024 + 0x1000);
+
+    // Hits only update the model in memory; the Engine saves it when the session stops
+    REQUIRE_FALSE(std::filesystem::exists(path));
+    REQUIRE(info.region_priority->SaveIfDirty());
+
+    // Next session: same layout, fresh scanner, model loaded from disk
+    info.region_priority = std::make_shared<RegionPriorityModel>(path);
+    REQUIRE(info.region_priority->Load());
+    ProbeScanner second(info);
+    REQUIRE(second.ScanAllMemory(pattern) == 0x30001000);
+    REQUIRE(second.LastScanBytesBeforeHit() == 0x1000);
+
+    // The parallel path scans the likely tier on its own first
+    BS::light_thread_pool pool(4);
+    info.scan_pool = &pool;
+    ProbeScanner parallel(info);
+    REQUIRE(parallel.ScanAllMemory(pattern) == 0x30001000);
+    REQUIRE(parallel.LastScanBytesBeforeHit() == 0x1000);
+
+    std::filesystem::remove(path);
+}
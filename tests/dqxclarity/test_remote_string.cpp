@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/memory/RemoteString.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <array>
+#include <cstring>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+void Put(std::vector<uint8_t>& bytes, size_t offset, const std::string& text)
+{
+    std::memcpy(bytes.data() + offset, text.c_str(), text.size() + 1);
+}
+
+} // namespace
+
+TEST_CASE("FindNul locates the terminator at any position", "[memory][string]")
+{
+    std::vector<char> data(100, 'x');
+    REQUIRE(FindNul(data.data(), data.size()) == data.size());
+    for (size_t position : { size_t{ 0 }, size_t{ 15 }, size_t{ 16 }, size_t{ 31 }, size_t{ 64 }, size_t{ 99 } })
+    {
+        std::vector<char> copy = data;
+        copy[position] = '\0';
+        copy.back() = '\0';
+        REQUIRE(FindNul(copy.data(), copy.size()) == position);
+    }
+}
+
+TEST_CASE("Remote strings are read in growing chunks", "[memory][string]")
+{
+    test::FakeProcessMemory memory;
+    auto& heap = memory.Map(0x100000, 0x4000, kReadWrite);
+
+    SECTION("a short line costs one small chunk")
+    {
+        Put(heap, 0x100, "Hello there, traveller.");
+        std::string text;
+        REQUIRE(ReadRemoteString(memory, 0x100100, text, 4096));
+        REQUIRE(text == "Hello there, traveller.");
+        REQUIRE(memory.read_calls == 1);
+        REQUIRE(memory.bytes_read == kRemoteStringInitialChunk);
+    }
+
+    SECTION("a long line grows until the terminator")
+    {
+        const std::string line(1000, 'a');
+        Put(heap, 0x200, line);
+        std::string text;
+        REQUIRE(ReadRemoteString(memory, 0x100200, text, 4096));
+        REQUIRE(text == line);
+        REQUIRE(memory.read_calls == 3); // 256 + 512 + 1024
+        REQUIRE(memory.bytes_read < 2 * line.size());
+    }
+
+    SECTION("max_length cuts the string")
+    {
+        Put(heap, 0x0, std::string(600, 'b'));
+        std::string text;
+        REQUIRE(ReadRemoteString(memory, 0x100000, text, 300));
+        REQUIRE(text == std::string(300, 'b'));
+        REQUIRE(memory.bytes_read == 300);
+    }
+
+    SECTION("a string ending just before an unmapped page is read")
+    {
+        Put(heap, 0x3FC0, "edge of the heap");
+        std::string text;
+        REQUIRE(ReadRemoteString(memory, 0x103FC0, text, 4096));
+        REQUIRE(text == "edge of the heap");
+    }
+
+    SECTION("unreadable strings fail and clear the output")
+    {
+        std::string text = "stale";
+        REQUIRE_FALSE(ReadRemoteString(memory, 0x200000, text, 64));
+        REQUIRE(text.empty());
+        REQUIRE_FALSE(ReadRemoteString(memory, 0, text, 64));
+    }
+}
+
+TEST_CASE("Several strings share one batch per round", "[memory][string]")
+{
+    test::FakeProcessMemory memory;
+    auto& heap = memory.Map(0x100000, 0x4000, kReadWrite);
+    Put(heap, 0x10, "quest");
+    Put(heap, 0x1000, std::string(400, 'q'));
+    heap[0x2000] = 0x2A;
+
+    std::string short_text;
+    std::string long_text;
+    std::string missing = "stale";
+    std::array<RemoteStringRead, 3> reads{ { { 0x100010, 2048, &short_text },
+                                             { 0x101000, 2048, &long_text },
+                                             { 0x300000, 2048, &missing } } };
+    uint8_t rider = 0;
+    ReadRequest rider_request{ 0x102000, &rider, 1 };
+
+    REQUIRE(ReadRemoteStrings(memory, reads, { &rider_request, 1 }) == 2);
+    REQUIRE(reads[0].ok);
+    REQUIRE(short_text == "quest");
+    REQUIRE(reads[1].ok);
+    REQUIRE(long_text == std::string(400, 'q'));
+    REQUIRE_FALSE(reads[2].ok);
+    REQUIRE(missing.empty());
+    REQUIRE(rider_request.ok);
+    REQUIRE(rider == 0x2A);
+}
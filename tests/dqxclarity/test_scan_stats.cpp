@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/pattern/PatternScanner.hpp"
+#include "dqxclarity/pattern/ScanStats.hpp"
+#include "dqxclarity/scanning/ScannerBase.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <algorithm>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+class PollingProbe : public ScannerBase
+{
+public:
+    using ScannerBase::ScannerBase;
+
+protected:
+    bool OnInitialize() override { return FindPattern(pattern_) != 0; }
+
+    bool OnPoll() override { return FindPattern(pattern_) != 0; }
+};
+
+void Place(std::vector<uint8_t>& bytes, size_t offset, const Pattern& pattern)
+{
+    std::copy(pattern.bytes.begin(), pattern.bytes.end(), bytes.begin() + offset);
+}
+
+} // namespace
+
+TEST_CASE("PatternScanner accounts reads, ranges and matches", "[pattern][scanstats]")
+{
+    test::FakeProcessMemory memory;
+    auto& low = memory.Map(0x01000000, 3 * 1024 * 1024, kReadWrite);
+    auto& high = memory.Map(0x02000000, 64 * 1024, kReadWrite);
+    auto pattern = Pattern::FromString("4E 4F 54 49 43 45 ?? 21");
+    Place(low, 0x10, pattern);
+    Place(low, 0x200000, pattern);
+    Place(high, 0x100, pattern);
+
+    PatternScanner scanner(&memory);
+    auto all = scanner.VisitRegions(memory.Regions(), pattern,
+                                    [](uintptr_t)
+                                    {
+                                        return true;
+                                    });
+    REQUIRE(all.matches == 3);
+
+    const ScanCost& cost = scanner.Cost();
+    REQUIRE(cost.scans == 1); // Nested VisitRegion calls count once
+    REQUIRE(cost.regions_visited == 2);
+    REQUIRE(cost.read_calls == memory.read_calls);
+    REQUIRE(cost.bytes_read == memory.bytes_read);
+    REQUIRE(cost.matches == 3);
+
+    scanner.ResetCost();
+    memory.read_calls = 0;
+    REQUIRE(scanner.ScanRegion(memory.Regions()[1], pattern) == 0x02000100);
+    REQUIRE(scanner.Cost().scans == 1);
+    REQUIRE(scanner.Cost().read_calls == 1);
+    REQUIRE(scanner.Cost().bytes_read == 64 * 1024);
+    REQUIRE(scanner.Cost().matches == 1);
+}
+
+TEST_CASE("Scanners report startup and per-tick costs to the registry", "[scanner][scanstats]")
+{
+    test::FakeProcessMemory memory;
+    memory.Map(0x01000000, 1024 * 1024, kReadWrite);
+    auto& heap = memory.Map(0x02000000, 1024 * 1024, kReadWrite);
+    auto pattern = Pattern::FromString("FF FF FF 7F FF FF FF 7F 00 00 00 00 00 00 00 00 FD ?? A8 99");
+    Place(heap, 0x8000, pattern);
+
+    auto registry = std::make_shared<ScanStatsRegistry>();
+    ScannerCreateInfo info;
+    info.memory = &memory;
+    info.pattern = pattern;
+    info.cached_regions = memory.Regions();
+    info.signature_name = "dialog_pattern";
+    info.scan_stats = registry;
+    PollingProbe scanner(info);
+
+    REQUIRE(scanner.Initialize());
+    REQUIRE(scanner.StartupCost().scans == 1);
+    REQUIRE(scanner.StartupCost().bytes_read == 2 * 1024 * 1024);
+    REQUIRE(scanner.StartupCost().matches == 1);
+
+    // Steady state is the cached-address verify: one pattern-sized read per tick
+    for (int i = 0; i < 3; ++i)
+        REQUIRE(scanner.Poll());
+    REQUIRE(scanner.LastTickCost().read_calls == 1);
+    REQUIRE(scanner.LastTickCost().bytes_read == pattern.Size());
+
+    ScanCost other;
+    other.scans = 6;
+    other.wall_time = std::chrono::hours(1);
+    registry->RecordStartup("hook_signatures", other);
+
+    auto reports = registry->Snapshot();
+    REQUIRE(reports.size() == 2);
+    REQUIRE(reports[0].signature == "hook_signatures"); // Most expensive first
+    const auto& dialog = reports[1];
+    REQUIRE(dialog.signature == "dialog_pattern");
+    REQUIRE(dialog.startup.bytes_read == 2 * 1024 * 1024);
+    REQUIRE(dialog.ticks == 3);
+    REQUIRE(dialog.steady.scans == 3);
+    REQUIRE(dialog.steady.bytes_read == 3 * pattern.Size());
+    REQUIRE(dialog.last_tick.read_calls == 1);
+    REQUIRE(scanner.TotalCost().scans == 4);
+
+    const std::string table = FormatScanReport(reports);
+    REQUIRE(table.find("dialog_pattern") != std::string::npos);
+    REQUIRE(std::count(table.begin(), table.end(), '\n') == 3);
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/scanning/ScannerBase.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <algorithm>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kReadWrite = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Write);
+
+class ProbeScanner : public ScannerBase
+{
+public:
+    using ScannerBase::ScannerBase;
+    using ScannerBase::FindPattern;
+
+protected:
+    bool OnInitialize() override { return true; }
+    bool OnPoll() override { return false; }
+};
+
+void Place(std::vector<uint8_t>& bytes, size_t offset, const Pattern& pattern)
+{
+    for (size_t i = 0; i < pattern.Size(); ++i)
+        bytes[offset + i] = pattern.mask[i] ? pattern.bytes[i] : 0x42;
+}
+
+void Clear(std::vector<uint8_t>& bytes, size_t offset, const Pattern& pattern)
+{
+    std::fill_n(bytes.begin() + offset, pattern.Size(), 0);
+}
+
+} // namespace
+
+TEST_CASE("FindPattern verifies the cached address before scanning", "[scanner][findpattern]")
+{
+    test::FakeProcessMemory memory;
+    memory.Map(0x01000000, 4 * 1024 * 1024, kReadWrite);
+    auto& heap = memory.Map(0x10000000, 8 * 1024 * 1024, kReadWrite);
+
+    auto pattern = Pattern::FromString("FF FF FF 7F FF FF FF 7F 00 00 00 00 00 00 00 00 FD ?? A8 99");
+    Place(heap, 0x400000, pattern);
+
+    ScannerCreateInfo info;
+    info.memory = &memory;
+    info.pattern = pattern;
+    info.cached_regions = memory.Regions();
+    ProbeScanner scanner(info);
+
+    REQUIRE(scanner.FindPattern(pattern) == 0x10400000);
+    REQUIRE(scanner.FindStats().full.hits == 1);
+
+    // Steady state: one read of pattern.Size() bytes per lookup
+    memory.bytes_read = 0;
+    memory.read_calls = 0;
+    for (int i = 0; i < 10; ++i)
+        REQUIRE(scanner.FindPattern(pattern) == 0x10400000);
+    REQUIRE(memory.read_calls == 10);
+    REQUIRE(memory.bytes_read == 10 * pattern.Size());
+    REQUIRE(scanner.FindStats().verify.hits == 10);
+
+    // Small move: found in the neighbourhood window
+    Clear(heap, 0x400000, pattern);
+    Place(heap, 0x400800, pattern);
+    memory.bytes_read = 0;
+    REQUIRE(scanner.FindPattern(pattern) == 0x10400800);
+    REQUIRE(scanner.FindStats().verify.misses == 1);
+    REQUIRE(scanner.FindStats().window.hits == 1);
+    REQUIRE(memory.bytes_read < 16 * 1024);
+
+    // Larger move inside the region: the region tier picks it up
+    Clear(heap, 0x400800, pattern);
+    Place(heap, 0x100000, pattern);
+    REQUIRE(scanner.FindPattern(pattern) == 0x10100000);
+    REQUIRE(scanner.FindStats().window.misses == 1);
+    REQUIRE(scanner.FindStats().region.hits == 1);
+
+    // Gone from the region: falls through to the full scan
+    Clear(heap, 0x100000, pattern);
+    REQUIRE(scanner.FindPattern(pattern) == 0);
+    REQUIRE(scanner.FindStats().region.misses == 1);
+    REQUIRE(scanner.FindStats().full.misses == 1);
+}
@@ -0,0 +1,193 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/pattern/SignatureResolver.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+void Plant(std::vector<uint8_t>& bytes, size_t offset, const Pattern& pattern)
+{
+    for (size_t i = 0; i < pattern.Size(); ++i)
+        bytes[offset + i] = pattern.mask[i] ? pattern.bytes[i] : 0x5A;
+}
+
+constexpr int kReadExec = static_cast<int>(MemoryProtection::Read) | static_cast<int>(MemoryProtection::Execute);
+
+} // namespace
+
+TEST_CASE("SignatureResolver resolves all signatures with one read per region", "[pattern][resolver]")
+{
+    test::FakeProcessMemory memory;
+    auto& text = memory.Map(0x401000, 256 * 1024, kReadExec, "C:\\Game\\DQXGame.exe");
+    auto& rdata = memory.Map(0x500000, 8 * 1024, static_cast<int>(MemoryProtection::Read), "C:\\Game\\DQXGame.exe");
+    auto& other = memory.Map(0x10000000, 4096, kReadExec, "C:\\windows\\system32\\ntdll.dll");
+
+    auto dialog = Pattern::FromString("FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8");
+    auto quest = Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F");
+    auto player = Pattern::FromString("55 8B EC 56 8B F1 57 8B 46 58 85 C0");
+    auto missing = Pattern::FromString("DE AD BE EF ?? 13 37");
+    auto foreign = Pattern::FromString("0F 0B 0F 0B 12 34");
+
+    Plant(text, 0x100, dialog);
+    Plant(text, 64 * 1024 - 4, quest); // straddles the first block boundary
+    Plant(text, 200 * 1024, quest);    // later duplicate must not win
+    Plant(rdata, 0x20, player);
+    Plant(other, 0x10, foreign);
+
+    SignatureResolver resolver(&memory);
+    auto resolved = resolver.Resolve(
+        { { "dialog_trigger", dialog }, { "quest_text", quest }, { "player_name_trigger", player },
+          { "missing", missing }, { "foreign", foreign } },
+        "dqxgame.exe", memory.Regions());
+
+    REQUIRE(resolved.Size() == 3);
+    REQUIRE(resolved.Find("dialog_trigger") == 0x401000 + 0x100);
+    REQUIRE(resolved.Find("quest_text") == 0x401000 + 64 * 1024 - 4);
+    REQUIRE(resolved.Find("player_name_trigger") == 0x500000 + 0x20);
+    REQUIRE_FALSE(resolved.Find("missing").has_value());
+    REQUIRE_FALSE(resolved.Find("foreign").has_value());
+
+    REQUIRE(resolved.Lookup(quest) == resolved.Find("quest_text"));
+    REQUIRE_FALSE(resolved.Lookup(missing).has_value());
+
+    // One read per module region, none for foreign modules
+    REQUIRE(memory.read_calls == 2);
+}
+
+TEST_CASE("SignatureResolver searches each block once for the whole table", "[pattern][resolver]")
+{
+    test::FakeProcessMemory memory;
+    auto& text = memory.Map(0x401000, 3 * 1024 * 1024 / 2, kReadExec, "C:\\Game\\DQXGame.exe");
+
+    std::vector<SignatureResolver::NamedPattern> signatures;
+    for (int i = 0; i < 10; ++i)
+    {
+        char text_pattern[64];
+        std::snprintf(text_pattern, sizeof(text_pattern), "C7 45 ?? %02X %02X ?? 8B 4D 08", 0x10 + i, 0xA0 + i);
+        signatures.push_back({ "signature_" + std::to_string(i), Pattern::FromString(text_pattern) });
+    }
+    signatures.push_back({ "missing", Pattern::FromString("DE AD BE EF ?? 13 37") });
+    // Spread the hits over the image, the last one past the first read window
+    for (size_t i = 0; i < 10; ++i)
+        Plant(text, 0x1000 + i * 0x24000, signatures[i].second);
+
+    SignatureResolver resolver(&memory);
+    auto resolved = resolver.Resolve(signatures, "dqxgame.exe", memory.Regions());
+    REQUIRE(resolved.Size() == 10);
+    for (size_t i = 0; i < 10; ++i)
+        REQUIRE(resolved.Find(signatures[i].first) == 0x401000 + 0x1000 + i * 0x24000);
+
+    // "missing" keeps the scan going to the end: every byte read is searched once, not once per signature
+    const auto& cost = resolver.LastCost();
+    REQUIRE(cost.scans == signatures.size());
+    REQUIRE(cost.bytes_read >= text.size());
+    REQUIRE(cost.bytes_read < text.size() + 64); // Window overlap only
+    REQUIRE(cost.bytes_searched == cost.bytes_read);
+}
+
+#include "dqxclarity/signatures/SignatureCache.hpp"
+
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+
+// Minimal PE header: "MZ", e_lfanew = 0x80, "PE\0\0", TimeDateStamp at +8
+void WritePeHeader(std::vector<uint8_t>& image, uint32_t timestamp)
+{
+    image[0] = 'M';
+    image[1] = 'Z';
+    const uint32_t nt_offset = 0x80;
+    std::memcpy(&image[0x3C], &nt_offset, sizeof(nt_offset));
+    std::memcpy(&image[nt_offset], "PE\0\0", 4);
+    std::memcpy(&image[nt_offset + 8], &timestamp, sizeof(timestamp));
+}
+
+} // namespace
+
+TEST_CASE("SignatureResolver validates cached offsets before scanning", "[pattern][resolver][cache]")
+{
+    const auto cache_path = std::filesystem::temp_directory_path() / "dqxu_test_signature_cache.bin";
+    std::filesystem::remove(cache_path);
+
+    test::FakeProcessMemory memory;
+    auto& image = memory.Map(0x400000, 512 * 1024, kReadExec, "/games/dqx/DQXGame.exe");
+    WritePeHeader(image, 0x65000000);
+
+    auto dialog = Pattern::FromString("FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8");
+    auto quest = Pattern::FromString("8D 8E 78 04 00 00 E8 ?? ?? ?? ?? 5F");
+    Plant(image, 0x3000, dialog);
+    Plant(image, 0x41000, quest);
+    const std::vector<SignatureResolver::NamedPattern> signatures = { { "dialog_trigger", dialog },
+                                                                      { "quest_text", quest } };
+
+    SignatureResolver resolver(&memory);
+    uintptr_t base = 0;
+    {
+        SignatureCache cold(cache_path);
+        REQUIRE(cold.Load());
+        auto resolved = resolver.Resolve(signatures, "DQXGame.exe", memory.Regions(), cold);
+        REQUIRE(resolver.LastCacheHits() == 0);
+        REQUIRE(resolved.Find("quest_text") == 0x400000 + 0x41000);
+        REQUIRE(std::filesystem::exists(cache_path));
+    }
+
+    SECTION("Warm start reads only the header and pattern bytes")
+    {
+        SignatureCache warm(cache_path);
+        REQUIRE(warm.Load());
+        REQUIRE(warm.Size() == 2);
+
+        memory.bytes_read = 0;
+        auto resolved = resolver.Resolve(signatures, "DQXGame.exe", memory.Regions(), warm);
+        REQUIRE(resolver.LastCacheHits() == 2);
+        REQUIRE(resolved.Find("dialog_trigger") == 0x400000 + 0x3000);
+        REQUIRE(memory.bytes_read == 4096 + dialog.Size() + quest.Size());
+    }
+
+    SECTION("Moved code is rescanned and the cache updated")
+    {
+        std::fill(image.begin() + 0x41000, image.begin() + 0x41000 + quest.Size(), 0);
+        Plant(image, 0x52000, quest);
+
+        SignatureCache warm(cache_path);
+        REQUIRE(warm.Load());
+        auto resolved = resolver.Resolve(signatures, "DQXGame.exe", memory.Regions(), warm);
+        REQUIRE(resolver.LastCacheHits() == 1);
+        REQUIRE(resolved.Find("quest_text") == 0x400000 + 0x52000);
+
+        // Resolve persisted the new offset, so the cache is clean and a reload sees it
+        REQUIRE_FALSE(warm.IsDirty());
+        SignatureCache reloaded(cache_path);
+        REQUIRE(reloaded.Load());
+        auto identity = SignatureCache::IdentifyModule(memory, "DQXGame.exe", memory.Regions(), base);
+        REQUIRE(identity);
+        REQUIRE(reloaded.Get(*identity, "quest_text") == 0x52000u);
+    }
+
+    SECTION("A bogus e_lfanew is rejected instead of wrapping")
+    {
+        const uint32_t nt_offset = 0xFFFFFFF0;
+        std::memcpy(&image[0x3C], &nt_offset, sizeof(nt_offset));
+        REQUIRE_FALSE(SignatureCache::IdentifyModule(memory, "DQXGame.exe", memory.Regions(), base));
+    }
+
+    SECTION("A patched binary invalidates every entry")
+    {
+        WritePeHeader(image, 0x66000000);
+
+        SignatureCache warm(cache_path);
+        REQUIRE(warm.Load());
+        auto resolved = resolver.Resolve(signatures, "DQXGame.exe", memory.Regions(), warm);
+        REQUIRE(resolver.LastCacheHits() == 0);
+        REQUIRE(resolved.Size() == 2);
+    }
+
+    std::filesystem::remove(cache_path);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/memory/SnapshotProcessMemory.hpp"
+#include "dqxclarity/pattern/PatternScanner.hpp"
+#include "dqxclarity/pattern/RegionMap.hpp"
+#include "FakeProcessMemory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+constexpr int kRead = static_cast<int>(MemoryProtection::Read);
+constexpr int kReadExec = kRead | static_cast<int>(MemoryProtection::Execute);
+constexpr int kReadWrite = kRead | static_cast<int>(MemoryProtection::Write);
+
+struct TempFile
+{
+    std::filesystem::path path;
+
+    explicit TempFile(const char* name)
+        : path(std::filesystem::temp_directory_path() / name)
+    {
+    }
+
+    ~TempFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Snapshots replay captured memory and maps", "[memory][snapshot]")
+{
+    test::FakeProcessMemory source;
+    auto& code = source.Map(0x400000, 0x3000, kReadExec, "C:\\Games\\DQX\\DQXGame.exe");
+    auto& heap = source.Map(0x403000, 0x8000, kReadWrite);
+    source.Map(0x500000, 0x1000, 0);
+    const uint8_t signature[] = { 0xFF, 0x75, 0x08, 0x8B, 0x4D, 0xFC, 0xE8 };
+    std::memcpy(code.data() + 0x1234, signature, sizeof(signature));
+    std::memcpy(heap.data() + 0x10, "Hello, adventurer!", 19);
+    std::memcpy(heap.data() + 0x7000, "\x20\x30\x40\x00", 4); // pointer to 0x403020
+    code[0x2FFF] = 0x5A;
+
+    TempFile file("dqxclarity_test_snapshot.bin");
+    SnapshotCaptureStats stats;
+    REQUIRE(CaptureMemorySnapshot(source, source.Regions(), file.path.string(), &stats));
+    REQUIRE(stats.regions == 3);
+    REQUIRE(stats.stored_pages == 4);
+    REQUIRE(stats.zero_pages == 7);
+    REQUIRE(stats.unreadable_pages == 1);
+    REQUIRE(stats.file_bytes == std::filesystem::file_size(file.path));
+
+    SnapshotProcessMemory replay;
+    REQUIRE(replay.Open(file.path.string()));
+    REQUIRE(replay.IsProcessAttached());
+    REQUIRE(replay.GetSourcePid() == 1);
+
+    SECTION("reads return captured bytes, zero pages and fail on unreadable pages")
+    {
+        std::string text;
+        REQUIRE(replay.ReadString(0x403010, text, 256));
+        REQUIRE(text == "Hello, adventurer!");
+
+        uint8_t zeros[64];
+        std::memset(zeros, 0xCC, sizeof(zeros));
+        REQUIRE(replay.ReadMemory(0x405000, zeros, sizeof(zeros)));
+        REQUIRE(std::all_of(std::begin(zeros), std::end(zeros), [](uint8_t b) { return b == 0; }));
+
+        // Adjacent regions read as one range, like a live process
+        uint8_t across[2] = {};
+        REQUIRE(replay.ReadMemory(0x402FFF, across, sizeof(across)));
+        REQUIRE(across[0] == 0x5A);
+        REQUIRE(across[1] == 0);
+
+        uint32_t value = 0;
+        REQUIRE_FALSE(replay.ReadMemory(0x500000, &value, sizeof(value)));
+        REQUIRE_FALSE(replay.ReadMemory(0x600000, &value, sizeof(value)));
+        REQUIRE(replay.GetPointerAddress(0x40A000, { 0x10 }) == 0x403030);
+    }
+
+    SECTION("writes land in an overlay and never touch the file")
+    {
+        REQUIRE(replay.WriteString(0x405100, "patched"));
+        std::string text;
+        REQUIRE(replay.ReadString(0x405100, text, 64));
+        REQUIRE(text == "patched");
+        REQUIRE_FALSE(replay.WriteMemory(0x500000, "x", 1));
+
+        SnapshotProcessMemory fresh;
+        REQUIRE(fresh.Open(file.path.string()));
+        REQUIRE(fresh.ReadString(0x405100, text, 64));
+        REQUIRE(text.empty());
+    }
+
+    SECTION("region queries and scanners see the stored maps")
+    {
+        const pid_t pid = replay.GetAttachedPid();
+        REQUIRE(MemoryRegionParser::ParseMaps(pid).size() == 3);
+        REQUIRE(MemoryRegionParser::ParseMapsFiltered(pid, true, true).size() == 1);
+        REQUIRE(replay.GetModuleBaseAddress() == 0x400000);
+        REQUIRE(replay.GetModuleBaseAddress("dqxgame.exe") == 0x400000);
+
+        RegionMap map(pid);
+        REQUIRE(map.Refresh());
+        REQUIRE(map.Size() == 3);
+
+        PatternScanner scanner(&replay);
+        auto found = scanner.ScanProcess(Pattern::FromString("FF 75 08 8B 4D ?? E8"));
+        REQUIRE(found);
+        REQUIRE(*found == 0x401234);
+    }
+
+    SECTION("closing unregisters the maps")
+    {
+        const pid_t pid = replay.GetAttachedPid();
+        replay.Close();
+        std::vector<MemoryRegion> regions;
+        REQUIRE_FALSE(MemoryRegionParser::FindRegisteredMaps(pid, regions));
+        REQUIRE_FALSE(replay.IsProcessAttached());
+    }
+}
+
+TEST_CASE("Snapshot files are validated on open", "[memory][snapshot]")
+{
+    TempFile file("dqxclarity_test_snapshot_bad.bin");
+    SnapshotProcessMemory replay;
+    REQUIRE_FALSE(replay.Open(file.path.string()));
+
+    {
+        std::ofstream out(file.path, std::ios::binary);
+        out << std::string(4096, 'x');
+    }
+    REQUIRE_FALSE(replay.Open(file.path.string()));
+    REQUIRE_FALSE(replay.IsOpen());
+    REQUIRE(replay.ReadInt32(0x400000) == 0);
+}
+
+TEST_CASE("A failed capture leaves no partial snapshot behind", "[memory][snapshot]")
+{
+    test::FakeProcessMemory source;
+    source.Map(0x400000, 0x2000, kReadExec)[0] = 0x90;
+
+    // The final rename cannot replace a non-empty directory
+    TempFile target("dqxclarity_test_snapshot_dir");
+    std::filesystem::create_directories(target.path / "keep");
+    REQUIRE_FALSE(CaptureMemorySnapshot(source, source.Regions(), target.path.string()));
+    REQUIRE_FALSE(std::filesystem::exists(target.path.string() + ".tmp"));
+    REQUIRE(std::filesystem::is_directory(target.path / "keep"));
+
+    std::error_code ec;
+    std::filesystem::remove_all(target.path, ec);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dqxclarity/signatures/Signatures.hpp"
+#include "dqxclarity/signatures/StaticSignature.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace dqxclarity;
+
+namespace
+{
+
+using DialogTrigger = StaticSignature<"FF ?? ?? C7 45 ?? 00 00 00 00 C7 45 ?? FD FF FF FF E8">;
+using ShortWildcard = StaticSignature<"8D . 78 ?? 5F">;
+
+static_assert(DialogTrigger::kSize == 18);
+static_assert(DialogTrigger::kMask[1] == 0 && DialogTrigger::kMask[3] == 0xFF);
+static_assert(DialogTrigger::kBytes[13] == 0xFD);
+static_assert(ShortWildcard::kSize == 5 && ShortWildcard::kMask[1] == 0 && ShortWildcard::kMask[3] == 0);
+
+std::vector<uint8_t> RandomBuffer(size_t size, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> buffer(size);
+    for (auto& b : buffer)
+        b = static_cast<uint8_t>(dist(rng));
+    return buffer;
+}
+
+template <typename Signature>
+void Plant(std::vector<uint8_t>& buffer, size_t offset)
+{
+    for (size_t i = 0; i < Signature::kSize; ++i)
+    {
+        if (Signature::kMask[i])
+            buffer[offset + i] = Signature::kBytes[i];
+    }
+}
+
+template <typename Signature>
+void RequireAgreesWithGeneric()
+{
+    const Pattern pattern = Pattern::FromString(std::string(Signature::Source()));
+    const auto generic = CompiledPattern::FromPattern(pattern);
+
+    const PatternAnchor anchor = SelectPatternAnchor(generic.bytes, generic.mask, generic.Size());
+    REQUIRE(anchor.offset == Signature::kAnchor.offset);
+    REQUIRE(anchor.pair == Signature::kAnchor.pair);
+
+    for (uint32_t seed = 1; seed <= 8; ++seed)
+    {
+        // Lengths around the 16/32-byte vector widths exercise the scalar tail
+        for (size_t size : { Signature::kSize - 1, Signature::kSize, size_t{ 47 }, size_t{ 100 }, size_t{ 4099 } })
+        {
+            auto buffer = RandomBuffer(size, seed);
+            if (size >= Signature::kSize)
+            {
+                // Every third seed plants at the very end of the buffer
+                const size_t last = size - Signature::kSize;
+                Plant<Signature>(buffer, seed % 3 == 0 ? last : (seed * 7919) % (last + 1));
+            }
+            const size_t expected =
+                PatternSearch::FindFirst(buffer.data(), buffer.size(), generic, PatternSearch::Strategy::Anchor);
+            REQUIRE(Signature::FindFirst(buffer.data(), buffer.size()) == expected);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("StaticSignature matches like the generic engine", "[pattern][signature]")
+{
+    RequireAgreesWithGeneric<DialogTrigger>();
+    RequireAgreesWithGeneric<ShortWildcard>();
+    RequireAgreesWithGeneric<StaticSignature<"89 54 24 FC 8D 64 24 FC 89 4C 24 FC 8D 64 24 FC 8D 64 24 FC 89 04 24 "
+                                             "E9 ?? ?? ?? ?? 89">>();
+
+    REQUIRE(DialogTrigger::FindFirst(nullptr, 64) == PatternSearch::kNotFound);
+}
+
+TEST_CASE("Built-in signatures carry their specialized matcher", "[pattern][signature]")
+{
+    const Pattern pattern = DialogTrigger::ToPattern();
+    REQUIRE(pattern.IsValid());
+    REQUIRE(pattern.compiled);
+    REQUIRE(pattern.compiled->specialized_find_first == &DialogTrigger::FindFirst);
+
+    auto buffer = RandomBuffer(4096, 42);
+    Plant<DialogTrigger>(buffer, 1000);
+    REQUIRE(PatternSearch::FindFirst(buffer.data(), buffer.size(), pattern) <= 1000);
+
+    const Pattern& builtin = Signatures::GetDialogTrigger();
+    REQUIRE(builtin.bytes == pattern.bytes);
+    REQUIRE(builtin.mask == pattern.mask);
+}